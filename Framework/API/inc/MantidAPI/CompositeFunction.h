@@ -16,6 +16,7 @@
 
 namespace Mantid {
 namespace API {
+class FunctionDomain1D;
 /** A composite function is a function containing other functions. It combines
    values
     calculated by the member function using an operation. The default operation
@@ -211,6 +212,12 @@ protected:
   size_t paramOffset(size_t i) const { return m_paramOffsets[i]; }
 
 private:
+  /// Calculate the function with the peaks limited to their peak radius
+  void functionInPeakWindows(const FunctionDomain1D &domain,
+                             FunctionValues &values) const;
+  /// Calculate the derivatives with the peaks limited to their peak radius
+  void functionDerivInPeakWindows(const FunctionDomain1D &domain,
+                                  Jacobian &jacobian);
   /// Extract function index and parameter name from a variable name
   static void parseName(const std::string &varName, size_t &index,
                         std::string &name);
@@ -40,6 +40,9 @@ public:
   virtual CoordTransform *clone() const = 0;
   virtual std::string id() const = 0;
 
+  virtual void applyBatch(const coord_t *inputVectors, coord_t *outVectors,
+                          const size_t numPoints) const;
+
   /// Wrapper for VMD
   Mantid::Kernel::VMD applyVMD(const Mantid::Kernel::VMD &inputVector) const;
 
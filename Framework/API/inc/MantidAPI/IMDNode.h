@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidAPI/DllConfig.h"
 #include "MantidGeometry/MDGeometry/MDTypes.h"
 #include "MantidKernel/VMD.h"
 #include <algorithm>
@@ -312,6 +313,9 @@ public:
   static void sortObjByID(std::vector<IMDNode *> &boxes) {
     std::sort(boxes.begin(), boxes.end(), CompareFilePosition);
   }
+
+  static MANTID_API_DLL void
+  prefetchObjData(const std::vector<IMDNode *> &boxes);
 };
 } // namespace API
 } // namespace Mantid
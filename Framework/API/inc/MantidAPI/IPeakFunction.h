@@ -51,6 +51,10 @@ public:
   virtual std::pair<double, double>
   getDomainInterval(double level = DEFAULT_SEARCH_LEVEL) const;
 
+  /// Get the interval of x outside of which the peak is zero when it is
+  /// calculated on a domain with a peak radius
+  virtual std::pair<double, double> getPeakRadiusInterval(int peakRadius) const;
+
   /// Function evaluation method to be implemented in the inherited classes
   virtual void functionLocal(double *out, const double *xValues,
                              const size_t nData) const = 0;
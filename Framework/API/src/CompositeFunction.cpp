@@ -8,8 +8,10 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAPI/CompositeFunction.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/IConstraint.h"
+#include "MantidAPI/IPeakFunction.h"
 #include "MantidAPI/ParameterTie.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
@@ -27,6 +29,71 @@ namespace API {
 namespace {
 /// static logger
 Kernel::Logger g_log("CompositeFunction");
+
+/// A PartialJacobian of a Jacobian zeroed by a composite function before it
+/// set the derivatives of its peaks near their centres only
+class ZeroedPartialJacobian : public PartialJacobian {
+public:
+  using PartialJacobian::PartialJacobian;
+};
+
+/**
+ * Get the domain as a FunctionDomain1D if the peaks of a composite function
+ * can be calculated on the points near their centres only, i.e. if it has a
+ * peak radius and its points are sorted.
+ * @param domain :: A domain
+ * @return The 1D domain, or nullptr if the peaks must be calculated on all
+ * of it
+ */
+const FunctionDomain1D *getPeakWindowDomain(const FunctionDomain &domain) {
+  const auto *d1d = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!d1d || d1d->getPeakRadius() <= 0 || d1d->size() == 0 ||
+      dynamic_cast<const FunctionDomain1DHistogram *>(d1d)) {
+    return nullptr;
+  }
+  const double *x = d1d->getPointerAt(0);
+  if (!std::is_sorted(x, x + d1d->size())) {
+    return nullptr;
+  }
+  return d1d;
+}
+
+/**
+ * Find the points of a sorted domain inside the peak radius interval of a
+ * peak.
+ * @param peak :: A peak function
+ * @param domain :: A sorted domain
+ * @return The index of the first point and the number of points
+ */
+std::pair<size_t, size_t> getPeakWindow(const IPeakFunction &peak,
+                                        const FunctionDomain1D &domain) {
+  const auto interval = peak.getPeakRadiusInterval(domain.getPeakRadius());
+  const double *begin = domain.getPointerAt(0);
+  const double *end = begin + domain.size();
+  const double *first = std::upper_bound(begin, end, interval.first);
+  const double *last = std::lower_bound(first, end, interval.second);
+  return std::make_pair(static_cast<size_t>(first - begin),
+                        static_cast<size_t>(last - first));
+}
+
+/**
+ * Zero a Jacobian so that a composite function only needs to set the
+ * derivatives of its peaks near their centres. A PartialJacobian passed by
+ * another function cannot be zeroed, unless it is part of a Jacobian that has
+ * already been zeroed by a composite function.
+ * @param jacobian :: A Jacobian
+ * @return true if the Jacobian is zero
+ */
+bool zeroJacobian(Jacobian &jacobian) {
+  if (dynamic_cast<ZeroedPartialJacobian *>(&jacobian)) {
+    return true;
+  }
+  if (dynamic_cast<PartialJacobian *>(&jacobian)) {
+    return false;
+  }
+  jacobian.zero();
+  return true;
+}
 } // namespace
 
 using std::size_t;
@@ -152,6 +219,10 @@ void CompositeFunction::setMatrixWorkspace(
  */
 void CompositeFunction::function(const FunctionDomain &domain,
                                  FunctionValues &values) const {
+  if (const auto *d1d = getPeakWindowDomain(domain)) {
+    functionInPeakWindows(*d1d, values);
+    return;
+  }
   FunctionValues tmp(domain);
   values.zeroCalculated();
   for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
@@ -160,6 +231,42 @@ void CompositeFunction::function(const FunctionDomain &domain,
   }
 }
 
+/**
+ * Calculate the function on a sorted domain with a peak radius. The member
+ * peaks are only calculated on the points inside their peak radius
+ * intervals, where they are not zero.
+ * @param domain :: A sorted 1D domain with a peak radius.
+ * @param values :: A FunctionValues instance for storing the calculated
+ * values.
+ */
+void CompositeFunction::functionInPeakWindows(const FunctionDomain1D &domain,
+                                              FunctionValues &values) const {
+  std::unique_ptr<FunctionValues> tmp;
+  values.zeroCalculated();
+  for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+    const auto *peak =
+        dynamic_cast<const IPeakFunction *>(m_functions[iFun].get());
+    if (!peak) {
+      if (!tmp) {
+        tmp = std::make_unique<FunctionValues>(domain);
+      }
+      m_functions[iFun]->function(domain, *tmp);
+      values += *tmp;
+      continue;
+    }
+    const auto window = getPeakWindow(*peak, domain);
+    if (window.second == 0) {
+      continue;
+    }
+    FunctionDomain1DView windowDomain(domain.getPointerAt(window.first),
+                                      window.second);
+    windowDomain.setPeakRadius(domain.getPeakRadius());
+    FunctionValues windowValues(windowDomain);
+    peak->function(windowDomain, windowValues);
+    values.addToCalculated(window.first, windowValues);
+  }
+}
+
 /**
  * Derivatives of function with respect to active parameters
  * @param domain :: Function domain to get the arguments from.
@@ -169,6 +276,9 @@ void CompositeFunction::functionDeriv(const FunctionDomain &domain,
                                       Jacobian &jacobian) {
   if (getAttribute("NumDeriv").asBool()) {
     calNumericalDeriv(domain, jacobian);
+  } else if (const auto *d1d = getPeakWindowDomain(domain);
+             d1d && zeroJacobian(jacobian)) {
+    functionDerivInPeakWindows(*d1d, jacobian);
   } else {
     for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
       PartialJacobian J(&jacobian, paramOffset(iFun));
@@ -177,6 +287,34 @@ void CompositeFunction::functionDeriv(const FunctionDomain &domain,
   }
 }
 
+/**
+ * Derivatives of the function on a sorted domain with a peak radius. The
+ * derivatives of the member peaks are only calculated on the points inside
+ * their peak radius intervals, the others are left at zero.
+ * @param domain :: A sorted 1D domain with a peak radius.
+ * @param jacobian :: A Jacobian to store the derivatives. It must be zero.
+ */
+void CompositeFunction::functionDerivInPeakWindows(
+    const FunctionDomain1D &domain, Jacobian &jacobian) {
+  for (size_t iFun = 0; iFun < nFunctions(); ++iFun) {
+    auto peak = std::dynamic_pointer_cast<IPeakFunction>(m_functions[iFun]);
+    if (!peak) {
+      ZeroedPartialJacobian J(&jacobian, paramOffset(iFun));
+      m_functions[iFun]->functionDeriv(domain, J);
+      continue;
+    }
+    const auto window = getPeakWindow(*peak, domain);
+    if (window.second == 0) {
+      continue;
+    }
+    FunctionDomain1DView windowDomain(domain.getPointerAt(window.first),
+                                      window.second);
+    windowDomain.setPeakRadius(domain.getPeakRadius());
+    ZeroedPartialJacobian J(&jacobian, window.first, paramOffset(iFun));
+    peak->functionDeriv(windowDomain, J);
+  }
+}
+
 /** Sets a new value to the i-th parameter.
  *  @param i :: The parameter index
  *  @param value :: The new value
@@ -12,6 +12,7 @@
 #include "MantidKernel/VMD.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
+#include <vector>
 
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -39,6 +40,33 @@ CoordTransform::CoordTransform(const size_t inD, const size_t outD)
         "CoordTransform: invalid number of input dimensions!");
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to a batch of points.
+ *
+ * The coordinates are stored one dimension after the other (structure of
+ * arrays): coordinate d of point i is at inputVectors[d * numPoints + i], and
+ * likewise for the output. Subclasses override this to transform a whole
+ * dimension at a time in a loop the compiler can vectorize; this default
+ * calls apply() for each point.
+ *
+ * @param inputVectors :: inD * numPoints input coordinates
+ * @param outVectors :: outD * numPoints output coordinates
+ * @param numPoints :: number of points to transform
+ */
+void CoordTransform::applyBatch(const coord_t *inputVectors,
+                                coord_t *outVectors,
+                                const size_t numPoints) const {
+  std::vector<coord_t> in(inD);
+  std::vector<coord_t> out(outD);
+  for (size_t i = 0; i < numPoints; ++i) {
+    for (size_t d = 0; d < inD; ++d)
+      in[d] = inputVectors[d * numPoints + i];
+    this->apply(in.data(), out.data());
+    for (size_t d = 0; d < outD; ++d)
+      outVectors[d * numPoints + i] = out[d];
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Apply the transformation to an input vector (as a VMD type).
  * This wraps the apply(in,out) method (and will be slower!)
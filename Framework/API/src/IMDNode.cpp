@@ -0,0 +1,41 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/IMDNode.h"
+#include "MantidAPI/BoxController.h"
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidKernel/ISaveable.h"
+
+namespace Mantid {
+namespace API {
+
+//-----------------------------------------------------------------------------------------------
+/** Hint that the data of a list of boxes is about to be accessed in the
+ * given order. For a file-backed workspace, the boxes whose data is on disk
+ * are loaded ahead on the background thread of the disk buffer; otherwise
+ * this does nothing.
+ *
+ * @param boxes :: boxes of one workspace, in the order they will be accessed
+ */
+void IMDNode::prefetchObjData(const std::vector<IMDNode *> &boxes) {
+  if (boxes.empty())
+    return;
+  BoxController *bc = boxes.front()->getBoxController();
+  if (!bc || !bc->isFileBacked())
+    return;
+
+  std::vector<Kernel::ISaveable *> items;
+  items.reserve(boxes.size());
+  for (auto box : boxes) {
+    Kernel::ISaveable *saveable = box->getISaveable();
+    if (saveable && saveable->wasSaved() && !saveable->isLoaded())
+      items.emplace_back(saveable);
+  }
+  bc->getFileIO()->prefetch(items);
+}
+
+} // namespace API
+} // namespace Mantid
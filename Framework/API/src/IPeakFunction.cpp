@@ -178,6 +178,26 @@ void IPeakFunction::setPeakRadius(int r) const {
   }
 }
 
+/**
+ * Get the interval of x outside of which function1D and functionDeriv1D set
+ * the values and derivatives of the peak to zero when it is calculated on a
+ * domain with a peak radius. The ends of the interval are excluded.
+ * CompositeFunction uses it to calculate the peak on the points inside the
+ * interval only.
+ * @param peakRadius :: The peak radius of the domain, in FWHM. 0 means no
+ * limit.
+ * @return A pair of doubles giving the bounds of the interval.
+ */
+std::pair<double, double>
+IPeakFunction::getPeakRadiusInterval(int peakRadius) const {
+  const int radius = peakRadius > 0
+                         ? peakRadius
+                         : (peakRadius == 0 ? MAX_PEAK_RADIUS : m_peakRadius);
+  const double c = this->centre();
+  const double dx = fabs(radius * this->fwhm());
+  return std::make_pair(c - dx, c + dx);
+}
+
 /// Returns the integral intensity of the peak function, using the peak radius
 /// to determine integration borders.
 double IPeakFunction::intensity() const {
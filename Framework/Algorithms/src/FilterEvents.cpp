@@ -1696,8 +1696,9 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   g_log.debug() << "Number of spectra in input/source EventWorkspace = "
                 << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
-  PARALLEL_FOR_NO_WSP_CHECK()
+  // Spectra differ widely in their number of events, so hand them out to the
+  // threads one at a time rather than in equal blocks
+  PARALLEL_FOR_NO_WSP_CHECK_DYNAMIC(1)
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
@@ -1769,7 +1770,9 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
                     "by pulse time.");
   }
 
-  PARALLEL_FOR_NO_WSP_CHECK()
+  // Spectra differ widely in their number of events, so hand them out to the
+  // threads one at a time rather than in equal blocks
+  PARALLEL_FOR_NO_WSP_CHECK_DYNAMIC(1)
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
@@ -10,6 +10,7 @@
 
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/HistoWorkspace.h"
+#include "MantidDataObjects/BinEdgeIndexer.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -183,6 +184,8 @@ void Rebin::exec() {
 
       // Initialize progress reporting.
       Progress prog(this, 0.0, 1.0, histnumber);
+      // All the spectra get the same bins, so find their spacing once
+      const DataObjects::BinEdgeIndexer indexer(XValues_new.rawData());
 
       // Go through all the histograms and set the data
       PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
@@ -192,7 +195,7 @@ void Rebin::exec() {
         const EventList &el = eventInputWS->getSpectrum(i);
         MantidVec y_data, e_data;
         // The EventList takes care of histogramming.
-        el.generateHistogram(XValues_new.rawData(), y_data, e_data);
+        el.generateHistogram(indexer, y_data, e_data);
 
         // Copy the data over.
         outputWS->mutableY(i) = std::move(y_data);
@@ -7,6 +7,7 @@
 #include "MantidAlgorithms/RebinToWorkspace.h"
 #include "MantidAPI/HistogramValidator.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataObjects/BinEdgeIndexer.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
@@ -163,6 +164,9 @@ void RebinToWorkspace::histogram(API::MatrixWorkspace_sptr &toRebin,
 
   auto outputWS = DataObjects::create<API::HistoWorkspace>(*toRebin);
   Progress prog(this, 0.25, 1.0, numHist);
+  // The spacing of the bins of the first spectrum is found once
+  const auto firstEdges = toMatch->binEdges(0);
+  const DataObjects::BinEdgeIndexer firstIndexer(firstEdges.rawData());
 
   // histogram
   PARALLEL_FOR_IF(Kernel::threadSafe(*toMatch, *outputWS))
@@ -174,7 +178,10 @@ void RebinToWorkspace::histogram(API::MatrixWorkspace_sptr &toRebin,
     // TODO this should be in HistogramData/Rebin
     const auto &eventlist = inputWS->getSpectrum(i);
     MantidVec y_data(edges.size() - 1), e_data(edges.size() - 1);
-    eventlist.generateHistogram(edges.rawData(), y_data, e_data);
+    if (matchingX)
+      eventlist.generateHistogram(firstIndexer, y_data, e_data);
+    else
+      eventlist.generateHistogram(edges.rawData(), y_data, e_data);
 
     outputWS->setHistogram(i, edges, Counts(std::move(y_data)),
                            CountStandardDeviations(std::move(e_data)));
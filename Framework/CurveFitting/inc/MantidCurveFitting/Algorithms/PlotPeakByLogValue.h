@@ -14,6 +14,8 @@
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidCurveFitting/Algorithms/PlotPeakByLogValueHelper.h"
 
+#include <functional>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace Algorithms {
@@ -59,6 +61,16 @@ public:
   const std::string category() const override { return "Optimization"; }
 
 private:
+  /// The results of the fit of one spectrum
+  struct SpectrumFitResult {
+    std::vector<double> parameters;
+    std::vector<double> errors;
+    double chi2 = 0.0;
+    API::MatrixWorkspace_sptr fitWorkspace;
+    API::ITableWorkspace_sptr parameterWorkspace;
+    API::ITableWorkspace_sptr covarianceWorkspace;
+  };
+
   // Overridden Algorithm methods
   void init() override;
   void exec() override;
@@ -71,7 +83,22 @@ private:
                                           bool outputCompositeMembers,
                                           bool outputConvolvedMembers,
                                           const API::IFunction_sptr &ifun,
-                                          const InputSpectraToFit &data);
+                                          const InputSpectraToFit &data,
+                                          const std::string &minimizer);
+
+  SpectrumFitResult fitSpectrum(bool createFitOutput,
+                                bool outputCompositeMembers,
+                                bool outputConvolvedMembers,
+                                const API::IFunction_sptr &ifun,
+                                const InputSpectraToFit &data,
+                                const std::string &minimizer);
+
+  void fitInParallel(
+      bool individual, bool passWSIndexToFunction,
+      const API::IFunction_sptr &inputFunction, bool isMultiDomainFunction,
+      const std::vector<InputSpectraToFit> &wsNames,
+      const std::vector<int> &toFit,
+      const std::function<void(size_t, const API::IFunction_sptr &)> &fitOne);
 
   double calculateLogValue(const std::string &logName,
                            const InputSpectraToFit &data);
@@ -81,9 +108,8 @@ private:
                      const API::IFunction_sptr &ifunSingle, bool &isDataName);
 
   void appendTableRow(bool isDataName, API::ITableWorkspace_sptr &result,
-                      const API::IFunction *const ifun,
-                      const InputSpectraToFit &data, double logValue,
-                      double chi2) const;
+                      const SpectrumFitResult &fitResult,
+                      const InputSpectraToFit &data, double logValue) const;
 
   void finaliseOutputWorkspaces(
       bool createFitOutput,
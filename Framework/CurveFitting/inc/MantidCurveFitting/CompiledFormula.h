@@ -0,0 +1,125 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidCurveFitting/DllConfig.h"
+
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Expression;
+class Jacobian;
+} // namespace API
+
+namespace CurveFitting {
+
+/** CompiledFormula : a formula of x and of a set of parameters, in the syntax
+  of mu::Parser, compiled into a list of instructions that each operate on a
+  block of data points at a time. The derivatives with respect to the
+  parameters are calculated alongside the values in forward mode: every
+  instruction also gives the derivatives of its result with respect to the
+  parameters it depends on.
+
+  Only the arithmetic operators and the common functions of one variable are
+  supported. The constructor throws std::invalid_argument for anything else,
+  for which the formula must be evaluated by mu::Parser.
+*/
+class MANTID_CURVEFITTING_DLL CompiledFormula {
+public:
+  CompiledFormula(const std::string &formula,
+                  const std::vector<std::string> &parameterNames);
+
+  /// @return the number of parameters of the formula
+  size_t nParams() const { return m_nParams; }
+
+  void evaluate(const double *xValues, const size_t nData,
+                const double *parameters, double *out) const;
+  void evaluateDerivatives(const double *xValues, const size_t nData,
+                           const double *parameters,
+                           const std::vector<bool> &active,
+                           API::Jacobian &jacobian) const;
+
+private:
+  /// The operations of the instructions
+  enum class OpCode {
+    Constant,
+    X,
+    Parameter,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    Negate,
+    Sqrt,
+    Exp,
+    Ln,
+    Log10,
+    Log2,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Abs,
+    Erf,
+    Erfc
+  };
+
+  /// An instruction, which sets the register of the same index
+  struct Instruction {
+    explicit Instruction(const OpCode opCode) : op(opCode) {}
+    OpCode op;
+    /// Registers of the operands
+    size_t a = 0;
+    size_t b = 0;
+    /// Value of a Constant or index of a Parameter
+    double value = 0.0;
+    size_t parameter = 0;
+    /// Parameters the result depends on, in increasing order
+    std::vector<size_t> dependencies;
+    /// Position of each dependency in the dependencies of the operands, or
+    /// -1 if the operand does not depend on it
+    std::vector<int> dependencyInA;
+    std::vector<int> dependencyInB;
+    /// Offset of the derivatives of the register in the derivative storage
+    size_t derivativeOffset = 0;
+  };
+
+  size_t compile(const API::Expression &expr);
+  size_t compileChain(const API::Expression &expr);
+  size_t compileFunction(const API::Expression &expr);
+  size_t compileName(const std::string &name);
+  size_t addInstruction(Instruction instruction);
+
+  void evaluateBlock(const double *xValues, const size_t n,
+                     const double *parameters, const std::vector<bool> *active,
+                     double *values, double *derivatives) const;
+  static void apply(const OpCode op, const double *a, const double *b,
+                    double *r, const size_t n);
+  static void differentiate(const OpCode op, const double *a, const double *b,
+                            const double *r, const bool needB, double *gradA,
+                            double *gradB, const size_t n);
+
+  /// Parameter names of the formula
+  std::vector<std::string> m_parameterNames;
+  /// Number of parameters
+  size_t m_nParams;
+  /// The instructions; the last one gives the result of the formula
+  std::vector<Instruction> m_instructions;
+  /// Number of derivative arrays of all the registers
+  size_t m_nDerivatives;
+};
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -15,6 +15,8 @@
 #include "MantidCurveFitting/GSLMatrix.h"
 #include "MantidCurveFitting/GSLVector.h"
 
+#include <Eigen/Core>
+
 namespace Mantid {
 namespace CurveFitting {
 class SeqDomain;
@@ -101,6 +103,10 @@ protected:
                                   bool evalDeriv = true,
                                   bool evalHessian = true) const = 0;
 
+  /// Add the derivatives and the Hessian calculated on a domain
+  void addDerivHessian(const Eigen::VectorXd &der,
+                       const Eigen::MatrixXd &hessian) const;
+
   bool isValid() const;
   void checkValidity() const;
   void calTransformationMatrixNumerically(GSLMatrix &tm);
@@ -60,6 +60,7 @@ public:
                   const size_t nData) const override;
   void functionDeriv1D(API::Jacobian *jacobian, const double *xValues,
                        const size_t nData) override;
+  std::pair<double, double> getPeakRadiusInterval(int) const override;
 
 protected:
   /// overwrite IFunction base class method, which declare function parameters
@@ -70,6 +71,7 @@ protected:
   void functionDerivLocal(API::Jacobian *, const double *,
                           const size_t) override {}
   double expWidth() const;
+  double extent() const;
 };
 
 using BackToBackExponential_sptr = std::shared_ptr<BackToBackExponential>;
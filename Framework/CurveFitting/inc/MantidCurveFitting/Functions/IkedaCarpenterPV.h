@@ -57,6 +57,8 @@ protected:
 private:
   /// container for storing wavelength values for each data point
   mutable std::vector<double> m_waveLength;
+  /// x values for which m_waveLength was calculated
+  mutable std::vector<double> m_waveLengthX;
 
   /// calculate the const function
   void constFunction(double *out, const double *xValues,
@@ -20,6 +20,8 @@ class Parser;
 
 namespace Mantid {
 namespace CurveFitting {
+class CompiledFormula;
+
 namespace Functions {
 /**
 A user defined function.
@@ -78,6 +80,10 @@ private:
   mutable std::vector<double> m_tmp;
   /// Temporary data storage used in functionDeriv
   mutable std::vector<double> m_tmp1;
+  /// The formula compiled with its derivatives, if it could be
+  std::unique_ptr<CompiledFormula> m_compiled;
+
+  std::vector<double> parameterValues() const;
 
   /// mu::Parser callback function for setting variables.
   static double *AddVariable(const char *varName, void *pufun);
@@ -12,8 +12,12 @@
 #include "MantidCurveFitting/Algorithms/Fit1D.h"
 #include "MantidGeometry/muParser_Silent.h"
 
+#include <memory>
+
 namespace Mantid {
 namespace CurveFitting {
+class CompiledFormula;
+
 namespace Functions {
 /**
 Deprecation notice: instead of using this algorithm please use the Fit algorithm
@@ -58,6 +62,8 @@ class UserFunction1D : public Algorithms::Fit1D {
 public:
   /// Constructor
   UserFunction1D() : m_x(0.0), m_x_set(false), m_parameters(100), m_nPars(0){};
+  /// Destructor
+  ~UserFunction1D() override;
   /// Algorithm's name for identification overriding a virtual method
   const std::string name() const override { return "UserFunction1D"; }
   /// Algorithm's version for identification overriding a virtual method
@@ -101,6 +107,8 @@ private:
   std::vector<double> m_tmp;
   /// Temporary data storage
   std::vector<double> m_tmp1;
+  /// The formula compiled with its derivatives, if it could be
+  std::unique_ptr<CompiledFormula> m_compiled;
 };
 
 } // namespace Functions
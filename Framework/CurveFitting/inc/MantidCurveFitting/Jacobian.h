@@ -7,10 +7,15 @@
 #pragma once
 
 #include "MantidAPI/Jacobian.h"
+#include "MantidCurveFitting/DllConfig.h"
 
+#include <Eigen/Core>
 #include <vector>
 
 namespace Mantid {
+namespace API {
+class IFunction;
+}
 namespace CurveFitting {
 /**
 An implementation of Jacobian using std::vector.
@@ -18,7 +23,7 @@ An implementation of Jacobian using std::vector.
 @author Roman Tolchenov
 @date 17/02/2012
 */
-class Jacobian : public API::Jacobian {
+class MANTID_CURVEFITTING_DLL Jacobian : public API::Jacobian {
   /// Number of data points
   size_t m_ny;
   /// Number of parameters in a function (== IFunction::nParams())
@@ -72,6 +77,15 @@ public:
   }
   /// overwrite base method
   void zero() override { m_data.assign(m_data.size(), 0.0); }
+  /// Get the derivatives, stored row by row (one row per data point)
+  const double *data() const { return m_data.data(); }
+  /// Calculate the products of the columns of the active parameters of a
+  /// function
+  void calculateProducts(const API::IFunction &function,
+                         const std::vector<double> &derivFactors,
+                         Eigen::VectorXd &der,
+                         const std::vector<double> &hessianFactors,
+                         Eigen::MatrixXd &hessian) const;
 };
 
 } // namespace CurveFitting
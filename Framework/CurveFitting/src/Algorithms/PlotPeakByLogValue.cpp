@@ -33,11 +33,26 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 namespace {
 Mantid::Kernel::Logger g_log("PlotPeakByLogValue");
+
+/// Number of neighbouring spectra fitted one after the other by a thread in
+/// the parallel sequential fits. It does not depend on the number of threads,
+/// so that neither do the results.
+constexpr size_t SEQUENTIAL_BLOCK_SIZE = 8;
+
+/// Copy the parameters and errors of a function to another of the same form
+void copyParameters(const Mantid::API::IFunction &from,
+                    Mantid::API::IFunction &to) {
+  for (size_t i = 0; i < to.nParams(); ++i) {
+    to.setParameter(i, from.getParameter(i));
+    to.setError(i, from.getError(i));
+  }
 }
+} // namespace
 
 namespace Mantid {
 namespace CurveFitting {
@@ -161,6 +176,15 @@ void PlotPeakByLogValue::init() {
 
   declareProperty("IgnoreInvalidData", false,
                   "Flag to ignore infinities, NaNs and data with zero errors.");
+
+  declareProperty(
+      "Parallel", false,
+      "Fit the spectra concurrently. With FitType 'Individual' every spectrum "
+      "is fitted independently. With 'Sequential' the spectra are split into "
+      "blocks of 8 neighbouring spectra fitted concurrently; within a block "
+      "every fit starts with the parameters returned by the fit of the "
+      "previous spectrum. The rows of the output are in the order of the "
+      "input in both cases.");
 }
 
 /**
@@ -207,19 +231,12 @@ void PlotPeakByLogValue::exec() {
   ITableWorkspace_sptr result =
       createResultsTable(logName, ifunSingle, isDataName);
 
-  std::vector<MatrixWorkspace_sptr> fitWorkspaces;
-  std::vector<ITableWorkspace_sptr> parameterWorkspaces;
-  std::vector<ITableWorkspace_sptr> covarianceWorkspaces;
-  if (createFitOutput) {
-    covarianceWorkspaces.reserve(wsNames.size());
-    fitWorkspaces.reserve(wsNames.size());
-    parameterWorkspaces.reserve(wsNames.size());
-  }
-
-  double dProg = 1. / static_cast<double>(wsNames.size());
-  double Prog = 0.;
+  // Select the spectra to fit and find their log values: either a log-file
+  // value or simply the workspace number
+  std::vector<int> toFit;
+  std::vector<double> logValues;
   for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
-    InputSpectraToFit data = wsNames[i];
+    const InputSpectraToFit &data = wsNames[i];
 
     if (!data.ws) {
       g_log.warning() << "Cannot access workspace " << data.name << '\n';
@@ -231,40 +248,60 @@ void PlotPeakByLogValue::exec() {
                       << wsNames[i].name << '\n';
       continue;
     }
+    toFit.emplace_back(i);
+    logValues.emplace_back(calculateLogValue(logName, data));
+  }
 
-    IFunction_sptr ifun =
-        setupFunction(individual, passWSIndexToFunction, inputFunction,
-                      initialParams, isMultiDomainFunction, i, data);
-
-    auto fit = runSingleFit(createFitOutput, outputCompositeMembers,
-                            outputConvolvedMembers, ifun, data);
-
-    ifun = fit->getProperty("Function");
-    double chi2 = fit->getProperty("OutputChi2overDoF");
+  // Making the minimizer strings records the workspaces output by the
+  // minimizers, so do it in the order of the input
+  std::vector<std::string> minimizers;
+  minimizers.reserve(toFit.size());
+  for (const int i : toFit)
+    minimizers.emplace_back(
+        getMinimizerString(wsNames[i].name, std::to_string(wsNames[i].i)));
+
+  std::vector<SpectrumFitResult> fitResults(toFit.size());
+  Progress prog(this, 0.0, 1.0, toFit.size());
+  auto fitOne = [&](const size_t k, const IFunction_sptr &ifun) {
+    fitResults[k] =
+        fitSpectrum(createFitOutput, outputCompositeMembers,
+                    outputConvolvedMembers, ifun, wsNames[toFit[k]],
+                    minimizers[k]);
+    prog.report("Fitting Workspace: (" + std::to_string(toFit[k]) + ") - ");
+  };
+
+  const bool parallel = getProperty("Parallel");
+  if (parallel) {
+    fitInParallel(individual, passWSIndexToFunction, inputFunction,
+                  isMultiDomainFunction, wsNames, toFit, fitOne);
+  } else {
+    for (size_t k = 0; k < toFit.size(); ++k) {
+      IFunction_sptr ifun =
+          setupFunction(individual, passWSIndexToFunction, inputFunction,
+                        initialParams, isMultiDomainFunction, toFit[k],
+                        wsNames[toFit[k]]);
+      fitOne(k, ifun);
+      interruption_point();
+    }
+  }
 
+  std::vector<MatrixWorkspace_sptr> fitWorkspaces;
+  std::vector<ITableWorkspace_sptr> parameterWorkspaces;
+  std::vector<ITableWorkspace_sptr> covarianceWorkspaces;
+  if (createFitOutput) {
+    covarianceWorkspaces.reserve(toFit.size());
+    fitWorkspaces.reserve(toFit.size());
+    parameterWorkspaces.reserve(toFit.size());
+  }
+  for (size_t k = 0; k < toFit.size(); ++k) {
+    const SpectrumFitResult &fitResult = fitResults[k];
     if (createFitOutput) {
-      MatrixWorkspace_sptr outputFitWorkspace =
-          fit->getProperty("OutputWorkspace");
-      ITableWorkspace_sptr outputParamWorkspace =
-          fit->getProperty("OutputParameters");
-      ITableWorkspace_sptr outputCovarianceWorkspace =
-          fit->getProperty("OutputNormalisedCovarianceMatrix");
-      fitWorkspaces.emplace_back(outputFitWorkspace);
-      parameterWorkspaces.emplace_back(outputParamWorkspace);
-      covarianceWorkspaces.emplace_back(outputCovarianceWorkspace);
+      fitWorkspaces.emplace_back(fitResult.fitWorkspace);
+      parameterWorkspaces.emplace_back(fitResult.parameterWorkspace);
+      covarianceWorkspaces.emplace_back(fitResult.covarianceWorkspace);
     }
-    g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
-                  << ' ' << chi2 << '\n';
-
-    // Find the log value: it is either a log-file value or
-    // simply the workspace number
-    double logValue = calculateLogValue(logName, data);
-    appendTableRow(isDataName, result, ifun.get(), data, logValue, chi2);
-
-    Prog += dProg;
-    std::string current = std::to_string(i);
-    progress(Prog, ("Fitting Workspace: (" + current + ") - "));
-    interruption_point();
+    appendTableRow(isDataName, result, fitResult, wsNames[toFit[k]],
+                   logValues[k]);
   }
   finaliseOutputWorkspaces(createFitOutput, fitWorkspaces, parameterWorkspaces,
                            covarianceWorkspaces);
@@ -301,6 +338,77 @@ PlotPeakByLogValue::setupFunction(bool individual, bool passWSIndexToFunction,
   return ifun;
 }
 
+/**
+ * Fit the spectra concurrently. With FitType Individual every spectrum is
+ * fitted independently. With Sequential the spectra are split into blocks of
+ * SEQUENTIAL_BLOCK_SIZE neighbouring spectra, and each fit of a block starts
+ * from the parameters returned by the fit of the previous spectrum of the
+ * block. The blocks do not depend on the number of threads. Every
+ * block fits its own clones of the function, so the input function is only
+ * updated, with the results of the last fits, at the end.
+ * @param individual :: true if every fit starts from the initial parameters
+ * @param passWSIndexToFunction :: pass the workspace index to the functions
+ * @param inputFunction :: the function of the Function property
+ * @param isMultiDomainFunction :: true if inputFunction has one member
+ * function per spectrum
+ * @param wsNames :: all the input spectra
+ * @param toFit :: the indices into wsNames of the spectra to fit
+ * @param fitOne :: fits the k-th spectrum of toFit with a function
+ */
+void PlotPeakByLogValue::fitInParallel(
+    bool individual, bool passWSIndexToFunction,
+    const IFunction_sptr &inputFunction, bool isMultiDomainFunction,
+    const std::vector<InputSpectraToFit> &wsNames,
+    const std::vector<int> &toFit,
+    const std::function<void(size_t, const IFunction_sptr &)> &fitOne) {
+  const size_t nSpectra = toFit.size();
+  const size_t blockSize = individual ? 1 : SEQUENTIAL_BLOCK_SIZE;
+  const size_t nBlocks = (nSpectra + blockSize - 1) / blockSize;
+
+  // Clone the functions before the threads start: one per block, or one per
+  // spectrum for a MultiDomainFunction
+  std::vector<IFunction_sptr> functions(isMultiDomainFunction ? nSpectra
+                                                              : nBlocks);
+  for (size_t k = 0; k < functions.size(); ++k)
+    functions[k] = isMultiDomainFunction
+                       ? inputFunction->getFunction(toFit[k])->clone()
+                       : inputFunction->clone();
+
+  PARALLEL_FOR_NO_WSP_CHECK_DYNAMIC(1)
+  for (int block = 0; block < static_cast<int>(nBlocks); ++block) {
+    PARALLEL_START_INTERUPT_REGION
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, nSpectra);
+    for (size_t k = begin; k < end; ++k) {
+      IFunction_sptr ifun;
+      if (isMultiDomainFunction) {
+        ifun = functions[k];
+        if (!individual && k != begin)
+          copyParameters(*functions[k - 1], *ifun);
+      } else {
+        // Fit updates the function, so it holds the parameters of the
+        // previous spectrum of the block
+        ifun = functions[block];
+      }
+      if (passWSIndexToFunction)
+        setWorkspaceIndexAttribute(ifun, wsNames[toFit[k]].i);
+      fitOne(k, ifun);
+      interruption_point();
+    }
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Leave the results of the last fits in the input function, as the serial
+  // fits do
+  if (isMultiDomainFunction) {
+    for (size_t k = 0; k < nSpectra; ++k)
+      copyParameters(*functions[k], *inputFunction->getFunction(toFit[k]));
+  } else if (!functions.empty()) {
+    copyParameters(*functions.back(), *inputFunction);
+  }
+}
+
 void PlotPeakByLogValue::finaliseOutputWorkspaces(
     bool createFitOutput,
     const std::vector<MatrixWorkspace_sptr> &fitWorkspaces,
@@ -340,10 +448,10 @@ void PlotPeakByLogValue::finaliseOutputWorkspaces(
 
 void PlotPeakByLogValue::appendTableRow(bool isDataName,
                                         ITableWorkspace_sptr &result,
-                                        const IFunction *const ifun,
+                                        const SpectrumFitResult &fitResult,
                                         const InputSpectraToFit &data,
-                                        double logValue, double chi2)
-    const { // Extract the fitted parameters and put them into the result table
+                                        double logValue)
+    const { // Put the fitted parameters into the result table
   TableRow row = result->appendRow();
   if (isDataName) {
     row << data.name;
@@ -351,10 +459,10 @@ void PlotPeakByLogValue::appendTableRow(bool isDataName,
     row << logValue;
   }
 
-  for (size_t iPar = 0; iPar < ifun->nParams(); ++iPar) {
-    row << ifun->getParameter(iPar) << ifun->getError(iPar);
+  for (size_t iPar = 0; iPar < fitResult.parameters.size(); ++iPar) {
+    row << fitResult.parameters[iPar] << fitResult.errors[iPar];
   }
-  row << chi2;
+  row << fitResult.chi2;
 }
 
 ITableWorkspace_sptr
@@ -387,7 +495,7 @@ PlotPeakByLogValue::createResultsTable(const std::string &logName,
 std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(
     bool createFitOutput, bool outputCompositeMembers,
     bool outputConvolvedMembers, const IFunction_sptr &ifun,
-    const InputSpectraToFit &data) {
+    const InputSpectraToFit &data, const std::string &minimizer) {
   g_log.debug() << "Fitting " << data.ws->getName() << " index " << data.i
                 << " with \n";
   g_log.debug() << ifun->asString() << '\n';
@@ -412,8 +520,7 @@ std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(
   fit->setPropertyValue("StartX", this->getPropertyValue("StartX"));
   fit->setPropertyValue("EndX", this->getPropertyValue("EndX"));
   fit->setProperty("IgnoreInvalidData", ignoreInvalidData);
-  fit->setPropertyValue("Minimizer",
-                        this->getMinimizerString(data.name, spectrum_index));
+  fit->setPropertyValue("Minimizer", minimizer);
   fit->setPropertyValue("CostFunction", this->getPropertyValue("CostFunction"));
   fit->setPropertyValue("MaxIterations",
                         this->getPropertyValue("MaxIterations"));
@@ -431,6 +538,44 @@ std::shared_ptr<Algorithm> PlotPeakByLogValue::runSingleFit(
   return fit;
 }
 
+/**
+ * Fit a spectrum and extract the results
+ * @param createFitOutput :: keep the output workspaces of the fit
+ * @param outputCompositeMembers :: output the members of composite functions
+ * @param outputConvolvedMembers :: output the convolved members
+ * @param ifun :: the function to fit, updated by the fit
+ * @param data :: the spectrum to fit
+ * @param minimizer :: the minimizer string
+ * @return the fitted parameters, chi squared and output workspaces
+ */
+PlotPeakByLogValue::SpectrumFitResult PlotPeakByLogValue::fitSpectrum(
+    bool createFitOutput, bool outputCompositeMembers,
+    bool outputConvolvedMembers, const IFunction_sptr &ifun,
+    const InputSpectraToFit &data, const std::string &minimizer) {
+  auto fit = runSingleFit(createFitOutput, outputCompositeMembers,
+                          outputConvolvedMembers, ifun, data, minimizer);
+
+  SpectrumFitResult fitResult;
+  IFunction_sptr fitted = fit->getProperty("Function");
+  fitResult.parameters.reserve(fitted->nParams());
+  fitResult.errors.reserve(fitted->nParams());
+  for (size_t iPar = 0; iPar < fitted->nParams(); ++iPar) {
+    fitResult.parameters.emplace_back(fitted->getParameter(iPar));
+    fitResult.errors.emplace_back(fitted->getError(iPar));
+  }
+  fitResult.chi2 = fit->getProperty("OutputChi2overDoF");
+
+  if (createFitOutput) {
+    fitResult.fitWorkspace = fit->getProperty("OutputWorkspace");
+    fitResult.parameterWorkspace = fit->getProperty("OutputParameters");
+    fitResult.covarianceWorkspace =
+        fit->getProperty("OutputNormalisedCovarianceMatrix");
+  }
+  g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus")
+                << ' ' << fitResult.chi2 << '\n';
+  return fitResult;
+}
+
 double PlotPeakByLogValue::calculateLogValue(const std::string &logName,
                                              const InputSpectraToFit &data) {
   double logValue = 0;
@@ -494,6 +494,11 @@ void QENSFitSequential::init() {
 
   declareProperty("IgnoreInvalidData", false,
                   "Flag to ignore infinities, NaNs and data with zero errors.");
+
+  declareProperty("Parallel", false,
+                  "Fit the spectra concurrently. With FitType Sequential, "
+                  "blocks of 8 neighbouring spectra are each fitted "
+                  "sequentially. See PlotPeakByLogValue.");
 }
 
 std::map<std::string, std::string> QENSFitSequential::validateInputs() {
@@ -746,6 +751,7 @@ ITableWorkspace_sptr QENSFitSequential::performFit(const std::string &input,
   const bool convolveMembers = getProperty("ConvolveMembers");
   const bool passWsIndex = getProperty("PassWSIndexToFunction");
   const bool ignoreInvalidData = getProperty("IgnoreInvalidData");
+  const bool parallel = getProperty("Parallel");
   IFunction_sptr inputFunction = getProperty("Function");
 
   // Run PlotPeaksByLogValue
@@ -769,6 +775,7 @@ ITableWorkspace_sptr QENSFitSequential::performFit(const std::string &input,
   plotPeaks->setProperty("EvaluationType", getPropertyValue("EvaluationType"));
   plotPeaks->setProperty("FitType", getPropertyValue("FitType"));
   plotPeaks->setProperty("CostFunction", getPropertyValue("CostFunction"));
+  plotPeaks->setProperty("Parallel", parallel);
   plotPeaks->executeAsChildAlg();
   return plotPeaks->getProperty("OutputWorkspace");
 }
@@ -0,0 +1,663 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/CompiledFormula.h"
+#include "MantidAPI/Expression.h"
+#include "MantidAPI/Jacobian.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+
+namespace Mantid {
+namespace CurveFitting {
+
+using API::Expression;
+
+namespace {
+/// Number of data points calculated at a time
+constexpr size_t BLOCK_SIZE = 256;
+
+/// Remove the spaces around a name
+std::string trimmed(const std::string &name) {
+  const auto first = name.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return std::string();
+  }
+  const auto last = name.find_last_not_of(" \t");
+  return name.substr(first, last - first + 1);
+}
+
+/// @return true if the expression is a unary + or - applied to a term
+bool isUnaryOperation(const Expression &expr) {
+  return expr.isFunct() && expr.size() == 1 &&
+         (expr.name() == "-" || expr.name() == "+");
+}
+
+/// Put a zero before a sign that opens a bracket. API::Expression drops the
+/// brackets around a unary operation, which would make (-a)^b read as -a^b.
+std::string zeroBeforeOpeningSigns(const std::string &formula) {
+  std::string result;
+  result.reserve(formula.size());
+  bool afterBracket = false;
+  for (const char c : formula) {
+    if (afterBracket && (c == '-' || c == '+')) {
+      result += '0';
+    }
+    if (c == '(') {
+      afterBracket = true;
+    } else if (c != ' ' && c != '\t') {
+      afterBracket = false;
+    }
+    result += c;
+  }
+  return result;
+}
+} // namespace
+
+/**
+ * Compile a formula.
+ * @param formula :: A formula of x and of the parameters in the syntax of
+ * mu::Parser
+ * @param parameterNames :: The names of the parameters in the formula. The
+ * parameter values given to evaluate() are in this order.
+ * @throw std::invalid_argument if the formula cannot be parsed or uses
+ * functions or operators that are not supported
+ */
+CompiledFormula::CompiledFormula(const std::string &formula,
+                                 const std::vector<std::string> &parameterNames)
+    : m_parameterNames(parameterNames), m_nParams(parameterNames.size()),
+      m_nDerivatives(0) {
+  Expression expr;
+  try {
+    expr.parse(zeroBeforeOpeningSigns(formula));
+  } catch (Expression::ParsingError &e) {
+    throw std::invalid_argument(e.what());
+  }
+  compile(expr);
+}
+
+/**
+ * Calculate the formula.
+ * @param xValues :: The x values
+ * @param nData :: The number of x values
+ * @param parameters :: The nParams() values of the parameters
+ * @param out :: The nData values of the formula
+ */
+void CompiledFormula::evaluate(const double *xValues, const size_t nData,
+                               const double *parameters, double *out) const {
+  std::vector<double> values(m_instructions.size() * BLOCK_SIZE);
+  const double *result = values.data() + values.size() - BLOCK_SIZE;
+  for (size_t start = 0; start < nData; start += BLOCK_SIZE) {
+    const size_t n = std::min(BLOCK_SIZE, nData - start);
+    evaluateBlock(xValues + start, n, parameters, nullptr, values.data(),
+                  nullptr);
+    std::copy_n(result, n, out + start);
+  }
+}
+
+/**
+ * Calculate the derivatives of the formula with respect to its parameters.
+ * @param xValues :: The x values
+ * @param nData :: The number of x values
+ * @param parameters :: The nParams() values of the parameters
+ * @param active :: Flags of the parameters to calculate the derivatives of.
+ * The other columns of the Jacobian are left unchanged.
+ * @param jacobian :: The Jacobian, with a column per parameter
+ */
+void CompiledFormula::evaluateDerivatives(const double *xValues,
+                                          const size_t nData,
+                                          const double *parameters,
+                                          const std::vector<bool> &active,
+                                          API::Jacobian &jacobian) const {
+  // the values of the registers and two arrays for the derivatives of the
+  // results of the instructions with respect to their operands
+  std::vector<double> values((m_instructions.size() + 2) * BLOCK_SIZE);
+  std::vector<double> derivatives(m_nDerivatives * BLOCK_SIZE);
+  const auto &result = m_instructions.back();
+  for (size_t start = 0; start < nData; start += BLOCK_SIZE) {
+    const size_t n = std::min(BLOCK_SIZE, nData - start);
+    evaluateBlock(xValues + start, n, parameters, &active, values.data(),
+                  derivatives.data());
+    for (size_t ip = 0; ip < m_nParams; ++ip) {
+      if (!active[ip]) {
+        continue;
+      }
+      const auto dep = std::lower_bound(result.dependencies.cbegin(),
+                                        result.dependencies.cend(), ip);
+      if (dep == result.dependencies.cend() || *dep != ip) {
+        for (size_t i = 0; i < n; ++i) {
+          jacobian.set(start + i, ip, 0.0);
+        }
+        continue;
+      }
+      const size_t k = static_cast<size_t>(dep - result.dependencies.cbegin());
+      const double *derivative =
+          derivatives.data() + (result.derivativeOffset + k) * BLOCK_SIZE;
+      for (size_t i = 0; i < n; ++i) {
+        jacobian.set(start + i, ip, derivative[i]);
+      }
+    }
+  }
+}
+
+/**
+ * Compile an expression and the expressions it is made of.
+ * @param expr :: An expression
+ * @return The register of its result
+ */
+size_t CompiledFormula::compile(const Expression &expr) {
+  if (!expr.isFunct()) {
+    return compileName(trimmed(expr.name()));
+  }
+  const auto name = trimmed(expr.name());
+  if (name.empty() && expr.size() == 1) {
+    return compile(expr[0]);
+  }
+  if (isUnaryOperation(expr)) {
+    const size_t a = compile(expr[0]);
+    if (name == "+") {
+      return a;
+    }
+    Instruction instruction(OpCode::Negate);
+    instruction.a = a;
+    return addInstruction(std::move(instruction));
+  }
+  if (name == "+" || name == "*" || name == "^") {
+    return compileChain(expr);
+  }
+  return compileFunction(expr);
+}
+
+/**
+ * Compile a sequence of terms joined by binary operators of the same
+ * precedence, such as a+b-c, from left to right.
+ * @param expr :: An expression with the terms
+ * @return The register of its result
+ */
+size_t CompiledFormula::compileChain(const Expression &expr) {
+  if (expr.name() == "^") {
+    // mu::Parser versions differ on the associativity of a^b^c, leave that
+    // to it
+    if (expr.size() != 2) {
+      throw std::invalid_argument("Ambiguous power in " + expr.str());
+    }
+    // API::Expression binds a unary sign more tightly than a power but
+    // mu::Parser calculates -a^b as -(a^b), so the sign is applied last
+    const Expression *base = &expr[0];
+    bool negate = false;
+    while (isUnaryOperation(*base)) {
+      negate = negate != (base->name() == "-");
+      base = &(*base)[0];
+    }
+    Instruction instruction(OpCode::Power);
+    instruction.a = compile(*base);
+    instruction.b = compile(expr[1]);
+    const auto &exponent = m_instructions[instruction.b];
+    if (exponent.op == OpCode::Constant && exponent.value == 2.0) {
+      instruction.op = OpCode::Multiply;
+      instruction.b = instruction.a;
+    }
+    const size_t power = addInstruction(std::move(instruction));
+    if (!negate) {
+      return power;
+    }
+    Instruction negation(OpCode::Negate);
+    negation.a = power;
+    return addInstruction(std::move(negation));
+  }
+
+  const std::map<std::string, OpCode> operators = {
+      {"+", OpCode::Add},
+      {"-", OpCode::Subtract},
+      {"*", OpCode::Multiply},
+      {"/", OpCode::Divide}};
+  size_t result = compile(expr[0]);
+  for (size_t i = 1; i < expr.size(); ++i) {
+    const auto op = operators.find(expr[i].operator_name());
+    if (op == operators.end()) {
+      throw std::invalid_argument("Unsupported operator " +
+                                  expr[i].operator_name());
+    }
+    Instruction instruction(op->second);
+    instruction.a = result;
+    instruction.b = compile(expr[i]);
+    result = addInstruction(std::move(instruction));
+  }
+  return result;
+}
+
+/**
+ * Compile a call to a function of one variable.
+ * @param expr :: An expression with the function name and argument
+ * @return The register of its result
+ */
+size_t CompiledFormula::compileFunction(const Expression &expr) {
+  const std::map<std::string, OpCode> functions = {
+      {"sqrt", OpCode::Sqrt},   {"exp", OpCode::Exp},   {"ln", OpCode::Ln},
+      {"log10", OpCode::Log10}, {"log2", OpCode::Log2}, {"sin", OpCode::Sin},
+      {"cos", OpCode::Cos},     {"tan", OpCode::Tan},   {"asin", OpCode::Asin},
+      {"acos", OpCode::Acos},   {"atan", OpCode::Atan}, {"sinh", OpCode::Sinh},
+      {"cosh", OpCode::Cosh},   {"tanh", OpCode::Tanh}, {"abs", OpCode::Abs},
+      {"erf", OpCode::Erf},     {"erfc", OpCode::Erfc}};
+  const auto name = trimmed(expr.name());
+  const auto function = functions.find(name);
+  if (function == functions.end() || expr.size() != 1) {
+    throw std::invalid_argument("Unsupported function " + name);
+  }
+  Instruction instruction(function->second);
+  instruction.a = compile(expr[0]);
+  return addInstruction(std::move(instruction));
+}
+
+/**
+ * Compile a number, x, a parameter or a constant of mu::Parser.
+ * @param name :: The name or number
+ * @return The register of its value
+ */
+size_t CompiledFormula::compileName(const std::string &name) {
+  if (name == "x") {
+    return addInstruction(Instruction(OpCode::X));
+  }
+  const auto parameter =
+      std::find(m_parameterNames.cbegin(), m_parameterNames.cend(), name);
+  if (parameter != m_parameterNames.cend()) {
+    Instruction instruction(OpCode::Parameter);
+    instruction.parameter =
+        static_cast<size_t>(parameter - m_parameterNames.cbegin());
+    return addInstruction(std::move(instruction));
+  }
+  Instruction instruction(OpCode::Constant);
+  if (name == "_pi") {
+    instruction.value = M_PI;
+  } else if (name == "_e") {
+    instruction.value = M_E;
+  } else {
+    char *end = nullptr;
+    instruction.value = std::strtod(name.c_str(), &end);
+    if (name.empty() || !(std::isdigit(name.front()) || name.front() == '.') ||
+        *end != '\0') {
+      throw std::invalid_argument("Unknown name " + name);
+    }
+  }
+  return addInstruction(std::move(instruction));
+}
+
+/**
+ * Add an instruction, working out the parameters its result depends on. An
+ * operation on constants is replaced by a constant.
+ * @param instruction :: A new instruction with its operation and operands
+ * @return The register of its result
+ */
+size_t CompiledFormula::addInstruction(Instruction instruction) {
+  const bool binary =
+      instruction.op == OpCode::Add || instruction.op == OpCode::Subtract ||
+      instruction.op == OpCode::Multiply || instruction.op == OpCode::Divide ||
+      instruction.op == OpCode::Power;
+  const bool unary = !binary && instruction.op != OpCode::Constant &&
+                     instruction.op != OpCode::X &&
+                     instruction.op != OpCode::Parameter;
+  if (!binary) {
+    instruction.b = instruction.a;
+  }
+
+  if (instruction.op == OpCode::Parameter) {
+    instruction.dependencies.emplace_back(instruction.parameter);
+  } else if (binary || unary) {
+    const auto &a = m_instructions[instruction.a];
+    const auto &b = m_instructions[instruction.b];
+    if (a.op == OpCode::Constant && b.op == OpCode::Constant) {
+      // fold the constants with the same code as the data
+      double value = 0.0;
+      apply(instruction.op, &a.value, &b.value, &value, 1);
+      Instruction constant(OpCode::Constant);
+      constant.value = value;
+      return addInstruction(std::move(constant));
+    }
+    std::set_union(a.dependencies.cbegin(), a.dependencies.cend(),
+                   b.dependencies.cbegin(), b.dependencies.cend(),
+                   std::back_inserter(instruction.dependencies));
+    for (const auto ip : instruction.dependencies) {
+      const auto inA = std::lower_bound(a.dependencies.cbegin(),
+                                        a.dependencies.cend(), ip);
+      const auto inB = std::lower_bound(b.dependencies.cbegin(),
+                                        b.dependencies.cend(), ip);
+      instruction.dependencyInA.emplace_back(
+          inA != a.dependencies.cend() && *inA == ip
+              ? static_cast<int>(inA - a.dependencies.cbegin())
+              : -1);
+      // for a unary operation b is a and must not be counted twice
+      instruction.dependencyInB.emplace_back(
+          binary && inB != b.dependencies.cend() && *inB == ip
+              ? static_cast<int>(inB - b.dependencies.cbegin())
+              : -1);
+    }
+  }
+  instruction.derivativeOffset = m_nDerivatives;
+  m_nDerivatives += instruction.dependencies.size();
+  m_instructions.emplace_back(std::move(instruction));
+  return m_instructions.size() - 1;
+}
+
+/**
+ * Run all the instructions on a block of data points.
+ * @param xValues :: The x values of the block
+ * @param n :: The number of points in the block, at most BLOCK_SIZE
+ * @param parameters :: The values of the parameters
+ * @param active :: Flags of the parameters to calculate the derivatives of,
+ * or nullptr to calculate the values only
+ * @param values :: Storage for the values of the registers, BLOCK_SIZE per
+ * register, and two more arrays of BLOCK_SIZE if active is set
+ * @param derivatives :: Storage for the derivatives of the registers,
+ * BLOCK_SIZE per derivative
+ */
+void CompiledFormula::evaluateBlock(const double *xValues, const size_t n,
+                                    const double *parameters,
+                                    const std::vector<bool> *active,
+                                    double *values,
+                                    double *derivatives) const {
+  double *gradA = values + m_instructions.size() * BLOCK_SIZE;
+  double *gradB = gradA + BLOCK_SIZE;
+  for (size_t ir = 0; ir < m_instructions.size(); ++ir) {
+    const auto &instruction = m_instructions[ir];
+    double *r = values + ir * BLOCK_SIZE;
+    const double *a = values + instruction.a * BLOCK_SIZE;
+    const double *b = values + instruction.b * BLOCK_SIZE;
+    switch (instruction.op) {
+    case OpCode::Constant:
+      std::fill_n(r, n, instruction.value);
+      break;
+    case OpCode::X:
+      std::copy_n(xValues, n, r);
+      break;
+    case OpCode::Parameter:
+      std::fill_n(r, n, parameters[instruction.parameter]);
+      break;
+    default:
+      apply(instruction.op, a, b, r, n);
+    }
+
+    if (!active || instruction.dependencies.empty()) {
+      continue;
+    }
+    if (instruction.op == OpCode::Parameter) {
+      if ((*active)[instruction.parameter]) {
+        std::fill_n(derivatives + instruction.derivativeOffset * BLOCK_SIZE, n,
+                    1.0);
+      }
+      continue;
+    }
+
+    // derivatives of the result with respect to the operands
+    const bool needB = std::any_of(instruction.dependencyInB.cbegin(),
+                                   instruction.dependencyInB.cend(),
+                                   [](const int k) { return k >= 0; });
+    differentiate(instruction.op, a, b, r, needB, gradA, gradB, n);
+
+    // chain rule for each parameter
+    const auto &instructionA = m_instructions[instruction.a];
+    const auto &instructionB = m_instructions[instruction.b];
+    for (size_t k = 0; k < instruction.dependencies.size(); ++k) {
+      if (!(*active)[instruction.dependencies[k]]) {
+        continue;
+      }
+      double *d =
+          derivatives + (instruction.derivativeOffset + k) * BLOCK_SIZE;
+      const int kA = instruction.dependencyInA[k];
+      const int kB = instruction.dependencyInB[k];
+      const double *dA =
+          kA < 0 ? nullptr
+                 : derivatives + (instructionA.derivativeOffset + kA) *
+                                     BLOCK_SIZE;
+      const double *dB =
+          kB < 0 ? nullptr
+                 : derivatives + (instructionB.derivativeOffset + kB) *
+                                     BLOCK_SIZE;
+      if (dA && dB) {
+        for (size_t i = 0; i < n; ++i)
+          d[i] = gradA[i] * dA[i] + gradB[i] * dB[i];
+      } else if (dA) {
+        for (size_t i = 0; i < n; ++i)
+          d[i] = gradA[i] * dA[i];
+      } else {
+        for (size_t i = 0; i < n; ++i)
+          d[i] = gradB[i] * dB[i];
+      }
+    }
+  }
+}
+
+/**
+ * Calculate the result of an operation.
+ * @param op :: The operation, other than Constant, X and Parameter
+ * @param a :: The values of the first operand
+ * @param b :: The values of the second operand of a binary operation
+ * @param r :: The results
+ * @param n :: The number of values
+ */
+void CompiledFormula::apply(const OpCode op, const double *a, const double *b,
+                            double *r, const size_t n) {
+  switch (op) {
+  case OpCode::Add:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] + b[i];
+    break;
+  case OpCode::Subtract:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] - b[i];
+    break;
+  case OpCode::Multiply:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] * b[i];
+    break;
+  case OpCode::Divide:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] / b[i];
+    break;
+  case OpCode::Power:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::pow(a[i], b[i]);
+    break;
+  case OpCode::Negate:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = -a[i];
+    break;
+  case OpCode::Sqrt:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::sqrt(a[i]);
+    break;
+  case OpCode::Exp:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::exp(a[i]);
+    break;
+  case OpCode::Ln:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::log(a[i]);
+    break;
+  case OpCode::Log10:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::log10(a[i]);
+    break;
+  case OpCode::Log2:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::log2(a[i]);
+    break;
+  case OpCode::Sin:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::sin(a[i]);
+    break;
+  case OpCode::Cos:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::cos(a[i]);
+    break;
+  case OpCode::Tan:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::tan(a[i]);
+    break;
+  case OpCode::Asin:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::asin(a[i]);
+    break;
+  case OpCode::Acos:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::acos(a[i]);
+    break;
+  case OpCode::Atan:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::atan(a[i]);
+    break;
+  case OpCode::Sinh:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::sinh(a[i]);
+    break;
+  case OpCode::Cosh:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::cosh(a[i]);
+    break;
+  case OpCode::Tanh:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::tanh(a[i]);
+    break;
+  case OpCode::Abs:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::fabs(a[i]);
+    break;
+  case OpCode::Erf:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::erf(a[i]);
+    break;
+  case OpCode::Erfc:
+    for (size_t i = 0; i < n; ++i)
+      r[i] = std::erfc(a[i]);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Calculate the derivatives of the result of an operation with respect to its
+ * operands.
+ * @param op :: The operation, other than Constant, X and Parameter
+ * @param a :: The values of the first operand
+ * @param b :: The values of the second operand of a binary operation
+ * @param r :: The results of the operation
+ * @param needB :: False if the derivatives with respect to b are not needed
+ * @param gradA :: The derivatives with respect to a
+ * @param gradB :: The derivatives with respect to b
+ * @param n :: The number of values
+ */
+void CompiledFormula::differentiate(const OpCode op, const double *a,
+                                    const double *b, const double *r,
+                                    const bool needB, double *gradA,
+                                    double *gradB, const size_t n) {
+  switch (op) {
+  case OpCode::Add:
+    std::fill_n(gradA, n, 1.0);
+    std::fill_n(gradB, n, 1.0);
+    break;
+  case OpCode::Subtract:
+    std::fill_n(gradA, n, 1.0);
+    std::fill_n(gradB, n, -1.0);
+    break;
+  case OpCode::Multiply:
+    std::copy_n(b, n, gradA);
+    std::copy_n(a, n, gradB);
+    break;
+  case OpCode::Divide:
+    for (size_t i = 0; i < n; ++i) {
+      gradA[i] = 1.0 / b[i];
+      gradB[i] = -r[i] / b[i];
+    }
+    break;
+  case OpCode::Power:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = b[i] * std::pow(a[i], b[i] - 1.0);
+    if (needB) {
+      for (size_t i = 0; i < n; ++i)
+        gradB[i] = r[i] * std::log(a[i]);
+    }
+    break;
+  case OpCode::Negate:
+    std::fill_n(gradA, n, -1.0);
+    break;
+  case OpCode::Sqrt:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 0.5 / r[i];
+    break;
+  case OpCode::Exp:
+    std::copy_n(r, n, gradA);
+    break;
+  case OpCode::Ln:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 / a[i];
+    break;
+  case OpCode::Log10:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 / (a[i] * M_LN10);
+    break;
+  case OpCode::Log2:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 / (a[i] * M_LN2);
+    break;
+  case OpCode::Sin:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = std::cos(a[i]);
+    break;
+  case OpCode::Cos:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = -std::sin(a[i]);
+    break;
+  case OpCode::Tan:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 + r[i] * r[i];
+    break;
+  case OpCode::Asin:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 / std::sqrt(1.0 - a[i] * a[i]);
+    break;
+  case OpCode::Acos:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = -1.0 / std::sqrt(1.0 - a[i] * a[i]);
+    break;
+  case OpCode::Atan:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 / (1.0 + a[i] * a[i]);
+    break;
+  case OpCode::Sinh:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = std::cosh(a[i]);
+    break;
+  case OpCode::Cosh:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = std::sinh(a[i]);
+    break;
+  case OpCode::Tanh:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = 1.0 - r[i] * r[i];
+    break;
+  case OpCode::Abs:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = a[i] > 0.0 ? 1.0 : (a[i] < 0.0 ? -1.0 : 0.0);
+    break;
+  case OpCode::Erf:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = M_2_SQRTPI * std::exp(-a[i] * a[i]);
+    break;
+  case OpCode::Erfc:
+    for (size_t i = 0; i < n; ++i)
+      gradA[i] = -M_2_SQRTPI * std::exp(-a[i] * a[i]);
+    break;
+  default:
+    break;
+  }
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
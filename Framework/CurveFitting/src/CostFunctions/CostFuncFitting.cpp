@@ -12,6 +12,7 @@
 #include "MantidCurveFitting/GSLJacobian.h"
 #include "MantidCurveFitting/SeqDomain.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <gsl/gsl_multifit_nlin.h>
 #include <limits>
@@ -467,6 +468,37 @@ const GSLMatrix &CostFuncFitting::getHessian() const {
   return m_hessian;
 }
 
+/**
+ * Add the derivatives and the Hessian of the active parameters calculated on
+ * a domain to the ones of the cost function. The domains of a ParDomain call
+ * it from different threads, each once.
+ * @param der :: Derivatives to add. Ignored if empty.
+ * @param hessian :: Hessian to add, of which only the lower triangle is used.
+ * Ignored if empty.
+ */
+void CostFuncFitting::addDerivHessian(const Eigen::VectorXd &der,
+                                      const Eigen::MatrixXd &hessian) const {
+  PARALLEL_CRITICAL(der_set) {
+    for (Eigen::DenseIndex i = 0; i < der.size(); ++i) {
+      const auto index = static_cast<size_t>(i);
+      m_der.set(index, m_der.get(index) + der(i));
+    }
+  }
+  PARALLEL_CRITICAL(hessian_set) {
+    for (Eigen::DenseIndex i = 0; i < hessian.rows(); ++i) {
+      for (Eigen::DenseIndex j = 0; j <= i; ++j) {
+        const auto i1 = static_cast<size_t>(i);
+        const auto i2 = static_cast<size_t>(j);
+        const double h = m_hessian.get(i1, i2) + hessian(i, j);
+        m_hessian.set(i1, i2, h);
+        if (i1 != i2) {
+          m_hessian.set(i2, i1, h);
+        }
+      }
+    }
+  }
+}
+
 /**
  * Save current parameters, derivatives and hessian.
  */
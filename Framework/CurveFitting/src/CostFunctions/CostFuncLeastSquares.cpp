@@ -79,64 +79,29 @@ void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function,
   Jacobian jacobian(ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
   double fVal = 0.0;
   std::vector<double> weights = getFitWeights(values);
-
-  for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
-      }
-    }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
-    }
-    ++iActiveP;
+  std::vector<double> derivFactors(ny);
+
+  for (size_t i = 0; i < ny; ++i) {
+    double calc = values->getCalculated(i);
+    double obs = values->getFitData(i);
+    double w = weights[i];
+    double y = (calc - obs) * w;
+    derivFactors[i] = y * w;
+    fVal += y * y;
   }
 
   PARALLEL_ATOMIC
   m_value += 0.5 * fVal;
 
-  if (!evalHessian)
-    return;
-
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
-      continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
-        }
-      }
-      ++i2;
-    }
-    ++i1;
-  }
+  // der = J^T * w^2 * (calc - obs) and hessian = J^T * w^2 * J
+  Eigen::VectorXd der;
+  Eigen::MatrixXd hessian;
+  jacobian.calculateProducts(*function, derivFactors, der,
+                             evalHessian ? weights : std::vector<double>(),
+                             hessian);
+  addDerivHessian(der, hessian);
 }
 
 std::vector<double>
@@ -119,54 +119,40 @@ void CostFuncPoisson::calculateDerivative(API::IFunction &function,
   function.function(domain, values);
   function.functionDeriv(domain, jacobian);
 
-  size_t activeParamIndex = 0;
+  // The derivative of the cost function is the sum of the columns of the
+  // jacobian multiplied by a factor of each data point
+  std::vector<double> factors(numDataPoints, 0.0);
+  bool isInfinite = false;
   double costVal = 0.0;
 
-  for (size_t paramIndex = 0; paramIndex < numParams; ++paramIndex) {
-    if (!function.isActive(paramIndex))
-      continue;
-
-    double determinant = 0.0;
-    for (size_t i = 0; i < numDataPoints; ++i) {
-      double calc = values.getCalculated(i);
-      double obs = values.getFitData(i);
-
-      if (calc <= absoluteCutOff) {
-        if (activeParamIndex == 0) {
-          costVal += std::numeric_limits<double>::infinity();
-        }
-        determinant += std::numeric_limits<double>::infinity();
-        continue;
-      }
-
-      if (calc <= effectiveCutOff) {
-        if (activeParamIndex == 0) {
-          costVal += (effectiveCutOff - calc) / (calc - absoluteCutOff);
-        }
-        double tmp = calc - absoluteCutOff;
-        determinant += jacobian.get(i, paramIndex) *
-                       (absoluteCutOff - effectiveCutOff) / (tmp * tmp);
-
-      } else if (obs == 0.0) {
-        if (activeParamIndex == 0) {
-          costVal += calc;
-        }
-        determinant += jacobian.get(i, paramIndex);
-
-      } else {
-        if (activeParamIndex == 0) {
-          costVal += calculatePoissonLoss(obs, calc);
-        }
-        determinant += jacobian.get(i, paramIndex) * (1.0 - obs / calc);
-      }
-    }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(activeParamIndex);
-      m_der.set(activeParamIndex, der + determinant);
+  for (size_t i = 0; i < numDataPoints; ++i) {
+    double calc = values.getCalculated(i);
+    double obs = values.getFitData(i);
+
+    if (calc <= absoluteCutOff) {
+      costVal += std::numeric_limits<double>::infinity();
+      isInfinite = true;
+    } else if (calc <= effectiveCutOff) {
+      costVal += (effectiveCutOff - calc) / (calc - absoluteCutOff);
+      double tmp = calc - absoluteCutOff;
+      factors[i] = (absoluteCutOff - effectiveCutOff) / (tmp * tmp);
+    } else if (obs == 0.0) {
+      costVal += calc;
+      factors[i] = 1.0;
+    } else {
+      costVal += calculatePoissonLoss(obs, calc);
+      factors[i] = 1.0 - obs / calc;
     }
-    ++activeParamIndex;
   }
 
+  Eigen::VectorXd der;
+  Eigen::MatrixXd hessian;
+  jacobian.calculateProducts(function, factors, der, {}, hessian);
+  if (isInfinite) {
+    der.setConstant(std::numeric_limits<double>::infinity());
+  }
+  addDerivHessian(der, hessian);
+
   PARALLEL_ATOMIC
   m_value += 2.0 * costVal;
 }
@@ -176,17 +162,69 @@ void CostFuncPoisson::calculateHessian(API::IFunction &function,
                                        API::FunctionValues &values) const {
   size_t numParams = function.nParams(); // number of parameters
   size_t numDataPoints = domain.size();  // number of data points
+  if (numDataPoints == 0)
+    return;
 
   Jacobian jacobian(numDataPoints, numParams);
   function.functionDeriv(domain, jacobian);
 
-  size_t activeParamFirstIndex =
-      0; // The params are split into two halves and iterated through
-  for (size_t paramIndex = 0; paramIndex < numParams; ++paramIndex) {
+  // The Hessian is the sum of the second derivatives of the function
+  // multiplied by the factors of the first derivatives, plus the products of
+  // the first derivatives multiplied by the square of a second factor
+  std::vector<double> derivFactors(numDataPoints, 0.0);
+  std::vector<double> productFactors(numDataPoints, 0.0);
+  // The products are summed as squares, so the points with negative counts
+  // are summed separately and subtracted
+  std::vector<double> negativeFactors;
+  bool isInfinite = false;
+
+  for (size_t k = 0; k < numDataPoints; ++k) {
+    double calc = values.getCalculated(k);
+    double obs = values.getFitData(k);
+    if (calc <= absoluteCutOff) {
+      isInfinite = true;
+    } else if (calc <= effectiveCutOff) {
+      double constrainedCalc = calc - absoluteCutOff;
+      derivFactors[k] = (absoluteCutOff - effectiveCutOff) /
+                        (constrainedCalc * constrainedCalc);
+      productFactors[k] =
+          std::sqrt((effectiveCutOff - absoluteCutOff) * 2 /
+                    (constrainedCalc * constrainedCalc * constrainedCalc));
+    } else if (obs == 0.0) {
+      derivFactors[k] = 1.0;
+    } else {
+      derivFactors[k] = 1.0 - obs / calc;
+      if (obs > 0.0) {
+        productFactors[k] = std::sqrt(obs) / calc;
+      } else {
+        if (negativeFactors.empty())
+          negativeFactors.resize(numDataPoints, 0.0);
+        negativeFactors[k] = std::sqrt(-obs) / calc;
+      }
+    }
+  }
+
+  Eigen::VectorXd der;
+  Eigen::MatrixXd hessian;
+  jacobian.calculateProducts(function, {}, der, productFactors, hessian);
+  if (!negativeFactors.empty()) {
+    Eigen::MatrixXd negativeHessian;
+    jacobian.calculateProducts(function, {}, der, negativeFactors,
+                               negativeHessian);
+    hessian -= negativeHessian;
+  }
 
+  using RowMajorMatrix =
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  const auto rows = static_cast<Eigen::DenseIndex>(numDataPoints);
+  const auto cols = static_cast<Eigen::DenseIndex>(numParams);
+  Eigen::Map<const RowMajorMatrix> derivatives(jacobian.data(), rows, cols);
+  Eigen::Map<const Eigen::VectorXd> factors(derivFactors.data(), rows);
+
+  Eigen::DenseIndex activeParamFirstIndex = 0;
+  for (size_t paramIndex = 0; paramIndex < numParams; ++paramIndex) {
     if (!function.isActive(paramIndex))
       continue;
-    size_t activeParamSecondIndex = 0; // The counterpart index
     double parameter = function.getParameter(paramIndex);
 
     double scalingFactor = 1e-4;
@@ -199,48 +237,27 @@ void CostFuncPoisson::calculateHessian(API::IFunction &function,
     function.functionDeriv(domain, jacobian2);
     function.setParameter(paramIndex, parameter);
 
-    for (size_t j = 0; j <= paramIndex; ++j) // over ~ half of parameters
-    {
+    // Numerical second derivatives by paramIndex, multiplied by the factors
+    Eigen::Map<const RowMajorMatrix> derivatives2(jacobian2.data(), rows,
+                                                  cols);
+    const Eigen::VectorXd secondDerivs =
+        (derivatives2 - derivatives).transpose() * factors / scalingFactor;
+
+    Eigen::DenseIndex activeParamSecondIndex = 0;
+    for (size_t j = 0; j <= paramIndex; ++j) {
       if (!function.isActive(j))
         continue;
-      double d = 0.0;
-      for (size_t k = 0; k < numDataPoints; ++k) // over fitting data
-      {
-        double d2 = (jacobian2.get(k, j) - jacobian.get(k, j)) / scalingFactor;
-
-        double calc = values.getCalculated(k);
-        double obs = values.getFitData(k);
-        if (calc <= absoluteCutOff) {
-          d += std::numeric_limits<double>::infinity();
-        } else {
-          if (calc <= effectiveCutOff) {
-            double constrainedCalc = calc - absoluteCutOff;
-            d += d2 * (absoluteCutOff - effectiveCutOff) /
-                 (constrainedCalc * constrainedCalc);
-            d += jacobian.get(k, paramIndex) * jacobian.get(k, j) *
-                 (effectiveCutOff - absoluteCutOff) * 2 /
-                 (constrainedCalc * constrainedCalc * constrainedCalc);
-          } else if (obs == 0.0) {
-            d += d2;
-          } else {
-            d += d2 * (1.0 - obs / calc);
-            d += jacobian.get(k, paramIndex) * jacobian.get(k, j) * obs /
-                 (calc * calc);
-          }
-        }
-      }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h =
-            m_hessian.get(activeParamFirstIndex, activeParamSecondIndex) + d;
-        m_hessian.set(activeParamFirstIndex, activeParamSecondIndex, h);
-        if (activeParamFirstIndex != activeParamSecondIndex) {
-          m_hessian.set(activeParamSecondIndex, activeParamFirstIndex, h);
-        }
-      }
+      hessian(activeParamFirstIndex, activeParamSecondIndex) +=
+          secondDerivs(static_cast<Eigen::DenseIndex>(j));
       ++activeParamSecondIndex;
     }
     ++activeParamFirstIndex;
   }
+
+  if (isInfinite) {
+    hessian.setConstant(std::numeric_limits<double>::infinity());
+  }
+  addDerivHessian(der, hessian);
 }
 
 } // namespace CostFunctions
@@ -104,41 +104,104 @@ void BackToBackExponential::function1D(double *out, const double *xValues,
   const double x0 = getParameter(3);
   const double s = getParameter(4);
 
-  // find the reasonable extent of the peak ~100 fwhm
-  double extent = expWidth();
-  if (s > extent)
-    extent = s;
-  extent *= 100;
+  const double extent = this->extent();
 
-  double s2 = s * s;
+  const double s2 = s * s;
+  const double invSqrt2s2 = 1.0 / sqrt(2 * s2);
   double normFactor = a * b / (a + b) / 2;
   // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
   if (normFactor == 0.0)
     normFactor = 1.0;
+  const double factor = I * normFactor;
   for (size_t i = 0; i < nData; i++) {
     double diff = xValues[i] - x0;
     if (fabs(diff) < extent) {
       double val = 0.0;
       double arg1 = a / 2 * (a * s2 + 2 * diff);
-      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) /
-                                        sqrt(2 * s2))); // prevent overflow
+      val += exp(arg1 + gsl_sf_log_erfc((a * s2 + diff) *
+                                        invSqrt2s2)); // prevent overflow
       double arg2 = b / 2 * (b * s2 - 2 * diff);
-      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) /
-                                        sqrt(2 * s2))); // prevent overflow
-      out[i] = I * val * normFactor;
+      val += exp(arg2 + gsl_sf_log_erfc((b * s2 - diff) *
+                                        invSqrt2s2)); // prevent overflow
+      out[i] = factor * val;
     } else
       out[i] = 0.0;
   }
 }
 
 /**
- * Evaluate function derivatives numerically.
+ * Evaluate function derivatives analytically. The derivatives of the two
+ * exponential terms are calculated from the terms themselves and from the
+ * Gaussian exp(-(x-X0)^2/(2*S^2)), which is what is left of the derivative of
+ * the erfc once multiplied by its exponential, so each point needs one exp
+ * more than the value and no extra evaluation of the function.
  */
 void BackToBackExponential::functionDeriv1D(Jacobian *jacobian,
                                             const double *xValues,
                                             const size_t nData) {
-  FunctionDomain1DView domain(xValues, nData);
-  this->calNumericalDeriv(domain, *jacobian);
+  const double I = getParameter(0);
+  const double a = getParameter(1);
+  const double b = getParameter(2);
+  const double x0 = getParameter(3);
+  const double s = getParameter(4);
+
+  const double extent = this->extent();
+
+  const double s2 = s * s;
+  const double invSqrt2s2 = 1.0 / sqrt(2 * s2);
+  const double invTwoS2 = 1.0 / (2 * s2);
+  double normFactor = a * b / (a + b) / 2;
+  // derivatives of the norm factor with respect to A and B
+  double normFactorDerivA = b * b / (2 * (a + b) * (a + b));
+  double normFactorDerivB = a * a / (2 * (a + b) * (a + b));
+  // Needed for IntegratePeaksMD for cylinder profile fitted with b=0
+  if (normFactor == 0.0) {
+    normFactor = 1.0;
+    normFactorDerivA = 0.0;
+    normFactorDerivB = 0.0;
+  }
+  const double factor = I * normFactor;
+  // t / sqrt(2t) for the derivatives of the erfc arguments, with t = S^2
+  const double dzFactor = s2 * invSqrt2s2;
+  const double dzFactorS = s * (a + b) * invSqrt2s2;
+  for (size_t i = 0; i < nData; i++) {
+    double diff = xValues[i] - x0;
+    if (fabs(diff) >= extent) {
+      for (size_t ip = 0; ip < nParams(); ++ip) {
+        jacobian->set(i, ip, 0.0);
+      }
+      continue;
+    }
+    const double e1 =
+        exp(a / 2 * (a * s2 + 2 * diff) +
+            gsl_sf_log_erfc((a * s2 + diff) * invSqrt2s2));
+    const double e2 =
+        exp(b / 2 * (b * s2 - 2 * diff) +
+            gsl_sf_log_erfc((b * s2 - diff) * invSqrt2s2));
+    const double gauss = M_2_SQRTPI * exp(-diff * diff * invTwoS2);
+    const double sum = e1 + e2;
+    jacobian->set(i, 0, normFactor * sum);
+    jacobian->set(i, 1,
+                  I * (normFactorDerivA * sum +
+                       normFactor * ((a * s2 + diff) * e1 - gauss * dzFactor)));
+    jacobian->set(i, 2,
+                  I * (normFactorDerivB * sum +
+                       normFactor * ((b * s2 - diff) * e2 - gauss * dzFactor)));
+    jacobian->set(i, 3, factor * (b * e2 - a * e1));
+    jacobian->set(i, 4,
+                  factor * (s * (a * a * e1 + b * b * e2) - gauss * dzFactorS));
+  }
+}
+
+/**
+ * The values of the peak are only calculated within extent() of its centre,
+ * whatever the peak radius.
+ */
+std::pair<double, double>
+BackToBackExponential::getPeakRadiusInterval(int) const {
+  const double x0 = getParameter(3);
+  const double dx = extent();
+  return std::make_pair(x0 - dx, x0 + dx);
 }
 
 /**
@@ -153,6 +216,18 @@ double BackToBackExponential::expWidth() const {
   return M_LN2 * (a + b) / (a * b);
 }
 
+/**
+ * Find the reasonable extent of the peak ~100 fwhm, outside of which its
+ * values are set to zero.
+ */
+double BackToBackExponential::extent() const {
+  double extent = expWidth();
+  const double s = getParameter(4);
+  if (s > extent)
+    extent = s;
+  return extent * 100;
+}
+
 } // namespace Functions
 } // namespace CurveFitting
 } // namespace Mantid
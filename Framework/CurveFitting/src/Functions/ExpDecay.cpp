@@ -31,23 +31,24 @@ ExpDecay::ExpDecay() {
 void ExpDecay::function1D(double *out, const double *xValues,
                           const size_t nData) const {
   const double h = getParameter("Height");
-  const double t = getParameter("Lifetime");
+  const double minusInvT = -1.0 / getParameter("Lifetime");
 
   for (size_t i = 0; i < nData; i++) {
-    out[i] = h * exp(-(xValues[i]) / t);
+    out[i] = h * exp(xValues[i] * minusInvT);
   }
 }
 
 void ExpDecay::functionDeriv1D(Jacobian *out, const double *xValues,
                                const size_t nData) {
   const double h = getParameter("Height");
-  const double t = getParameter("Lifetime");
+  const double invT = 1.0 / getParameter("Lifetime");
+  const double hInvT2 = h * invT * invT;
 
   for (size_t i = 0; i < nData; i++) {
     double x = xValues[i];
-    double e = exp(-x / t);
+    double e = exp(-x * invT);
     out->set(i, 0, e);
-    out->set(i, 1, h * e * x / t / t);
+    out->set(i, 1, hInvT2 * e * x);
   }
 }
 
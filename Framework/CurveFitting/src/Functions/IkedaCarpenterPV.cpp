@@ -20,6 +20,7 @@
 #include "MantidGeometry/Instrument/ParameterMap.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <algorithm>
 #include <cmath>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_multifit_nlin.h>
@@ -137,20 +138,20 @@ void IkedaCarpenterPV::lowerConstraint0(const std::string &paramName) {
 }
 
 /** Method for updating m_waveLength.
- *  If size of m_waveLength is equal to number of data (for a new instance of
- *this
- *  class this vector is empty initially) then don't recalculate it.
+ *  If m_waveLength was last calculated for the same x values (for a new
+ *  instance of this class it is empty initially) then don't recalculate it.
+ *  The x values are compared, rather than only their number, as a composite
+ *  function calculates its peaks on the points near their centres, which
+ *  move during a fit.
  *
  *  @param xValues :: x values
  *  @param nData :: length of xValues
  */
 void IkedaCarpenterPV::calWavelengthAtEachDataPoint(const double *xValues,
                                                     const size_t &nData) const {
-  // if wavelength vector already have the right size no need for resizing it
-  // further we make the assumption that no need to recalculate this vector if
-  // it already has the right size
-
-  if (m_waveLength.size() != nData) {
+  if (m_waveLengthX.size() != nData ||
+      !std::equal(xValues, xValues + nData, m_waveLengthX.cbegin())) {
+    m_waveLengthX.assign(xValues, xValues + nData);
     m_waveLength.resize(nData);
 
     Mantid::Kernel::Unit_sptr wavelength =
@@ -254,6 +255,11 @@ void IkedaCarpenterPV::constFunction(double *out, const double *xValues,
   // update wavelength vector
   calWavelengthAtEachDataPoint(xValues, nData);
 
+  // the Gaussian and Lorentzian parts are only calculated if they contribute,
+  // the exponential integrals of the Lorentzian part being the most expensive
+  const double gaussianFraction = 1 - eta;
+  const double lorentzianFraction = eta * 2.0 / M_PI;
+
   for (int i = 0; i < nData; i++) {
     double diff = xValues[i] - X0;
 
@@ -271,120 +277,46 @@ void IkedaCarpenterPV::constFunction(double *out, const double *xValues,
     double Ns = -2 * (1 - R * alpha / y);
     double Nr = 2 * R * alpha * alpha * beta * k * k / (x * y * z);
 
-    double u = a_minus * (a_minus * sigmaSquared - 2 * diff) / 2.0;
-    double v = a_plus * (a_plus * sigmaSquared - 2 * diff) / 2.0;
-    double s = alpha * (alpha * sigmaSquared - 2 * diff) / 2.0;
-    double r = beta * (beta * sigmaSquared - 2 * diff) / 2.0;
-
-    double yu = (a_minus * sigmaSquared - diff) * someConst;
-    double yv = (a_plus * sigmaSquared - diff) * someConst;
-    double ys = (alpha * sigmaSquared - diff) * someConst;
-    double yr = (beta * sigmaSquared - diff) * someConst;
-
-    std::complex<double> zs =
-        std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
-    std::complex<double> zu = (1 - k) * zs;
-    std::complex<double> zv = (1 + k) * zs;
-    std::complex<double> zr =
-        std::complex<double>(-beta * diff, 0.5 * beta * gamma);
-
     double N = 0.25 * alpha * (1 - k * k) / (k * k);
 
-    out[i] = I * N *
-             ((1 - eta) * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
-                           Nv * exp(v + gsl_sf_log_erfc(yv)) +
-                           Ns * exp(s + gsl_sf_log_erfc(ys)) +
-                           Nr * exp(r + gsl_sf_log_erfc(yr))) -
-              eta * 2.0 / M_PI *
-                  (Nu * exponentialIntegral(zu).imag() +
-                   Nv * exponentialIntegral(zv).imag() +
-                   Ns * exponentialIntegral(zs).imag() +
-                   Nr * exponentialIntegral(zr).imag()));
+    double value = 0.0;
+    if (gaussianFraction != 0.0) {
+      double u = a_minus * (a_minus * sigmaSquared - 2 * diff) / 2.0;
+      double v = a_plus * (a_plus * sigmaSquared - 2 * diff) / 2.0;
+      double s = alpha * (alpha * sigmaSquared - 2 * diff) / 2.0;
+      double r = beta * (beta * sigmaSquared - 2 * diff) / 2.0;
+
+      double yu = (a_minus * sigmaSquared - diff) * someConst;
+      double yv = (a_plus * sigmaSquared - diff) * someConst;
+      double ys = (alpha * sigmaSquared - diff) * someConst;
+      double yr = (beta * sigmaSquared - diff) * someConst;
+
+      value += gaussianFraction * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
+                                   Nv * exp(v + gsl_sf_log_erfc(yv)) +
+                                   Ns * exp(s + gsl_sf_log_erfc(ys)) +
+                                   Nr * exp(r + gsl_sf_log_erfc(yr)));
+    }
+    if (lorentzianFraction != 0.0) {
+      std::complex<double> zs =
+          std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
+      std::complex<double> zu = (1 - k) * zs;
+      std::complex<double> zv = (1 + k) * zs;
+      std::complex<double> zr =
+          std::complex<double>(-beta * diff, 0.5 * beta * gamma);
+
+      value -= lorentzianFraction * (Nu * exponentialIntegral(zu).imag() +
+                                     Nv * exponentialIntegral(zv).imag() +
+                                     Ns * exponentialIntegral(zs).imag() +
+                                     Nr * exponentialIntegral(zr).imag());
+    }
+
+    out[i] = I * N * value;
   }
 }
 
 void IkedaCarpenterPV::functionLocal(double *out, const double *xValues,
                                      const size_t nData) const {
-  const double I = getParameter("I");
-  const double alpha0 = getParameter("Alpha0");
-  const double alpha1 = getParameter("Alpha1");
-  const double beta0 = getParameter("Beta0");
-  const double kappa = getParameter("Kappa");
-  const double voigtsigmaSquared = getParameter("SigmaSquared");
-  const double voigtgamma = getParameter("Gamma");
-  const double X0 = getParameter("X0");
-
-  // cal pseudo voigt sigmaSq and gamma and eta
-  double gamma = 1.0; // dummy initialization
-  double eta = 0.5;   // dummy initialization
-  convertVoigtToPseudo(voigtsigmaSquared, voigtgamma, gamma, eta);
-  double sigmaSquared = gamma * gamma / (8.0 * M_LN2); // pseudo voigt sigma^2
-
-  const double beta = 1 / beta0;
-
-  // equations taken from Fullprof manual
-
-  const double k = 0.05;
-
-  // Not entirely sure what to do if sigmaSquared ever negative
-  // for now just post a warning
-  double someConst = std::numeric_limits<double>::max() / 100.0;
-  if (sigmaSquared > 0)
-    someConst = 1 / sqrt(2.0 * sigmaSquared);
-  else if (sigmaSquared < 0) {
-    g_log.warning() << "sigmaSquared negative in functionLocal.\n";
-  }
-
-  // update wavelength vector
-  calWavelengthAtEachDataPoint(xValues, nData);
-
-  for (size_t i = 0; i < nData; i++) {
-    double diff = xValues[i] - X0;
-
-    double R = exp(-81.799 / (m_waveLength[i] * m_waveLength[i] * kappa));
-    double alpha = 1.0 / (alpha0 + m_waveLength[i] * alpha1);
-
-    double a_minus = alpha * (1 - k);
-    double a_plus = alpha * (1 + k);
-    double x = a_minus - beta;
-    double y = alpha - beta;
-    double z = a_plus - beta;
-
-    double Nu = 1 - R * a_minus / x;
-    double Nv = 1 - R * a_plus / z;
-    double Ns = -2 * (1 - R * alpha / y);
-    double Nr = 2 * R * alpha * alpha * beta * k * k / (x * y * z);
-
-    double u = a_minus * (a_minus * sigmaSquared - 2 * diff) / 2.0;
-    double v = a_plus * (a_plus * sigmaSquared - 2 * diff) / 2.0;
-    double s = alpha * (alpha * sigmaSquared - 2 * diff) / 2.0;
-    double r = beta * (beta * sigmaSquared - 2 * diff) / 2.0;
-
-    double yu = (a_minus * sigmaSquared - diff) * someConst;
-    double yv = (a_plus * sigmaSquared - diff) * someConst;
-    double ys = (alpha * sigmaSquared - diff) * someConst;
-    double yr = (beta * sigmaSquared - diff) * someConst;
-
-    std::complex<double> zs =
-        std::complex<double>(-alpha * diff, 0.5 * alpha * gamma);
-    std::complex<double> zu = (1 - k) * zs;
-    std::complex<double> zv = (1 + k) * zs;
-    std::complex<double> zr =
-        std::complex<double>(-beta * diff, 0.5 * beta * gamma);
-
-    double N = 0.25 * alpha * (1 - k * k) / (k * k);
-
-    out[i] = I * N *
-             ((1 - eta) * (Nu * exp(u + gsl_sf_log_erfc(yu)) +
-                           Nv * exp(v + gsl_sf_log_erfc(yv)) +
-                           Ns * exp(s + gsl_sf_log_erfc(ys)) +
-                           Nr * exp(r + gsl_sf_log_erfc(yr))) -
-              eta * 2.0 / M_PI *
-                  (Nu * exponentialIntegral(zu).imag() +
-                   Nv * exponentialIntegral(zv).imag() +
-                   Ns * exponentialIntegral(zs).imag() +
-                   Nr * exponentialIntegral(zr).imag()));
-  }
+  constFunction(out, xValues, static_cast<int>(nData));
 }
 
 void IkedaCarpenterPV::functionDerivLocal(API::Jacobian * /*jacobian*/,
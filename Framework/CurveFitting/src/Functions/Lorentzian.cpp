@@ -93,7 +93,6 @@ void Lorentzian::functionDerivLocal(Jacobian *out, const double *xValues,
   const double amplitude = getParameter("Amplitude");
   const double peakCentre = getParameter("PeakCentre");
   const double gamma = getParameter("FWHM");
-  const double halfGamma = 0.5 * gamma;
 
   const double invPI = 1.0 / M_PI;
   for (size_t i = 0; i < nData; i++) {
@@ -102,7 +101,8 @@ void Lorentzian::functionDerivLocal(Jacobian *out, const double *xValues,
     const double dfda = 2.0 * invPI * gamma * invDen1;
     out->set(i, 0, dfda);
 
-    double invDen2 = 1 / (diff * diff + halfGamma * halfGamma);
+    // 1 / (diff^2 + halfGamma^2) without a second division
+    const double invDen2 = 4.0 * invDen1;
     const double dfdxo = amplitude * invPI * gamma * diff * invDen2 * invDen2;
     out->set(i, 1, dfdxo);
 
@@ -154,6 +154,7 @@ void PseudoVoigt::functionDerivLocal(Jacobian *out, const double *xValues,
   const double b_g = cal_bg(gamma);
   const double gamma_div_2 = 0.5 * gamma;
   const double gammasq_div_4 = gamma_div_2 * gamma_div_2;
+  const double inv_gamma = 1. / gamma;
 
   // derivatives
   for (size_t i = 0; i < nData; ++i) {
@@ -174,15 +175,15 @@ void PseudoVoigt::functionDerivLocal(Jacobian *out, const double *xValues,
     // peak center: x0
     const double derive_g_x0 = 2. * b_g * xDiff * gaussian_term;
     const double derive_l_x0 =
-        4. * M_PI * xDiff / gamma * lorentzian_term * lorentzian_term;
+        4. * M_PI * xDiff * inv_gamma * lorentzian_term * lorentzian_term;
     const double deriv_x0 =
         peak_intensity * (gFraction * derive_g_x0 + lFraction * derive_l_x0);
     out->set(i, 2, deriv_x0);
 
     // peak width: gamma or H
-    const double t1 = -1. / gamma * gaussian_term;
-    const double t2 = 2. * b_g * xDiffSquared * gaussian_term / gamma;
-    const double t3 = lorentzian_term / gamma;
+    const double t1 = -inv_gamma * gaussian_term;
+    const double t2 = 2. * b_g * xDiffSquared * gaussian_term * inv_gamma;
+    const double t3 = lorentzian_term * inv_gamma;
     const double t4 = -M_PI * lorentzian_term * lorentzian_term;
     const double derive_gamma =
         peak_intensity * (gFraction * (t1 + t2) + lFraction * (t3 + t4));
@@ -8,8 +8,10 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction.h"
+#include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionFactory.h"
 #include "MantidAPI/MuParserUtils.h"
+#include "MantidCurveFitting/CompiledFormula.h"
 #include "MantidGeometry/muParser_Silent.h"
 #include <boost/tokenizer.hpp>
 
@@ -69,6 +71,7 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_x_set = false;
+  m_compiled.reset();
   clearAllParameters();
 
   try {
@@ -99,6 +102,19 @@ void UserFunction::setAttribute(const std::string &attName,
   }
 
   m_parser->SetExpr(m_formula);
+
+  // Formulas made of arithmetic and the common functions are calculated in
+  // blocks of points with analytic derivatives, the others by m_parser
+  std::vector<std::string> names;
+  names.reserve(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    names.emplace_back(parameterName(i));
+  }
+  try {
+    m_compiled = std::make_unique<CompiledFormula>(m_formula, names);
+  } catch (std::invalid_argument &) {
+    m_compiled.reset();
+  }
 }
 
 /** Calculate the fitting function.
@@ -110,6 +126,11 @@ void UserFunction::setAttribute(const std::string &attName,
  */
 void UserFunction::function1D(double *out, const double *xValues,
                               const size_t nData) const {
+  if (m_compiled) {
+    const auto parameters = parameterValues();
+    m_compiled->evaluate(xValues, nData, parameters.data(), out);
+    return;
+  }
   for (size_t i = 0; i < nData; i++) {
     m_x = xValues[i];
     try {
@@ -127,7 +148,27 @@ void UserFunction::function1D(double *out, const double *xValues,
  */
 void UserFunction::functionDeriv(const API::FunctionDomain &domain,
                                  API::Jacobian &jacobian) {
-  calNumericalDeriv(domain, jacobian);
+  const auto *domain1D = dynamic_cast<const FunctionDomain1D *>(&domain);
+  if (!m_compiled || !domain1D) {
+    calNumericalDeriv(domain, jacobian);
+    return;
+  }
+  std::vector<bool> active(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    active[i] = isActive(i);
+  }
+  const auto parameters = parameterValues();
+  m_compiled->evaluateDerivatives(domain1D->getPointerAt(0), domain1D->size(),
+                                  parameters.data(), active, jacobian);
+}
+
+/// @return the values of the parameters in the order of their declaration
+std::vector<double> UserFunction::parameterValues() const {
+  std::vector<double> parameters(nParams());
+  for (size_t i = 0; i < nParams(); i++) {
+    parameters[i] = getParameter(i);
+  }
+  return parameters;
 }
 
 } // namespace Functions
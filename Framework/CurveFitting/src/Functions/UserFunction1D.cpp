@@ -8,6 +8,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidCurveFitting/Functions/UserFunction1D.h"
+#include "MantidCurveFitting/CompiledFormula.h"
 #include "MantidKernel/MandatoryValidator.h"
 #include "MantidKernel/StringTokenizer.h"
 #include "MantidKernel/UnitFactory.h"
@@ -25,6 +26,8 @@ using namespace Kernel;
 
 using namespace API;
 
+UserFunction1D::~UserFunction1D() = default;
+
 /** Static callback function used by MuParser to initialize variables implicitly
  *  @param varName :: The name of a new variable
  *  @param palg :: Pointer to the algorithm
@@ -69,6 +72,14 @@ void UserFunction1D::prepare() {
   if (!m_x_set)
     throw std::runtime_error("Formula does not contain the x variable");
 
+  // Formulas made of arithmetic and the common functions are calculated in
+  // blocks of points with analytic derivatives, the others by m_parser
+  try {
+    m_compiled = std::make_unique<CompiledFormula>(funct, m_parameterNames);
+  } catch (std::invalid_argument &) {
+    m_compiled.reset();
+  }
+
   // Set the initial values to the fit parameters
   std::string initParams = getProperty("InitialParameters");
   if (!initParams.empty()) {
@@ -115,6 +126,10 @@ void UserFunction1D::prepare() {
  */
 void UserFunction1D::function(const double *in, double *out,
                               const double *xValues, const size_t nData) {
+  if (m_compiled) {
+    m_compiled->evaluate(xValues, nData, in, out);
+    return;
+  }
   for (size_t i = 0; i < static_cast<size_t>(m_nPars); i++)
     m_parameters[i] = in[i];
 
@@ -135,6 +150,11 @@ void UserFunction1D::functionDeriv(const double *in, Jacobian *out,
   // throw Exception::NotImplementedError("No derivative function provided");
   if (nData == 0)
     return;
+  if (m_compiled) {
+    const std::vector<bool> active(static_cast<size_t>(m_nPars), true);
+    m_compiled->evaluateDerivatives(xValues, nData, in, active, *out);
+    return;
+  }
   std::vector<double> dp(m_nPars);
   std::vector<double> in1(m_nPars);
   for (int i = 0; i < m_nPars; i++) {
@@ -0,0 +1,120 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidCurveFitting/Jacobian.h"
+#include "MantidAPI/IFunction.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace CurveFitting {
+
+namespace {
+/// Number of data points in the blocks of rows multiplied together by
+/// Jacobian::calculateProducts
+constexpr size_t JACOBIAN_BLOCK_SIZE = 1024;
+using RowMajorMatrix =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+} // namespace
+
+/**
+ * Calculate the sums over the data points that make the derivatives and the
+ * Hessian of the cost functions: for the active parameters i and j of the
+ * function
+ *   der(i) = sum_k J(k,i) * derivFactors[k]
+ *   hessian(i,j) = sum_k J(k,i) * J(k,j) * hessianFactors[k]^2
+ * Only the lower triangle of the Hessian is calculated. The Jacobian is
+ * multiplied in blocks of rows; outside a parallel region the blocks are
+ * shared out to threads that sum into their own matrices, which are added
+ * together at the end.
+ * @param function :: The function the Jacobian was calculated for
+ * @param derivFactors :: Factor of each data point in the derivatives. If
+ * empty the derivatives are not calculated.
+ * @param der :: Output derivatives of the active parameters
+ * @param hessianFactors :: Factor of each data point in the Hessian, squared.
+ * If empty the Hessian is not calculated.
+ * @param hessian :: Output Hessian of the active parameters
+ */
+void Jacobian::calculateProducts(const API::IFunction &function,
+                                 const std::vector<double> &derivFactors,
+                                 Eigen::VectorXd &der,
+                                 const std::vector<double> &hessianFactors,
+                                 Eigen::MatrixXd &hessian) const {
+  std::vector<Eigen::DenseIndex> active;
+  for (size_t ip = 0; ip < m_np; ++ip) {
+    if (function.isActive(ip))
+      active.emplace_back(static_cast<Eigen::DenseIndex>(ip));
+  }
+  const auto nActive = static_cast<Eigen::DenseIndex>(active.size());
+  const bool evalDeriv = !derivFactors.empty();
+  const bool evalHessian = !hessianFactors.empty();
+  if (evalDeriv)
+    der.setZero(nActive);
+  if (evalHessian)
+    hessian.setZero(nActive, nActive);
+  if (nActive == 0 || m_ny == 0)
+    return;
+
+  const auto nBlocks =
+      static_cast<int>((m_ny + JACOBIAN_BLOCK_SIZE - 1) / JACOBIAN_BLOCK_SIZE);
+  // The domains of a ParDomain are already run in parallel
+  int nThreads = 1;
+  if (PARALLEL_NUMBER_OF_THREADS == 1) {
+    PARALLEL_SET_CONFIG_THREADS
+    nThreads = std::min(PARALLEL_GET_MAX_THREADS, nBlocks);
+  }
+  std::vector<Eigen::VectorXd> threadDer(nThreads);
+  std::vector<Eigen::MatrixXd> threadHessian(nThreads);
+
+  PRAGMA_OMP(parallel num_threads(nThreads))
+  {
+    const auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+    auto &localDer = threadDer[thread];
+    auto &localHessian = threadHessian[thread];
+    if (evalDeriv)
+      localDer.setZero(nActive);
+    if (evalHessian)
+      localHessian.setZero(nActive, nActive);
+    RowMajorMatrix columns;
+
+    PRAGMA_OMP(for schedule(static))
+    for (int block = 0; block < nBlocks; ++block) {
+      const size_t begin = static_cast<size_t>(block) * JACOBIAN_BLOCK_SIZE;
+      const auto rows = static_cast<Eigen::DenseIndex>(
+          std::min(JACOBIAN_BLOCK_SIZE, m_ny - begin));
+      // Copy the columns of the active parameters
+      columns.resize(rows, nActive);
+      const double *row = m_data.data() + begin * m_np;
+      for (Eigen::DenseIndex k = 0; k < rows; ++k, row += m_np) {
+        for (Eigen::DenseIndex i = 0; i < nActive; ++i)
+          columns(k, i) = row[active[i]];
+      }
+      if (evalDeriv) {
+        Eigen::Map<const Eigen::VectorXd> factors(derivFactors.data() + begin,
+                                                  rows);
+        localDer.noalias() += columns.transpose() * factors;
+      }
+      if (evalHessian) {
+        Eigen::Map<const Eigen::VectorXd> factors(
+            hessianFactors.data() + begin, rows);
+        columns = factors.asDiagonal() * columns;
+        localHessian.selfadjointView<Eigen::Lower>().rankUpdate(
+            columns.transpose());
+      }
+    }
+  }
+
+  for (int thread = 0; thread < nThreads; ++thread) {
+    if (evalDeriv)
+      der += threadDer[thread];
+    if (evalHessian)
+      hessian.triangularView<Eigen::Lower>() += threadHessian[thread];
+  }
+}
+
+} // namespace CurveFitting
+} // namespace Mantid
@@ -226,6 +226,29 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void test_parallel_fits_match_the_serial_fits() {
+    createData();
+    for (const std::string fitType : {"Sequential", "Individual"}) {
+      auto serial = runGroupFit(fitType, false);
+      auto parallel = runGroupFit(fitType, true);
+      TS_ASSERT_EQUALS(parallel->rowCount(), 3);
+      TS_ASSERT_EQUALS(parallel->columnCount(), serial->columnCount());
+      // The rows are in the order of the input
+      for (size_t row = 0; row < 3; ++row) {
+        TS_ASSERT_DELTA(parallel->Double(row, 0), 1 + 0.3 * double(row),
+                        1e-10);
+        for (size_t col = 1; col < 11; col += 2)
+          TS_ASSERT_DELTA(parallel->Double(row, col),
+                          serial->Double(row, col), 1e-6);
+      }
+      auto fits = AnalysisDataService::Instance().retrieveWS<WorkspaceGroup>(
+          "PlotPeakResult_Workspaces");
+      TS_ASSERT_EQUALS(fits->getNumberOfEntries(), 3);
+    }
+    deleteData();
+    AnalysisDataService::Instance().clear();
+  }
+
   void testWorkspaceList_plotting_against_ws_names() {
     createData();
 
@@ -595,6 +618,25 @@ public:
 private:
   WorkspaceGroup_sptr m_wsg;
 
+  ITableWorkspace_sptr runGroupFit(const std::string &fitType,
+                                   const bool parallel) {
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input", "PlotPeakGroup");
+    alg.setPropertyValue("OutputWorkspace", "PlotPeakResult");
+    alg.setPropertyValue("WorkspaceIndex", "1");
+    alg.setPropertyValue("LogValue", "var");
+    alg.setPropertyValue("FitType", fitType);
+    alg.setProperty("CreateOutput", true);
+    alg.setProperty("Parallel", parallel);
+    alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;name="
+                                     "Gaussian,PeakCentre=5,Height=2,Sigma=0."
+                                     "1");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+    return alg.getProperty("OutputWorkspace");
+  }
+
   void createData(bool hist = false) {
     m_wsg.reset(new WorkspaceGroup);
     AnalysisDataService::Instance().add("PlotPeakGroup", m_wsg);
@@ -0,0 +1,227 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Jacobian.h"
+#include "MantidCurveFitting/CompiledFormula.h"
+
+#include <cmath>
+#include <cxxtest/TestSuite.h>
+#include <stdexcept>
+#include <vector>
+
+using Mantid::CurveFitting::CompiledFormula;
+
+class CompiledFormulaTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledFormulaTest *createSuite() {
+    return new CompiledFormulaTest();
+  }
+  static void destroySuite(CompiledFormulaTest *suite) { delete suite; }
+
+  void test_values() {
+    CompiledFormula formula("h*sin(a*x-c) + exp(-x)/a - x^2 + sqrt(x)*_pi",
+                            {"h", "a", "c"});
+    TS_ASSERT_EQUALS(formula.nParams(), 3);
+    const std::vector<double> parameters{2.2, 2.0, 1.2};
+    const auto x = xValues(600);
+    std::vector<double> y(x.size());
+    formula.evaluate(x.data(), x.size(), parameters.data(), y.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double expected = 2.2 * sin(2.0 * x[i] - 1.2) + exp(-x[i]) / 2.0 -
+                              x[i] * x[i] + sqrt(x[i]) * M_PI;
+      TS_ASSERT_DELTA(y[i], expected, 1e-12);
+    }
+  }
+
+  void test_functions() {
+    CompiledFormula formula("ln(x)+log10(x)+log2(x)+cos(x)+tan(x)+asin(x/10)+"
+                            "acos(x/10)+atan(x)+sinh(x)+cosh(x)+tanh(x)+"
+                            "abs(x-1)+erf(x)+erfc(x)",
+                            {});
+    const auto x = xValues(10);
+    std::vector<double> y(x.size());
+    formula.evaluate(x.data(), x.size(), nullptr, y.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double v = x[i];
+      const double expected = log(v) + log10(v) + log2(v) + cos(v) + tan(v) +
+                              asin(v / 10) + acos(v / 10) + atan(v) + sinh(v) +
+                              cosh(v) + tanh(v) + fabs(v - 1) + erf(v) +
+                              erfc(v);
+      TS_ASSERT_DELTA(y[i], expected, 1e-12);
+    }
+  }
+
+  void test_derivatives() {
+    CompiledFormula formula("h*sin(a*x-c) + b^2 + x^b", {"h", "a", "c", "b"});
+    const std::vector<double> parameters{2.2, 2.0, 1.2, 1.5};
+    const auto x = xValues(600);
+    TestJacobian jacobian(x.size(), 4);
+    formula.evaluateDerivatives(x.data(), x.size(), parameters.data(),
+                                {true, true, true, true}, jacobian);
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double arg = 2.0 * x[i] - 1.2;
+      TS_ASSERT_DELTA(jacobian.get(i, 0), sin(arg), 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 1), 2.2 * cos(arg) * x[i], 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 2), -2.2 * cos(arg), 1e-12);
+      TS_ASSERT_DELTA(jacobian.get(i, 3),
+                      2.0 * 1.5 + pow(x[i], 1.5) * log(x[i]), 1e-12);
+    }
+  }
+
+  void test_derivatives_of_the_functions_match_numerical_ones() {
+    CompiledFormula formula("a*exp(-b*x)/sqrt(b) + ln(a+x)*tanh(b*x) + "
+                            "erf(a*x)*abs(b-x) + atan(a/b) + cosh(b*x/10)",
+                            {"a", "b"});
+    const std::vector<double> parameters{1.3, 0.7};
+    const auto x = xValues(100);
+    TestJacobian jacobian(x.size(), 2);
+    formula.evaluateDerivatives(x.data(), x.size(), parameters.data(),
+                                {true, true}, jacobian);
+    const double step = 1e-6;
+    for (size_t ip = 0; ip < 2; ++ip) {
+      auto shifted = parameters;
+      shifted[ip] += step;
+      std::vector<double> y1(x.size()), y0(x.size());
+      formula.evaluate(x.data(), x.size(), shifted.data(), y1.data());
+      shifted[ip] -= 2 * step;
+      formula.evaluate(x.data(), x.size(), shifted.data(), y0.data());
+      for (size_t i = 0; i < x.size(); ++i) {
+        const double numerical = (y1[i] - y0[i]) / (2 * step);
+        TS_ASSERT_DELTA(jacobian.get(i, ip), numerical,
+                        1e-6 * (1 + fabs(numerical)));
+      }
+    }
+  }
+
+  void test_inactive_parameters_are_left_unchanged() {
+    CompiledFormula formula("a*x+b", {"a", "b", "c"});
+    const std::vector<double> parameters{2.0, 3.0, 4.0};
+    const auto x = xValues(10);
+    TestJacobian jacobian(x.size(), 3);
+    jacobian.fill(-1.0);
+    formula.evaluateDerivatives(x.data(), x.size(), parameters.data(),
+                                {false, true, true}, jacobian);
+    for (size_t i = 0; i < x.size(); ++i) {
+      TS_ASSERT_EQUALS(jacobian.get(i, 0), -1.0);
+      TS_ASSERT_EQUALS(jacobian.get(i, 1), 1.0);
+      // the formula does not depend on c
+      TS_ASSERT_EQUALS(jacobian.get(i, 2), 0.0);
+    }
+  }
+
+  void test_constants_and_numbers() {
+    CompiledFormula formula("2*3 + 1.5e-1*a - .5/_e + exp(1)", {"a"});
+    const std::vector<double> parameters{2.0};
+    const std::vector<double> x{1.0, 2.0};
+    std::vector<double> y(x.size());
+    formula.evaluate(x.data(), x.size(), parameters.data(), y.data());
+    const double expected = 6.0 + 0.3 - 0.5 / M_E + M_E;
+    TS_ASSERT_DELTA(y[0], expected, 1e-12);
+    TS_ASSERT_DELTA(y[1], expected, 1e-12);
+
+    TestJacobian jacobian(x.size(), 1);
+    formula.evaluateDerivatives(x.data(), x.size(), parameters.data(), {true},
+                                jacobian);
+    TS_ASSERT_DELTA(jacobian.get(0, 0), 0.15, 1e-15);
+    TS_ASSERT_DELTA(jacobian.get(1, 0), 0.15, 1e-15);
+  }
+
+  void test_a_sign_before_a_power_is_applied_after_it() {
+    // as in mu::Parser, -a^b is -(a^b)
+    const std::vector<std::string> formulas{"-x^2", "(-x)^2", "a*-x^2",
+                                            "-(-x)^2", "( -x)^3", "-a^2+x"};
+    const std::vector<double> parameters{2.0};
+    const auto x = xValues(10);
+    std::vector<std::vector<double>> y(formulas.size(),
+                                       std::vector<double>(x.size()));
+    for (size_t i = 0; i < formulas.size(); ++i) {
+      CompiledFormula formula(formulas[i], {"a"});
+      formula.evaluate(x.data(), x.size(), parameters.data(), y[i].data());
+    }
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double v = x[i];
+      TS_ASSERT_EQUALS(y[0][i], -v * v);
+      TS_ASSERT_EQUALS(y[1][i], v * v);
+      TS_ASSERT_EQUALS(y[2][i], -2.0 * v * v);
+      TS_ASSERT_EQUALS(y[3][i], -v * v);
+      TS_ASSERT_DELTA(y[4][i], -v * v * v, 1e-15);
+      TS_ASSERT_EQUALS(y[5][i], -4.0 + v);
+    }
+  }
+
+  void test_common_peak_and_background_formulas_compile() {
+    const std::vector<std::string> names{"h", "c", "s", "b"};
+    TS_ASSERT_THROWS_NOTHING(CompiledFormula("h*exp(-(x-c)^2/(2*s^2))", names));
+    TS_ASSERT_THROWS_NOTHING(CompiledFormula("h*exp(-0.5*((x-c)/s)^2)", names));
+    TS_ASSERT_THROWS_NOTHING(CompiledFormula("h*s^2/((x-c)^2+s^2)", names));
+    TS_ASSERT_THROWS_NOTHING(CompiledFormula("h*exp(-x/s)+b", names));
+    TS_ASSERT_THROWS_NOTHING(CompiledFormula("b+c*x+h*x^2", names));
+
+    CompiledFormula gaussian("h*exp(-(x-c)^2/(2*s^2))", names);
+    const std::vector<double> parameters{2.0, 0.5, 1.5, 0.0};
+    const auto x = xValues(100);
+    std::vector<double> y(x.size());
+    gaussian.evaluate(x.data(), x.size(), parameters.data(), y.data());
+    for (size_t i = 0; i < x.size(); ++i) {
+      const double d = x[i] - 0.5;
+      TS_ASSERT_DELTA(y[i], 2.0 * exp(-d * d / (2 * 1.5 * 1.5)), 1e-12);
+    }
+  }
+
+  void test_unsupported_formulas_throw() {
+    const std::vector<std::string> names{"a"};
+    // unknown names and functions
+    TS_ASSERT_THROWS(CompiledFormula("b*x", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("rint(x)", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("atan(x,a)", names),
+                     const std::invalid_argument &);
+    // ambiguous in mu::Parser
+    TS_ASSERT_THROWS(CompiledFormula("log(x)", names),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompiledFormula("x^2^a", names),
+                     const std::invalid_argument &);
+    // comparisons and conditions
+    TS_ASSERT_THROWS(CompiledFormula("x>a?1:0", names),
+                     const std::invalid_argument &);
+    // syntax errors
+    TS_ASSERT_THROWS(CompiledFormula("a*(x", names),
+                     const std::invalid_argument &);
+  }
+
+private:
+  class TestJacobian : public Mantid::API::Jacobian {
+  public:
+    TestJacobian(size_t nData, size_t nParams)
+        : m_nParams(nParams), m_buffer(nData * nParams) {}
+    void set(size_t iY, size_t iP, double value) override {
+      m_buffer[iY * m_nParams + iP] = value;
+    }
+    double get(size_t iY, size_t iP) override {
+      return m_buffer[iY * m_nParams + iP];
+    }
+    void zero() override { fill(0.0); }
+    void fill(double value) { m_buffer.assign(m_buffer.size(), value); }
+
+  private:
+    size_t m_nParams;
+    std::vector<double> m_buffer;
+  };
+
+  /// x values spanning more than one block of the formula
+  static std::vector<double> xValues(size_t n) {
+    std::vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = 0.1 + 0.01 * static_cast<double>(i);
+    }
+    return x;
+  }
+};
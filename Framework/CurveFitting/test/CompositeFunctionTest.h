@@ -25,11 +25,14 @@
 #include "MantidCurveFitting/FuncMinimizers/LevenbergMarquardtMDMinimizer.h"
 #include "MantidCurveFitting/FuncMinimizers/SimplexMinimizer.h"
 #include "MantidCurveFitting/Functions/ExpDecay.h"
+#include "MantidCurveFitting/Functions/IkedaCarpenterPV.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 #include "MantidCurveFitting/GSLJacobian.h"
 
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
+#include <algorithm>
+
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 using namespace Mantid::CurveFitting;
@@ -435,6 +438,94 @@ public:
     TS_ASSERT_EQUALS(s.getError(), "success");
   }
 
+  void test_peaks_are_calculated_within_the_peak_radius() {
+    auto composite = makePeaksComposite();
+    FunctionDomain1DVector domain(0.0, 20.0, 201);
+    domain.setPeakRadius(3);
+
+    FunctionValues values(domain);
+    composite->function(domain, values);
+
+    // Each peak limits itself to the peak radius over the whole domain
+    FunctionValues expected(domain), tmp(domain);
+    expected.zeroCalculated();
+    for (size_t i = 0; i < composite->nFunctions(); ++i) {
+      composite->getFunction(i)->function(domain, tmp);
+      expected += tmp;
+    }
+    for (size_t i = 0; i < domain.size(); ++i) {
+      TS_ASSERT_DELTA(values.getCalculated(i), expected.getCalculated(i),
+                      1e-12);
+    }
+    // Outside all the peaks only the background is left
+    TS_ASSERT_DELTA(values.getCalculated(0), 1.0, 1e-12);
+    TS_ASSERT_DELTA(values.getCalculated(80), 1.0 + 0.1 * 8.0, 1e-12);
+  }
+
+  void test_peak_derivatives_are_calculated_within_the_peak_radius() {
+    auto composite = makePeaksComposite();
+    FunctionDomain1DVector domain(0.0, 20.0, 201);
+    domain.setPeakRadius(3);
+    const size_t np = composite->nParams();
+
+    // Derivatives outside the peak radius must be zeroed
+    GSLJacobian jacobian(*composite, domain.size());
+    for (size_t i = 0; i < domain.size(); ++i) {
+      for (size_t j = 0; j < np; ++j) {
+        jacobian.set(i, j, 7.0);
+      }
+    }
+    composite->functionDeriv(domain, jacobian);
+
+    GSLJacobian expected(*composite, domain.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < composite->nFunctions(); ++i) {
+      auto fun = composite->getFunction(i);
+      PartialJacobian J(&expected, offset);
+      fun->functionDeriv(domain, J);
+      offset += fun->nParams();
+    }
+    for (size_t i = 0; i < domain.size(); ++i) {
+      for (size_t j = 0; j < np; ++j) {
+        TS_ASSERT_DELTA(jacobian.get(i, j), expected.get(i, j), 1e-12);
+      }
+    }
+  }
+
+  void test_peak_moved_to_a_window_of_the_same_size() {
+    auto peak = std::make_shared<IkedaCarpenterPV>();
+    peak->initialize();
+    peak->setParameter("I", 3101.672);
+    peak->setParameter("SigmaSquared", 99.935);
+    peak->setParameter("Gamma", 0.0);
+    peak->setParameter("X0", 80.0);
+    CompositeFunction composite;
+    composite.addFunction(peak);
+    FunctionDomain1DVector domain(0.0, 200.0, 201);
+    domain.setPeakRadius(3);
+    const auto first = windowSize(*peak, domain);
+
+    FunctionValues values(domain);
+    composite.function(domain, values);
+    peak->setParameter("X0", 120.0);
+    TS_ASSERT_EQUALS(windowSize(*peak, domain), first);
+    composite.function(domain, values);
+
+    // The peak must not reuse what it calculated for the first window
+    auto fresh = std::make_shared<IkedaCarpenterPV>();
+    fresh->initialize();
+    for (size_t i = 0; i < peak->nParams(); ++i) {
+      fresh->setParameter(i, peak->getParameter(i));
+    }
+    CompositeFunction expectedComposite;
+    expectedComposite.addFunction(fresh);
+    FunctionValues expected(domain);
+    expectedComposite.function(domain, expected);
+    for (size_t i = 0; i < domain.size(); ++i) {
+      TS_ASSERT_EQUALS(values.getCalculated(i), expected.getCalculated(i));
+    }
+  }
+
   void test_constraints_str() {
     auto fun = FunctionFactory::Instance().createInitialized(
         "name=Gaussian,constraints=(Height>0)");
@@ -515,4 +606,39 @@ public:
                                       "LinearBackground,A0=0,A1=0,ties=(A0=A1);"
                                       "ties=(f0.Sigma=f1.A1)");
   }
+
+private:
+  /// Background and three peaks, two of them in an inner composite
+  CompositeFunction_sptr makePeaksComposite() {
+    auto composite = std::make_shared<CompositeFunction>();
+    auto linear = std::make_shared<CurveFittingLinear>();
+    linear->setParameter("a", 1.0);
+    linear->setParameter("b", 0.1);
+    composite->addFunction(linear);
+    composite->addFunction(makePeak(5.0, 2.0, 1.0));
+    auto inner = std::make_shared<CompositeFunction>();
+    inner->addFunction(makePeak(12.0, 1.0, 0.5));
+    inner->addFunction(makePeak(17.0, 3.0, 2.0));
+    composite->addFunction(inner);
+    return composite;
+  }
+
+  /// Number of points of the domain within the peak radius of a peak
+  size_t windowSize(const IPeakFunction &peak,
+                    const FunctionDomain1D &domain) {
+    const auto interval = peak.getPeakRadiusInterval(domain.getPeakRadius());
+    const double *begin = domain.getPointerAt(0);
+    const double *end = begin + domain.size();
+    const double *first = std::upper_bound(begin, end, interval.first);
+    return static_cast<size_t>(std::lower_bound(first, end, interval.second) -
+                               first);
+  }
+
+  IFunction_sptr makePeak(double c, double h, double s) {
+    auto peak = std::make_shared<CurveFittingGauss>();
+    peak->setParameter("c", c);
+    peak->setParameter("h", h);
+    peak->setParameter("s", s);
+    return peak;
+  }
 };
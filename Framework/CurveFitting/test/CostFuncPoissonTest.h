@@ -289,6 +289,31 @@ public:
     }
   }
 
+  void test_hessian_with_negative_bin_contents() {
+    FunctionDomain_sptr domain = getFakeDomain(1, 3);
+    FunctionValues_sptr vals = getFakeValues({1, -2, 3}, *domain);
+
+    auto mockFunction = std::make_shared<UserFunction>();
+    mockFunction->setAttributeValue("Formula", "x + a + b");
+    mockFunction->setParameter("a", 1);
+    mockFunction->setParameter("b", 100);
+
+    CostFuncPoisson testInstance;
+    testInstance.setFittingFunction(mockFunction, domain, vals);
+    testInstance.addValDerivHessian(mockFunction, domain, vals);
+
+    const auto returnedHessian = testInstance.getHessian();
+    const auto firstRow = returnedHessian.copyRow(0);
+
+    // The function is linear, so only the products of the first derivatives
+    // contribute: the sum of count / fitted^2
+    const double expectedVal =
+        1.0 / (102.0 * 102.0) - 2.0 / (103.0 * 103.0) + 3.0 / (104.0 * 104.0);
+    for (size_t i = 0; i < firstRow.size(); i++) {
+      TS_ASSERT_DELTA(firstRow[i], expectedVal, 1e-7);
+    }
+  }
+
   void test_hessian_below_cutoff() {
     FunctionDomain_sptr domain = getFakeDomain(-1, 1);
     FunctionValues_sptr vals = getFakeValues({1, 2, 3}, *domain);
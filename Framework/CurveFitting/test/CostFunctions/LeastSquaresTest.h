@@ -209,6 +209,56 @@ public:
     TS_ASSERT_DELTA(L, -0.145, 1e-10); // L + costFun->val() == 0
   }
 
+  void test_derivatives_and_hessian_on_many_points() {
+    // More points than in a block of the Jacobian products
+    const size_t n = 2500;
+    std::vector<double> x(n), y(n), w(n);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = 0.001 * double(i);
+      y[i] = 2.0 * x[i] * x[i] - x[i] + 0.5 + 0.01 * double(i % 7);
+      w[i] = 1.0 + 0.1 * double(i % 3);
+    }
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(x));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(w);
+
+    auto fun = std::make_shared<UserFunction>();
+    fun->setAttributeValue("Formula", "a*x*x+b*x+c");
+    fun->setParameter("a", 1.9);
+    fun->setParameter("b", -1.0);
+    fun->setParameter("c", 0.6);
+    fun->fix(1);
+
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    costFun->valDerivHessian();
+    const GSLVector &g = costFun->getDeriv();
+    const GSLMatrix &H = costFun->getHessian();
+    TS_ASSERT_EQUALS(g.size(), 2);
+
+    // Derivatives of the function by the active parameters a and c
+    double val = 0.0, ga = 0.0, gc = 0.0, haa = 0.0, hac = 0.0, hcc = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      const double da = x[i] * x[i];
+      const double r = 1.9 * da - x[i] + 0.6 - y[i];
+      const double w2 = w[i] * w[i];
+      val += 0.5 * r * r * w2;
+      ga += da * r * w2;
+      gc += r * w2;
+      haa += da * da * w2;
+      hac += da * w2;
+      hcc += w2;
+    }
+    TS_ASSERT_DELTA(costFun->val(), val, 1e-6 * val);
+    TS_ASSERT_DELTA(g.get(0), ga, 1e-6 * std::abs(ga));
+    TS_ASSERT_DELTA(g.get(1), gc, 1e-6 * std::abs(gc));
+    TS_ASSERT_DELTA(H.get(0, 0), haa, 1e-6 * haa);
+    TS_ASSERT_DELTA(H.get(1, 0), hac, 1e-6 * hac);
+    TS_ASSERT_DELTA(H.get(0, 1), hac, 1e-6 * hac);
+    TS_ASSERT_DELTA(H.get(1, 1), hcc, 1e-6 * hcc);
+  }
+
   void test_Fixing_parameter() {
     std::vector<double> x(10), y(10);
     for (size_t i = 0; i < x.size(); ++i) {
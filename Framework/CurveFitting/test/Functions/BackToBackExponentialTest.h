@@ -11,6 +11,7 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <cmath>
 
@@ -190,4 +191,62 @@ public:
     TS_ASSERT_EQUALS(b2bExp.intensity(), 3.0);
     TS_ASSERT_EQUALS(b2bExp.getParameter("I"), 3.0);
   }
+
+  void test_derivatives_match_numerical_derivatives() {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 3.0);
+    b2bExp.setParameter("A", 1.5);
+    b2bExp.setParameter("B", 0.2);
+    b2bExp.setParameter("X0", 1.0);
+    b2bExp.setParameter("S", 0.7);
+
+    Mantid::API::FunctionDomain1DVector x(-4, 6, 51);
+    Mantid::CurveFitting::Jacobian jacobian(x.size(), 5);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 5);
+    b2bExp.functionDeriv(x, jacobian);
+    b2bExp.calNumericalDeriv(x, numerical);
+
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        const double expected = numerical.get(i, j);
+        TS_ASSERT_DELTA(jacobian.get(i, j), expected,
+                        2e-3 * (1.0 + fabs(expected)));
+      }
+    }
+  }
+};
+
+class BackToBackExponentialTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BackToBackExponentialTestPerformance *createSuite() {
+    return new BackToBackExponentialTestPerformance();
+  }
+  static void destroySuite(BackToBackExponentialTestPerformance *suite) {
+    delete suite;
+  }
+
+  BackToBackExponentialTestPerformance()
+      : m_domain(-50.0, 50.0, NPOINTS), m_values(m_domain),
+        m_jacobian(NPOINTS, 5) {
+    m_b2bExp.initialize();
+    m_b2bExp.setParameter("I", 3.0);
+    m_b2bExp.setParameter("A", 1.5);
+    m_b2bExp.setParameter("B", 0.2);
+    m_b2bExp.setParameter("X0", 1.0);
+    m_b2bExp.setParameter("S", 0.7);
+  }
+
+  void test_function() { m_b2bExp.function(m_domain, m_values); }
+
+  void test_functionDeriv() { m_b2bExp.functionDeriv(m_domain, m_jacobian); }
+
+private:
+  static constexpr size_t NPOINTS = 1000000;
+  BackToBackExponential m_b2bExp;
+  Mantid::API::FunctionDomain1DVector m_domain;
+  Mantid::API::FunctionValues m_values;
+  Mantid::CurveFitting::Jacobian m_jacobian;
 };
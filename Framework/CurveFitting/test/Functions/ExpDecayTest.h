@@ -8,7 +8,10 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/ExpDecay.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 using namespace Mantid::CurveFitting::Functions;
 
@@ -49,3 +52,32 @@ public:
     TS_ASSERT_DELTA(y[9], 2.56709, 1e-4);
   }
 };
+
+class ExpDecayTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ExpDecayTestPerformance *createSuite() {
+    return new ExpDecayTestPerformance();
+  }
+  static void destroySuite(ExpDecayTestPerformance *suite) { delete suite; }
+
+  ExpDecayTestPerformance()
+      : m_domain(0.0, 20.0, NPOINTS), m_values(m_domain),
+        m_jacobian(NPOINTS, 2) {
+    m_fn.initialize();
+    m_fn.setParameter("Height", 5.0);
+    m_fn.setParameter("Lifetime", 3.0);
+  }
+
+  void test_function() { m_fn.function(m_domain, m_values); }
+
+  void test_functionDeriv() { m_fn.functionDeriv(m_domain, m_jacobian); }
+
+private:
+  static constexpr size_t NPOINTS = 1000000;
+  ExpDecay m_fn;
+  Mantid::API::FunctionDomain1DVector m_domain;
+  Mantid::API::FunctionValues m_values;
+  Mantid::CurveFitting::Jacobian m_jacobian;
+};
@@ -75,4 +75,76 @@ public:
     fn.setParameter("X0", 0);
     TS_ASSERT_DELTA(fn.intensity(), 810.7256, 1e-4);
   }
+
+  void test_values_on_shifted_domain_of_same_size() {
+    IkedaCarpenterPV fn;
+    fn.initialize();
+    setParameters(fn);
+
+    Mantid::API::FunctionDomain1DVector x(0, 75, 16);
+    Mantid::API::FunctionValues y(x);
+    fn.function(x, y);
+
+    // the wavelengths must be updated although the size is the same
+    Mantid::API::FunctionDomain1DVector shifted(40, 115, 16);
+    Mantid::API::FunctionValues yShifted(shifted);
+    fn.function(shifted, yShifted);
+
+    IkedaCarpenterPV fresh;
+    fresh.initialize();
+    setParameters(fresh);
+    Mantid::API::FunctionValues expected(shifted);
+    fresh.function(shifted, expected);
+    for (size_t i = 0; i < shifted.size(); ++i) {
+      TS_ASSERT_EQUALS(yShifted[i], expected[i]);
+    }
+  }
+
+private:
+  void setParameters(IkedaCarpenterPV &fn) {
+    fn.setParameter("I", 3101.672);
+    fn.setParameter("Alpha0", 1.6);
+    fn.setParameter("Alpha1", 1.5);
+    fn.setParameter("Beta0", 31.9);
+    fn.setParameter("Kappa", 46.0);
+    fn.setParameter("SigmaSquared", 99.935);
+    fn.setParameter("Gamma", 0.5);
+    fn.setParameter("X0", 49.984);
+  }
+};
+
+class IkedaCarpenterPVTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static IkedaCarpenterPVTestPerformance *createSuite() {
+    return new IkedaCarpenterPVTestPerformance();
+  }
+  static void destroySuite(IkedaCarpenterPVTestPerformance *suite) {
+    delete suite;
+  }
+
+  IkedaCarpenterPVTestPerformance()
+      : m_domain(0.0, 100.0, NPOINTS), m_values(m_domain) {
+    m_fn.initialize();
+    m_fn.setParameter("I", 3101.672);
+    m_fn.setParameter("SigmaSquared", 99.935);
+    m_fn.setParameter("X0", 49.984);
+  }
+
+  void test_function_gaussian() {
+    m_fn.setParameter("Gamma", 0.0);
+    m_fn.function(m_domain, m_values);
+  }
+
+  void test_function_pseudo_voigt() {
+    m_fn.setParameter("Gamma", 0.5);
+    m_fn.function(m_domain, m_values);
+  }
+
+private:
+  static constexpr size_t NPOINTS = 100000;
+  IkedaCarpenterPV m_fn;
+  Mantid::API::FunctionDomain1DVector m_domain;
+  Mantid::API::FunctionValues m_values;
 };
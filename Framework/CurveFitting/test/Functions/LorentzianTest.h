@@ -150,3 +150,33 @@ private:
     return func;
   }
 };
+
+class LorentzianTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LorentzianTestPerformance *createSuite() {
+    return new LorentzianTestPerformance();
+  }
+  static void destroySuite(LorentzianTestPerformance *suite) { delete suite; }
+
+  LorentzianTestPerformance()
+      : m_domain(-10.0, 10.0, NPOINTS), m_values(m_domain),
+        m_jacobian(NPOINTS, 3) {
+    m_fn.initialize();
+    m_fn.setParameter("Amplitude", 2.0);
+    m_fn.setParameter("PeakCentre", 0.5);
+    m_fn.setParameter("FWHM", 1.5);
+  }
+
+  void test_function() { m_fn.function(m_domain, m_values); }
+
+  void test_functionDeriv() { m_fn.functionDeriv(m_domain, m_jacobian); }
+
+private:
+  static constexpr size_t NPOINTS = 1000000;
+  Lorentzian m_fn;
+  Mantid::API::FunctionDomain1DVector m_domain;
+  Mantid::API::FunctionValues m_values;
+  Mantid::CurveFitting::Jacobian m_jacobian;
+};
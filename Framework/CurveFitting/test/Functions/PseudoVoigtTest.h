@@ -511,3 +511,34 @@ private:
 
   std::vector<double> m_xValues;
 };
+
+class PseudoVoigtTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PseudoVoigtTestPerformance *createSuite() {
+    return new PseudoVoigtTestPerformance();
+  }
+  static void destroySuite(PseudoVoigtTestPerformance *suite) { delete suite; }
+
+  PseudoVoigtTestPerformance()
+      : m_domain(-10.0, 10.0, NPOINTS), m_values(m_domain),
+        m_jacobian(NPOINTS, 4) {
+    m_fn.initialize();
+    m_fn.setParameter("Mixing", 0.4);
+    m_fn.setParameter("Intensity", 2.0);
+    m_fn.setParameter("PeakCentre", 0.5);
+    m_fn.setParameter("FWHM", 1.5);
+  }
+
+  void test_function() { m_fn.function(m_domain, m_values); }
+
+  void test_functionDeriv() { m_fn.functionDeriv(m_domain, m_jacobian); }
+
+private:
+  static constexpr size_t NPOINTS = 1000000;
+  PseudoVoigt m_fn;
+  Mantid::API::FunctionDomain1DVector m_domain;
+  Mantid::API::FunctionValues m_values;
+  Mantid::CurveFitting::Jacobian m_jacobian;
+};
@@ -6,9 +6,11 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include <cmath>
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/Jacobian.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 
@@ -83,4 +85,82 @@ public:
     TS_ASSERT(categories.size() == 1);
     TS_ASSERT(categories[0] == "General");
   }
+
+  void test_derivatives_of_fixed_parameters_are_not_set() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("a*exp(-b*x)"));
+    fun.setParameter("a", 2.0);
+    fun.setParameter("b", 0.5);
+    fun.fix(0);
+
+    const size_t nData = 10;
+    std::vector<double> x(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.1 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 2);
+    J.zero();
+    fun.functionDeriv(domain, J);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_EQUALS(J.get(i, 0), 0.0);
+      TS_ASSERT_DELTA(J.get(i, 1), -2.0 * x[i] * exp(-0.5 * x[i]), 1e-12);
+    }
+  }
+
+  void test_formula_with_functions_of_mu_parser_only() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("h*rint(x)+c"));
+    fun.setParameter("h", 2.0);
+    fun.setParameter("c", 1.0);
+
+    const size_t nData = 5;
+    std::vector<double> x{0.1, 0.9, 1.2, 2.6, 3.0}, y(nData);
+    fun.function1D(&y[0], &x[0], nData);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(y[i], 2.0 * std::round(x[i]) + 1.0, 1e-12);
+    }
+
+    FunctionDomain1DVector domain(x);
+    UserTestJacobian J(nData, 2);
+    fun.functionDeriv(domain, J);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(J.get(i, 0), std::round(x[i]), 1e-6);
+      TS_ASSERT_DELTA(J.get(i, 1), 1.0, 1e-6);
+    }
+  }
+};
+
+class UserFunctionTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static UserFunctionTestPerformance *createSuite() {
+    return new UserFunctionTestPerformance();
+  }
+  static void destroySuite(UserFunctionTestPerformance *suite) {
+    delete suite;
+  }
+
+  UserFunctionTestPerformance()
+      : m_domain(-10.0, 10.0, NPOINTS), m_values(m_domain),
+        m_jacobian(NPOINTS, 4) {
+    m_fn.setAttribute("Formula",
+                      UserFunction::Attribute("h*exp(-0.5*((x-c)/s)^2)+b"));
+    m_fn.setParameter("h", 2.0);
+    m_fn.setParameter("c", 0.5);
+    m_fn.setParameter("s", 1.5);
+    m_fn.setParameter("b", 0.1);
+  }
+
+  void test_function() { m_fn.function(m_domain, m_values); }
+
+  void test_functionDeriv() { m_fn.functionDeriv(m_domain, m_jacobian); }
+
+private:
+  static constexpr size_t NPOINTS = 1000000;
+  UserFunction m_fn;
+  FunctionDomain1DVector m_domain;
+  FunctionValues m_values;
+  UserFunctionTest::UserTestJacobian m_jacobian;
 };
@@ -0,0 +1,92 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** MappedFileRegion : a range of bytes of a file mapped read-only into
+ * memory. The pages are only read from disk when they are first accessed.
+ */
+class MANTID_DATAHANDLING_DLL MappedFileRegion {
+public:
+  MappedFileRegion(const std::string &filename, uint64_t offset,
+                   size_t length);
+  ~MappedFileRegion();
+  MappedFileRegion(const MappedFileRegion &) = delete;
+  MappedFileRegion &operator=(const MappedFileRegion &) = delete;
+
+  /// @return pointer to the first mapped byte
+  const char *data() const { return m_data; }
+  /// @return the number of mapped bytes
+  size_t size() const { return m_length; }
+
+  template <typename T>
+  static std::shared_ptr<const MappedFileRegion>
+  mapDatasetSlab(const std::string &filename, const std::string &path,
+                 int64_t start, int64_t count);
+
+private:
+  /// Start of the mapping, aligned to the system page granularity
+  void *m_base;
+  /// Length of the mapping from m_base
+  size_t m_mappedLength;
+  /// The first requested byte
+  const char *m_data;
+  /// The number of requested bytes
+  size_t m_length;
+};
+
+/** EventArray : read-only array of one field of the events of a bank, e.g.
+ * the detector IDs. The values are either owned by the array, after being
+ * read from the file, or live in a MappedFileRegion so that they are never
+ * copied before being added to the event lists.
+ */
+template <typename T> class EventArray {
+public:
+  /// Take ownership of values read from the file
+  explicit EventArray(std::vector<T> values)
+      : m_values(std::move(values)), m_data(m_values.data()),
+        m_size(m_values.size()) {}
+
+  /// Refer to values in a mapped region of the file
+  explicit EventArray(std::shared_ptr<const MappedFileRegion> region)
+      : m_region(std::move(region)),
+        m_data(reinterpret_cast<const T *>(m_region->data())),
+        m_size(m_region->size() / sizeof(T)) {}
+
+  EventArray(const EventArray &) = delete;
+  EventArray &operator=(const EventArray &) = delete;
+
+  const T *data() const { return m_data; }
+  size_t size() const { return m_size; }
+  const T &operator[](size_t i) const { return m_data[i]; }
+  const T *begin() const { return m_data; }
+  const T *end() const { return m_data + m_size; }
+  /// @return true if the values are read directly from the mapped file
+  bool isMapped() const { return static_cast<bool>(m_region); }
+
+private:
+  /// Values owned by the array
+  std::vector<T> m_values;
+  /// Mapped region holding the values
+  std::shared_ptr<const MappedFileRegion> m_region;
+  /// The first value
+  const T *m_data;
+  /// Number of values
+  size_t m_size;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
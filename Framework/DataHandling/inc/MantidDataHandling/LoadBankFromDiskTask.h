@@ -8,6 +8,7 @@
 
 #include "MantidAPI/Progress.h"
 #include "MantidDataHandling/DllConfig.h"
+#include "MantidDataHandling/EventArray.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadScheduler.h"
 
@@ -42,9 +43,12 @@ private:
   void prepareEventId(::NeXus::File &file, int64_t &start_event,
                       int64_t &stop_event,
                       const std::vector<uint64_t> &event_index);
-  std::unique_ptr<std::vector<uint32_t>> loadEventId(::NeXus::File &file);
-  std::unique_ptr<std::vector<float>> loadTof(::NeXus::File &file);
-  std::unique_ptr<std::vector<float>> loadEventWeights(::NeXus::File &file);
+  std::unique_ptr<EventArray<uint32_t>> loadEventId(::NeXus::File &file);
+  std::unique_ptr<EventArray<float>> loadTof(::NeXus::File &file);
+  std::unique_ptr<EventArray<float>> loadEventWeights(::NeXus::File &file);
+  template <typename T>
+  std::unique_ptr<EventArray<T>> loadEventArray(::NeXus::File &file,
+                                                const std::string &field);
   int64_t recalculateDataSize(const int64_t &size);
 
   /// Algorithm being run
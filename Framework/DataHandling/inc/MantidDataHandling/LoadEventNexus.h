@@ -192,6 +192,12 @@ public:
 
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
+  /// Tolerance in seconds on the pulse times when compressing events; unset
+  /// (EMPTY_DBL) to discard pulse times.
+  double compressWallClockTolerance;
+  /// Number of events held back in a bank before they are compressed into
+  /// the event lists
+  size_t compressBlockSize;
 
   /// Pulse times for ALL banks, taken from proton_charge log.
   std::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
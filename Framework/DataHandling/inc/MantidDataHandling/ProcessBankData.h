@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidDataHandling/EventArray.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidKernel/NexusDescriptor.h"
 #include "MantidKernel/Task.h"
@@ -45,13 +46,13 @@ public:
    */ // API::IFileLoader<Kernel::NexusDescriptor>
   ProcessBankData(DefaultEventLoader &loader, std::string entry_name,
                   API::Progress *prog,
-                  std::shared_ptr<std::vector<uint32_t>> event_id,
-                  std::shared_ptr<std::vector<float>> event_time_of_flight,
+                  std::shared_ptr<const EventArray<uint32_t>> event_id,
+                  std::shared_ptr<const EventArray<float>> event_time_of_flight,
                   size_t numEvents, size_t startAt,
                   std::shared_ptr<std::vector<uint64_t>> event_index,
                   std::shared_ptr<BankPulseTimes> thisBankPulseTimes,
                   bool have_weight,
-                  std::shared_ptr<std::vector<float>> event_weight,
+                  std::shared_ptr<const EventArray<float>> event_weight,
                   detid_t min_event_id, detid_t max_event_id);
 
   void run() override;
@@ -74,9 +75,9 @@ private:
   /// Progress reporting
   API::Progress *prog;
   /// event pixel ID array
-  std::shared_ptr<std::vector<uint32_t>> event_id;
+  std::shared_ptr<const EventArray<uint32_t>> event_id;
   /// event TOF array
-  std::shared_ptr<std::vector<float>> event_time_of_flight;
+  std::shared_ptr<const EventArray<float>> event_time_of_flight;
   /// # of events in arrays
   size_t numEvents;
   /// index of the first event from event_index
@@ -88,7 +89,7 @@ private:
   /// Flag for simulated data
   bool have_weight;
   /// event weights array
-  std::shared_ptr<std::vector<float>> event_weight;
+  std::shared_ptr<const EventArray<float>> event_weight;
   /// Minimum pixel id
   detid_t m_min_id;
   /// Maximum pixel id
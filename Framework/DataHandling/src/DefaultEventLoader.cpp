@@ -9,7 +9,7 @@
 #include "MantidDataHandling/LoadBankFromDiskTask.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
 
 using namespace Mantid::Kernel;
 
@@ -30,7 +30,7 @@ void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws,
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
   // Make the thread pool
-  auto scheduler = new ThreadSchedulerMutexes;
+  auto scheduler = new ThreadSchedulerWorkStealing;
   ThreadPool pool(scheduler);
   auto diskIOMutex = std::make_shared<std::mutex>();
 
@@ -0,0 +1,199 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/EventArray.h"
+
+#include <hdf5.h>
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Mantid {
+namespace DataHandling {
+
+namespace {
+/// Closes an HDF5 identifier when going out of scope
+class H5Handle {
+public:
+  H5Handle(hid_t id, herr_t (*close)(hid_t)) : m_id(id), m_close(close) {}
+  ~H5Handle() {
+    if (m_id >= 0)
+      m_close(m_id);
+  }
+  H5Handle(const H5Handle &) = delete;
+  H5Handle &operator=(const H5Handle &) = delete;
+  operator hid_t() const { return m_id; }
+  bool valid() const { return m_id >= 0; }
+
+private:
+  hid_t m_id;
+  herr_t (*m_close)(hid_t);
+};
+
+template <typename T> hid_t nativeType();
+template <> hid_t nativeType<uint32_t>() { return H5T_NATIVE_UINT32; }
+template <> hid_t nativeType<float>() { return H5T_NATIVE_FLOAT; }
+
+/** Find where the values [start, start + count) of a dataset are stored in
+ * the file, if they are stored as is: the dataset must be contiguous,
+ * unfiltered, stored in the file itself and of the native type T.
+ * @param filename :: the HDF5 file
+ * @param path :: absolute path of the dataset in the file
+ * @param start :: index of the first value
+ * @param count :: number of values
+ * @param offset :: set to the offset of the first value in the file
+ * @return true if the values can be mapped
+ */
+template <typename T>
+bool findContiguousSlab(const std::string &filename, const std::string &path,
+                        int64_t start, int64_t count, haddr_t &offset) {
+  // The loader may have the file open through the NeXus API, which asks for
+  // strong close semantics; opening it again must ask for the same.
+  H5Handle access(H5Pcreate(H5P_FILE_ACCESS), H5Pclose);
+  if (!access.valid() || H5Pset_fclose_degree(access, H5F_CLOSE_STRONG) < 0)
+    return false;
+  H5Handle file(H5Fopen(filename.c_str(), H5F_ACC_RDONLY, access), H5Fclose);
+  if (!file.valid())
+    return false;
+  H5Handle dataset(H5Dopen2(file, path.c_str(), H5P_DEFAULT), H5Dclose);
+  if (!dataset.valid())
+    return false;
+
+  H5Handle plist(H5Dget_create_plist(dataset), H5Pclose);
+  if (!plist.valid() || H5Pget_layout(plist) != H5D_CONTIGUOUS ||
+      H5Pget_nfilters(plist) != 0 || H5Pget_external_count(plist) != 0)
+    return false;
+
+  H5Handle type(H5Dget_type(dataset), H5Tclose);
+  if (!type.valid() || H5Tequal(type, nativeType<T>()) <= 0)
+    return false;
+
+  H5Handle space(H5Dget_space(dataset), H5Sclose);
+  if (!space.valid() || H5Sget_simple_extent_ndims(space) != 1 ||
+      H5Sget_simple_extent_npoints(space) < start + count)
+    return false;
+
+  const haddr_t address = H5Dget_offset(dataset);
+  if (address == HADDR_UNDEF)
+    return false;
+  offset = address + static_cast<haddr_t>(start) * sizeof(T);
+  // The values must be aligned to be read in place
+  return offset % alignof(T) == 0;
+}
+} // namespace
+
+/** Map a range of a file into memory.
+ * @param filename :: the file
+ * @param offset :: offset of the first byte, in bytes
+ * @param length :: number of bytes
+ * @throws std::runtime_error if the file cannot be mapped
+ */
+MappedFileRegion::MappedFileRegion(const std::string &filename,
+                                   uint64_t offset, size_t length)
+    : m_base(nullptr), m_mappedLength(0), m_data(nullptr), m_length(length) {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  const uint64_t granularity = info.dwAllocationGranularity;
+#else
+  const auto granularity = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+  const uint64_t alignedOffset = offset - offset % granularity;
+  m_mappedLength = static_cast<size_t>(offset - alignedOffset) + length;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error("Cannot open " + filename + " for mapping");
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    throw std::runtime_error("Cannot map " + filename);
+  m_base = MapViewOfFile(mapping, FILE_MAP_READ,
+                         static_cast<DWORD>(alignedOffset >> 32),
+                         static_cast<DWORD>(alignedOffset & 0xFFFFFFFF),
+                         m_mappedLength);
+  CloseHandle(mapping);
+  if (!m_base)
+    throw std::runtime_error("Cannot map " + filename);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Cannot open " + filename + " for mapping");
+  void *base = mmap(nullptr, m_mappedLength, PROT_READ, MAP_PRIVATE, fd,
+                    static_cast<off_t>(alignedOffset));
+  close(fd);
+  if (base == MAP_FAILED)
+    throw std::runtime_error("Cannot map " + filename);
+  m_base = base;
+  // The events are read once, front to back
+  madvise(m_base, m_mappedLength, MADV_SEQUENTIAL);
+#endif
+  m_data = static_cast<const char *>(m_base) + (offset - alignedOffset);
+}
+
+MappedFileRegion::~MappedFileRegion() {
+#ifdef _WIN32
+  UnmapViewOfFile(m_base);
+#else
+  munmap(m_base, m_mappedLength);
+#endif
+}
+
+/** Map the values [start, start + count) of a one-dimensional HDF5 dataset, if
+ * they are stored contiguously and uncompressed in the file as native values
+ * of type T.
+ * @param filename :: the HDF5 file
+ * @param path :: absolute path of the dataset in the file
+ * @param start :: index of the first value
+ * @param count :: number of values
+ * @return the mapped values; nullptr if they must be read with the HDF5
+ * library instead
+ */
+template <typename T>
+std::shared_ptr<const MappedFileRegion>
+MappedFileRegion::mapDatasetSlab(const std::string &filename,
+                                 const std::string &path, int64_t start,
+                                 int64_t count) {
+  if (start < 0 || count <= 0)
+    return nullptr;
+  haddr_t offset = 0;
+  bool contiguous = false;
+  // Not finding what we need is not an error, so keep HDF5 quiet
+  H5E_BEGIN_TRY {
+    contiguous = findContiguousSlab<T>(filename, path, start, count, offset);
+  }
+  H5E_END_TRY;
+  if (!contiguous)
+    return nullptr;
+  try {
+    return std::make_shared<const MappedFileRegion>(
+        filename, offset, static_cast<size_t>(count) * sizeof(T));
+  } catch (std::runtime_error &) {
+    return nullptr;
+  }
+}
+
+template MANTID_DATAHANDLING_DLL std::shared_ptr<const MappedFileRegion>
+MappedFileRegion::mapDatasetSlab<uint32_t>(const std::string &,
+                                           const std::string &, int64_t,
+                                           int64_t);
+template MANTID_DATAHANDLING_DLL std::shared_ptr<const MappedFileRegion>
+MappedFileRegion::mapDatasetSlab<float>(const std::string &,
+                                        const std::string &, int64_t, int64_t);
+
+} // namespace DataHandling
+} // namespace Mantid
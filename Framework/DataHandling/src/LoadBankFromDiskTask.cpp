@@ -179,19 +179,39 @@ void LoadBankFromDiskTask::prepareEventId(
       << stop_event << "\n";
 }
 
+/** Load a slab of the open event field: map it directly from the file when it
+ * is stored contiguously and uncompressed, otherwise read it with the NeXus
+ * API.
+ * @param file :: An NeXus::File object with the field open
+ * @param field :: The name of the field in the bank
+ * @returns The values of the field for the events to load
+ */
+template <typename T>
+std::unique_ptr<EventArray<T>>
+LoadBankFromDiskTask::loadEventArray(::NeXus::File &file,
+                                     const std::string &field) {
+  const std::string path = "/" + m_loader.alg->m_top_entry_name + "/" +
+                           entry_name + "/" + field;
+  auto region = MappedFileRegion::mapDatasetSlab<T>(
+      m_loader.alg->m_filename, path, m_loadStart[0], m_loadSize[0]);
+  if (region)
+    return std::make_unique<EventArray<T>>(std::move(region));
+
+  std::vector<T> values(m_loadSize[0]);
+  file.getSlab(values.data(), m_loadStart, m_loadSize);
+  return std::make_unique<EventArray<T>>(std::move(values));
+}
+
 /** Load the event_id field, which has been opened
  * @param file An NeXus::File object opened at the correct group
  * @returns A new array containing the event Ids for this bank
  */
-std::unique_ptr<std::vector<uint32_t>>
+std::unique_ptr<EventArray<uint32_t>>
 LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   // This is the data size
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
 
-  // Now we allocate the required arrays
-  auto event_id = std::make_unique<std::vector<uint32_t>>(m_loadSize[0]);
-
   // Check that the required space is there in the file.
   if (dim0 < m_loadSize[0] + m_loadStart[0]) {
     m_loader.alg->getLogger().warning()
@@ -204,10 +224,12 @@ LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
   if (m_loader.alg->getCancel())
     m_loadError = true; // To allow cancelling the algorithm
 
+  std::unique_ptr<EventArray<uint32_t>> event_id;
   if (!m_loadError) {
     // Must be uint32
     if (id_info.type == ::NeXus::UINT32)
-      file.getSlab(event_id->data(), m_loadStart, m_loadSize);
+      event_id = loadEventArray<uint32_t>(
+          file, m_oldNexusFileNames ? "event_pixel_id" : "event_id");
     else {
       m_loader.alg->getLogger().warning()
           << "Entry " << entry_name
@@ -215,12 +237,13 @@ LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
       m_loadError = true;
     }
     file.closeData();
+  }
 
+  if (event_id) {
     // determine the range of pixel ids
-    m_min_id =
-        *(std::min_element(event_id->data(), event_id->data() + m_loadSize[0]));
-    m_max_id =
-        *(std::max_element(event_id->data(), event_id->data() + m_loadSize[0]));
+    const auto range = std::minmax_element(event_id->begin(), event_id->end());
+    m_min_id = *range.first;
+    m_max_id = *range.second;
 
     if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
       // All the detector IDs in the bank are higher than the highest 'known'
@@ -248,12 +271,8 @@ LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
  * @param file An NeXus::File object opened at the correct group
  * @returns A new array containing the time of flights for this bank
  */
-std::unique_ptr<std::vector<float>>
+std::unique_ptr<EventArray<float>>
 LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
-  // Allocate the array
-  auto event_time_of_flight =
-      std::make_unique<std::vector<float>>(m_loadSize[0]);
-
   // Get the list of event_time_of_flight's
   std::string key, tof_unit;
   if (!m_oldNexusFileNames)
@@ -272,6 +291,15 @@ LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
            "to load the desired data.\n";
     m_loadError = true;
   }
+  file.getAttr("units", tof_unit);
+
+  // Floats already in microseconds can be used straight from the file
+  if (tof_info.type == ::NeXus::FLOAT32 &&
+      Kernel::Units::timeConversionValue(tof_unit, "microseconds") == 1.0) {
+    auto event_time_of_flight = loadEventArray<float>(file, key);
+    file.closeData();
+    return event_time_of_flight;
+  }
 
   // The Nexus standard does not specify if event_time_offset should be float or
   // integer, so we use the NeXusIOHelper to perform the conversion to float on
@@ -279,13 +307,10 @@ LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
   // skipped.
   auto vec = NeXus::NeXusIOHelper::readNexusSlab<float>(file, key, m_loadStart,
                                                         m_loadSize);
-  file.getAttr("units", tof_unit);
   file.closeData();
   // Convert Tof to microseconds
   Kernel::Units::timeConversionVector(vec, tof_unit, "microseconds");
-  std::copy(vec.begin(), vec.end(), event_time_of_flight->data());
-
-  return event_time_of_flight;
+  return std::make_unique<EventArray<float>>(std::move(vec));
 }
 
 /** Load weight of weigthed events if they exist
@@ -293,7 +318,7 @@ LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
  * @returns A new array containing the weights or a nullptr if the weights
  * are not present
  */
-std::unique_ptr<std::vector<float>>
+std::unique_ptr<EventArray<float>>
 LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   try {
     // First, get info about the event_weight field in this bank
@@ -301,14 +326,11 @@ LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   } catch (::NeXus::Exception &) {
     // Field not found error is most likely.
     m_have_weight = false;
-    return std::unique_ptr<std::vector<float>>();
+    return std::unique_ptr<EventArray<float>>();
   }
   // OK, we've got them
   m_have_weight = true;
 
-  // Allocate the array
-  auto event_weight = std::make_unique<std::vector<float>>(m_loadSize[0]);
-
   ::NeXus::Info weight_info = file.getInfo();
   int64_t weight_dim0 = recalculateDataSize(weight_info.dims[0]);
   if (weight_dim0 < m_loadSize[0] + m_loadStart[0]) {
@@ -319,8 +341,9 @@ LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
   }
 
   // Check that the type is what it is supposed to be
+  std::unique_ptr<EventArray<float>> event_weight;
   if (weight_info.type == ::NeXus::FLOAT32)
-    file.getSlab(event_weight->data(), m_loadStart, m_loadSize);
+    event_weight = loadEventArray<float>(file, "event_weight");
   else {
     m_loader.alg->getLogger().warning()
         << "Entry " << entry_name
@@ -346,9 +369,9 @@ void LoadBankFromDiskTask::run() {
   prog->report(entry_name + ": load from disk");
 
   // arrays to load into
-  std::unique_ptr<std::vector<uint32_t>> event_id;
-  std::unique_ptr<std::vector<float>> event_time_of_flight;
-  std::unique_ptr<std::vector<float>> event_weight;
+  std::unique_ptr<EventArray<uint32_t>> event_id;
+  std::unique_ptr<EventArray<float>> event_time_of_flight;
+  std::unique_ptr<EventArray<float>> event_weight;
   std::vector<uint64_t> event_index;
 
   // Open the file
@@ -473,10 +496,12 @@ void LoadBankFromDiskTask::run() {
   auto startAt = static_cast<size_t>(m_loadStart[0]);
 
   // convert things to shared_arrays to share between tasks
-  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(event_id.release());
-  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(
-      event_time_of_flight.release());
-  std::shared_ptr<std::vector<float>> event_weight_shrd(event_weight.release());
+  std::shared_ptr<const EventArray<uint32_t>> event_id_shrd(
+      std::move(event_id));
+  std::shared_ptr<const EventArray<float>> event_time_of_flight_shrd(
+      std::move(event_time_of_flight));
+  std::shared_ptr<const EventArray<float>> event_weight_shrd(
+      std::move(event_weight));
   auto event_index_shrd =
       std::make_shared<std::vector<uint64_t>>(std::move(event_index));
 
@@ -78,7 +78,9 @@ bool exists(const std::map<std::string, std::string> &entries,
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0),
       longest_tof(0), shortest_tof(0), bad_tofs(0), discarded_events(0),
-      compressTolerance(0), m_instrument_loaded_correctly(false),
+      compressTolerance(0), compressWallClockTolerance(EMPTY_DBL()),
+      compressBlockSize(1 << 20),
+      m_instrument_loaded_correctly(false),
       loadlogs(false), event_id_is_spec(false) {}
 
 //----------------------------------------------------------------------------------------------
@@ -189,7 +191,21 @@ void LoadEventNexus::init() {
                   "Run CompressEvents while loading (optional, leave blank or "
                   "negative to not do). "
                   "This specified the tolerance to use (in microseconds) when "
-                  "compressing.");
+                  "compressing. The events are compressed every block of "
+                  "pulses: a new event joins the nearest compressed event "
+                  "within the tolerance, but compressed events are not "
+                  "combined with each other, so a few more events may be left "
+                  "than by running CompressEvents after loading.");
+
+  auto mustBePositiveDbl = std::make_shared<BoundedValidator<double>>();
+  mustBePositiveDbl->setLower(0.0);
+  mustBePositiveDbl->setLowerExclusive(true);
+  declareProperty("CompressWallClockTolerance", EMPTY_DBL(),
+                  mustBePositiveDbl,
+                  "The tolerance (in seconds) on the pulse times when "
+                  "compressing events while loading. Unset means events are "
+                  "compressed regardless of their pulse times, which are "
+                  "then discarded.");
 
   auto mustBePositive = std::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
@@ -208,6 +224,7 @@ void LoadEventNexus::init() {
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompressWallClockTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
 
@@ -384,6 +401,7 @@ void LoadEventNexus::execLoader() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  compressWallClockTolerance = getProperty("CompressWallClockTolerance");
 
   loadlogs = getProperty("LoadLogs");
 
@@ -1565,7 +1583,8 @@ LoadEventNexus::defineLoaderType(const bool haveWeights,
       !((filter_time_start != Types::Core::DateAndTime::minimum() ||
          filter_time_stop != Types::Core::DateAndTime::maximum()));
   noParallelConstrictions &=
-      !((!isDefault("CompressTolerance") || !isDefault("SpectrumMin") ||
+      !((!isDefault("CompressTolerance") ||
+         !isDefault("CompressWallClockTolerance") || !isDefault("SpectrumMin") ||
          !isDefault("SpectrumMax") || !isDefault("SpectrumList") ||
          !isDefault("ChunkNumber")));
   noParallelConstrictions &= !(classType != "NXevent_data");
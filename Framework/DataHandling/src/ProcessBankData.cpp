@@ -9,6 +9,7 @@
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/EmptyValues.h"
 
 using namespace Mantid::DataObjects;
 
@@ -17,12 +18,13 @@ namespace DataHandling {
 
 ProcessBankData::ProcessBankData(
     DefaultEventLoader &m_loader, std::string entry_name, API::Progress *prog,
-    std::shared_ptr<std::vector<uint32_t>> event_id,
-    std::shared_ptr<std::vector<float>> event_time_of_flight, size_t numEvents,
-    size_t startAt, std::shared_ptr<std::vector<uint64_t>> event_index,
+    std::shared_ptr<const EventArray<uint32_t>> event_id,
+    std::shared_ptr<const EventArray<float>> event_time_of_flight,
+    size_t numEvents, size_t startAt,
+    std::shared_ptr<std::vector<uint64_t>> event_index,
     std::shared_ptr<BankPulseTimes> thisBankPulseTimes, bool have_weight,
-    std::shared_ptr<std::vector<float>> event_weight, detid_t min_event_id,
-    detid_t max_event_id)
+    std::shared_ptr<const EventArray<float>> event_weight,
+    detid_t min_event_id, detid_t max_event_id)
     : Task(), m_loader(m_loader), entry_name(std::move(entry_name)),
       pixelID_to_wi_vector(m_loader.pixelID_to_wi_vector),
       pixelID_to_wi_offset(m_loader.pixelID_to_wi_offset), prog(prog),
@@ -62,6 +64,54 @@ getPulseIndex(const size_t event_index, const size_t last_pulse_index,
   }
   return std::distance(event_index_vec->cbegin(), event_index_iter);
 }
+
+/** Events of the pixels of a bank waiting to be compressed into their event
+ * lists, one buffer for each pixel of each period. Compressing every block of
+ * pulses, rather than once the whole bank has been loaded, bounds the memory
+ * used by the uncompressed events.
+ */
+template <typename EventType> class CompressionBuffers {
+public:
+  CompressionBuffers(const size_t numPeriods, const detid_t minId,
+                     const detid_t maxId)
+      : m_minId(minId), m_numIds(static_cast<size_t>(maxId - minId) + 1),
+        m_buffers(numPeriods * m_numIds) {}
+
+  /// Buffer for the events of a pixel in a period
+  std::vector<EventType> &at(const int periodIndex, const detid_t detId) {
+    const size_t index =
+        static_cast<size_t>(periodIndex) * m_numIds + (detId - m_minId);
+    auto &buffer = m_buffers[index];
+    if (buffer.empty())
+      m_used.emplace_back(index);
+    ++m_size;
+    return buffer;
+  }
+
+  /// Number of events in the buffers
+  size_t size() const { return m_size; }
+
+  /** Compress the events of each buffer into the event list of its pixel
+   * @param flush :: called with the period index, detector ID and buffer
+   */
+  template <typename Flush> void flush(const Flush &flush) {
+    for (const size_t index : m_used) {
+      flush(static_cast<int>(index / m_numIds),
+            static_cast<detid_t>(index % m_numIds) + m_minId,
+            m_buffers[index]);
+      m_buffers[index].clear();
+    }
+    m_used.clear();
+    m_size = 0;
+  }
+
+private:
+  detid_t m_minId;
+  size_t m_numIds;
+  std::vector<std::vector<EventType>> m_buffers;
+  std::vector<size_t> m_used;
+  size_t m_size{0};
+};
 } // namespace
 
 /** Run the data processing
@@ -80,7 +130,11 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+  // Will we need to compress?
+  const bool compress = (alg->compressTolerance >= 0);
+  // Reserving space for all the events of a pixel would defeat compressing
+  // them a block at a time
+  if (m_loader.precount && !compress) {
 
     std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
@@ -122,13 +176,28 @@ void ProcessBankData::run() { // override {
   const auto NUM_PULSES = thisBankPulseTimes->numPulses;
   prog->report(entry_name + ": filling events");
 
-  // Will we need to compress?
-  const bool compress = (alg->compressTolerance >= 0);
-
-  // Which detector IDs were touched? - only matters if compress is on
-  std::vector<bool> usedDetIds;
-  if (compress)
-    usedDetIds.assign(m_max_id - m_min_id + 1, false);
+  // When compressing, events are collected in buffers and compressed into the
+  // event lists every block of pulses
+  const auto numPeriods = static_cast<size_t>(outputWS.nPeriods());
+  CompressionBuffers<Types::Event::TofEvent> tofBuffers(
+      compress && !have_weight ? numPeriods : 0, m_min_id, m_max_id);
+  CompressionBuffers<WeightedEvent> weightedBuffers(
+      compress && have_weight ? numPeriods : 0, m_min_id, m_max_id);
+  const bool keepPulseTimes = alg->compressWallClockTolerance != EMPTY_DBL();
+  // Pulse times are grouped in intervals counted from the same origin in all
+  // banks; the GPS epoch precedes any pulse so no event is dropped.
+  const Types::Core::DateAndTime pulseTimeOrigin(static_cast<int64_t>(0));
+  const auto compressInto = [&](const int periodIndex, const detid_t detId,
+                                auto &events) {
+    auto &el = outputWS.getSpectrum(getWorkspaceIndexFromPixelID(detId),
+                                    static_cast<size_t>(periodIndex));
+    if (keepPulseTimes)
+      el.compressFatAndAddEvents(events, alg->compressTolerance,
+                                 pulseTimeOrigin,
+                                 alg->compressWallClockTolerance);
+    else
+      el.compressAndAddEvents(events, alg->compressTolerance);
+  };
 
   const double TOF_MIN = alg->filter_tof_min;
   const double TOF_MAX = alg->filter_tof_max;
@@ -177,6 +246,8 @@ void ProcessBankData::run() { // override {
               const auto weight =
                   static_cast<double>((*event_weight)[eventIndex]);
               const double errorSq = weight * weight;
+              if (compress)
+                eventVector = &weightedBuffers.at(periodIndex, detId);
               eventVector->emplace_back(tof, pulsetime, weight, errorSq);
             } else {
               ++my_discarded_events;
@@ -186,6 +257,8 @@ void ProcessBankData::run() { // override {
             auto *eventVector = m_loader.eventVectors[periodIndex][detId];
             // NULL eventVector indicates a bad spectrum lookup
             if (eventVector) {
+              if (compress)
+                eventVector = &tofBuffers.at(periodIndex, detId);
               eventVector->emplace_back(tof, pulsetime);
             } else {
               ++my_discarded_events;
@@ -204,15 +277,15 @@ void ProcessBankData::run() { // override {
             }
           } else
             badTofs++;
-
-          // Track all the touched wi (only necessary when compressing events,
-          // for thread safety)
-          if (compress)
-            usedDetIds[detId - m_min_id] = true;
         } // valid time-of-flight
 
       } // valid detector IDs
     }   // for events in pulse
+    // Compress a block of events once enough have been collected
+    if (tofBuffers.size() >= alg->compressBlockSize)
+      tofBuffers.flush(compressInto);
+    if (weightedBuffers.size() >= alg->compressBlockSize)
+      weightedBuffers.flush(compressInto);
     // check if cancelled after each pulse
     if (alg->getCancel())
       break;
@@ -223,25 +296,9 @@ void ProcessBankData::run() { // override {
     return;
   }
 
-  //------------ Compress Events (or set sort order) ------------------
-  // Do it on all the detector IDs we touched
-  if (compress) {
-    for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
-      if (usedDetIds[pixID - m_min_id]) {
-        // Find the the workspace index corresponding to that pixel ID
-        size_t wi = getWorkspaceIndexFromPixelID(pixID);
-        auto &el = outputWS.getSpectrum(wi);
-        if (compress)
-          el.compressEvents(alg->compressTolerance, &el);
-        else {
-          if (pulsetimesincreasing)
-            el.setSortOrder(DataObjects::PULSETIME_SORT);
-          else
-            el.setSortOrder(DataObjects::UNSORTED);
-        }
-      }
-    }
-  }
+  //------------ Compress the last block of events ------------------
+  tofBuffers.flush(compressInto);
+  weightedBuffers.flush(compressInto);
   prog->report(entry_name + ": filled events");
 
   alg->getLogger().debug() << entry_name
@@ -0,0 +1,100 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/EventArray.h"
+
+#include <H5Cpp.h>
+#include <Poco/File.h>
+
+#include <numeric>
+
+using namespace H5;
+using namespace Mantid::DataHandling;
+
+class EventArrayTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventArrayTest *createSuite() { return new EventArrayTest(); }
+  static void destroySuite(EventArrayTest *suite) { delete suite; }
+
+  EventArrayTest() : m_filename("EventArrayTest.h5"), m_ids(10000) {
+    std::iota(m_ids.begin(), m_ids.end(), 100u);
+    removeFile();
+    H5File file(m_filename, H5F_ACC_EXCL);
+    Group bank = file.createGroup("/entry").createGroup("bank1_events");
+    const hsize_t dims[1] = {m_ids.size()};
+    DataSpace space(1, dims);
+    bank.createDataSet("event_id", PredType::NATIVE_UINT32, space)
+        .write(m_ids.data(), PredType::NATIVE_UINT32);
+
+    DSetCreatPropList chunked;
+    const hsize_t chunk[1] = {1024};
+    chunked.setChunk(1, chunk);
+    chunked.setDeflate(4);
+    bank.createDataSet("event_id_compressed", PredType::NATIVE_UINT32, space,
+                       chunked)
+        .write(m_ids.data(), PredType::NATIVE_UINT32);
+    bank.createDataSet("event_id_int64", PredType::NATIVE_INT64, space)
+        .write(m_ids.data(), PredType::NATIVE_UINT32);
+  }
+
+  ~EventArrayTest() override { removeFile(); }
+
+  void test_owned_values() {
+    EventArray<float> array(std::vector<float>{1.f, 2.f, 3.f});
+    TS_ASSERT(!array.isMapped());
+    TS_ASSERT_EQUALS(array.size(), 3);
+    TS_ASSERT_EQUALS(array[1], 2.f);
+    TS_ASSERT_EQUALS(std::accumulate(array.begin(), array.end(), 0.f), 6.f);
+  }
+
+  void test_contiguous_dataset_is_mapped() {
+    auto region = MappedFileRegion::mapDatasetSlab<uint32_t>(
+        m_filename, "/entry/bank1_events/event_id", 5000, 3000);
+    TS_ASSERT(region);
+    if (!region)
+      return;
+    EventArray<uint32_t> array(region);
+    TS_ASSERT(array.isMapped());
+    TS_ASSERT_EQUALS(array.size(), 3000);
+    TS_ASSERT(std::equal(array.begin(), array.end(), m_ids.begin() + 5000));
+  }
+
+  void test_compressed_dataset_is_not_mapped() {
+    TS_ASSERT(!MappedFileRegion::mapDatasetSlab<uint32_t>(
+        m_filename, "/entry/bank1_events/event_id_compressed", 0, 100));
+  }
+
+  void test_other_type_is_not_mapped() {
+    TS_ASSERT(!MappedFileRegion::mapDatasetSlab<uint32_t>(
+        m_filename, "/entry/bank1_events/event_id_int64", 0, 100));
+    TS_ASSERT(!MappedFileRegion::mapDatasetSlab<float>(
+        m_filename, "/entry/bank1_events/event_id", 0, 100));
+  }
+
+  void test_out_of_range_or_missing_is_not_mapped() {
+    TS_ASSERT(!MappedFileRegion::mapDatasetSlab<uint32_t>(
+        m_filename, "/entry/bank1_events/event_id", 9000, 2000));
+    TS_ASSERT(!MappedFileRegion::mapDatasetSlab<uint32_t>(
+        m_filename, "/entry/bank1_events/no_such_field", 0, 100));
+    TS_ASSERT(!MappedFileRegion::mapDatasetSlab<uint32_t>(
+        "EventArrayTest_missing.h5", "/entry/bank1_events/event_id", 0, 100));
+  }
+
+private:
+  void removeFile() {
+    if (Poco::File(m_filename).exists())
+      Poco::File(m_filename).remove();
+  }
+
+  const std::string m_filename;
+  std::vector<uint32_t> m_ids;
+};
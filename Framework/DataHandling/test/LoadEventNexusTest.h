@@ -735,6 +735,80 @@ public:
         ads.retrieveWS<MatrixWorkspace>("cncs_compressed")->monitorWorkspace());
   }
 
+  void test_Load_And_CompressEvents_keeping_pulse_times() {
+    Mantid::API::FrameworkManager::Instance();
+    LoadEventNexus ld;
+    std::string outws_name = "cncs_compressed_pulse_times";
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", outws_name);
+    ld.setPropertyValue("CompressTolerance", "0.05");
+    ld.setPropertyValue("CompressWallClockTolerance", "10");
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    EventWorkspace_sptr WS;
+    TS_ASSERT_THROWS_NOTHING(
+        WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+            outws_name));
+    TS_ASSERT(WS);
+    if (!WS)
+      return;
+    // Fewer events than loaded without compressing, more than compressed
+    // regardless of pulse time
+    TS_ASSERT_LESS_THAN(WS->getNumberEvents(), 112266);
+    TS_ASSERT_LESS_THAN_EQUALS(111274, WS->getNumberEvents());
+    double totalWeight = 0.;
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi++) {
+      const auto &el = WS->getSpectrum(wi);
+      if (el.getNumberEvents() > 0) {
+        // Pixels with at least one event keep their pulse times
+        TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+        TS_ASSERT_DIFFERS(el.getPulseTimeMin().totalNanoseconds(), 0);
+        totalWeight += el.integrate(0., 0., true);
+      }
+    }
+    TS_ASSERT_DELTA(totalWeight, 112266., 1e-6);
+    AnalysisDataService::Instance().remove(outws_name);
+  }
+
+  void test_Load_And_CompressEvents_in_many_blocks() {
+    Mantid::API::FrameworkManager::Instance();
+    for (const std::string wallClockTolerance : {"", "10"}) {
+      LoadEventNexus ld;
+      ld.initialize();
+      ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+      ld.setPropertyValue("OutputWorkspace", "cncs_compressed_blocks");
+      ld.setPropertyValue("CompressTolerance", "0.05");
+      if (!wallClockTolerance.empty())
+        ld.setPropertyValue("CompressWallClockTolerance", wallClockTolerance);
+      ld.setProperty<bool>("LoadLogs", false); // Time-saver
+      // Compress every 1000 events, rather than once for this small file
+      ld.compressBlockSize = 1000;
+      ld.execute();
+      TS_ASSERT(ld.isExecuted());
+
+      auto WS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(
+          "cncs_compressed_blocks");
+      TS_ASSERT(WS);
+      if (!WS)
+        return;
+      // At least as many events as compressed in a single block
+      TS_ASSERT_LESS_THAN(WS->getNumberEvents(), 112266);
+      TS_ASSERT_LESS_THAN_EQUALS(111274, WS->getNumberEvents());
+      double totalWeight = 0.;
+      for (size_t wi = 0; wi < WS->getNumberHistograms(); wi++) {
+        const auto &el = WS->getSpectrum(wi);
+        totalWeight += el.integrate(0., 0., true);
+        if (wallClockTolerance.empty())
+          TS_ASSERT(el.isSortedByTof())
+      }
+      TS_ASSERT_DELTA(totalWeight, 112266., 1e-6);
+      AnalysisDataService::Instance().remove("cncs_compressed_blocks");
+    }
+  }
+
   void doTestSingleBank(bool SingleBankPixelsOnly, bool Precount,
                         const std::string &BankName = "bank36",
                         bool willFail = false) {
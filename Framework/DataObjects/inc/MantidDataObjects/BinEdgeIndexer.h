@@ -0,0 +1,214 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/System.h"
+#include "MantidKernel/cow_ptr.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** BinEdgeIndexer : finds the bin an x value (e.g. an event time-of-flight)
+  falls into.
+
+  Linear and logarithmic bin edges, as produced by Rebin, are recognised on
+  construction and the bin index is then computed directly from x, with a
+  final comparison against the neighbouring edges so the result is identical
+  to a search of the edges. The logarithm for logarithmic edges is looked up
+  in a precomputed table rather than calculated for each value. Arbitrary
+  edges fall back to a binary search.
+
+  A bin i holds the values X[i] <= x < X[i+1]; values outside
+  [X.front(), X.back()) and NaN have no bin.
+
+  The indexer keeps a reference to the edges, which must outlive it.
+*/
+class DLLExport BinEdgeIndexer {
+public:
+  /// The kind of bin edges detected
+  enum class Spacing { Linear, Logarithmic, Arbitrary };
+  /// Returned for values that are not in any bin
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  explicit BinEdgeIndexer(const MantidVec &X);
+
+  /// @return the kind of bin edges detected
+  Spacing spacing() const { return m_spacing; }
+  /// @return the number of bins
+  size_t numberOfBins() const { return m_numBins; }
+  /// @return the bin edges
+  const MantidVec &edges() const { return m_edges; }
+
+  size_t index(const double x) const;
+
+  template <typename Iterator, typename TofFunc>
+  void countsHistogram(Iterator begin, Iterator end, const TofFunc &getTof,
+                       MantidVec &Y) const;
+
+  template <typename Iterator, typename TofFunc, typename WeightFunc,
+            typename ErrorFunc>
+  void weightedHistogram(Iterator begin, Iterator end, const TofFunc &getTof,
+                         const WeightFunc &getWeight,
+                         const ErrorFunc &getErrorSquared, MantidVec &Y,
+                         MantidVec &E) const;
+
+private:
+  /// Number of leading bits of the mantissa indexing the table of logarithms
+  static constexpr int LOG_TABLE_BITS = 10;
+  /// Number of intervals of the table of logarithms
+  static constexpr size_t LOG_TABLE_SIZE = size_t(1) << LOG_TABLE_BITS;
+
+  double tableLog(const double x) const;
+  double estimate(const double x) const;
+  size_t refine(const double x, size_t guess) const;
+  size_t searchEdges(const double x) const;
+
+  /// The bin edges
+  const MantidVec &m_edges;
+  /// Number of bins, or 0 if there are fewer than two edges
+  size_t m_numBins;
+  /// The kind of bin edges detected
+  Spacing m_spacing;
+  /// The first edge (log of it for logarithmic spacing)
+  double m_origin;
+  /// Inverse of the bin width (of the log-step for logarithmic spacing)
+  double m_scale;
+  /// For logarithmic spacing, the logarithms of the mantissas at the start of
+  /// each interval of the table followed by their inverses
+  const double *m_logTable;
+};
+
+/** Natural logarithm of x from the precomputed logarithm of the start of the
+ * interval of the table holding its mantissa and a linear correction within
+ * the interval. It is accurate to about 1e-7, which is enough for the first
+ * guess of a bin.
+ * @param x :: a positive, normal value
+ * @return an estimate of log(x)
+ */
+inline double BinEdgeIndexer::tableLog(const double x) const {
+  constexpr int mantissaBits = std::numeric_limits<double>::digits - 1;
+  constexpr uint64_t mantissaMask = (uint64_t(1) << mantissaBits) - 1;
+  constexpr uint64_t exponentOfOne = uint64_t(1023) << mantissaBits;
+  uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  const auto exponent =
+      static_cast<double>(static_cast<int>(bits >> mantissaBits) - 1023);
+  const size_t cell = static_cast<size_t>((bits & mantissaMask) >>
+                                          (mantissaBits - LOG_TABLE_BITS));
+  // The mantissa of x, in [1, 2), and its offset in the interval
+  bits = (bits & mantissaMask) | exponentOfOne;
+  double mantissa;
+  std::memcpy(&mantissa, &bits, sizeof(mantissa));
+  const double offset =
+      mantissa - (1. + static_cast<double>(cell) / LOG_TABLE_SIZE);
+  return exponent * M_LN2 + m_logTable[cell] +
+         offset * m_logTable[LOG_TABLE_SIZE + cell];
+}
+
+/** First guess of the bin holding x, from the detected spacing. Arbitrary
+ * edges give the position of the first bin.
+ * @param x :: a value in [X.front(), X.back())
+ * @return the fractional bin position of x
+ */
+inline double BinEdgeIndexer::estimate(const double x) const {
+  switch (m_spacing) {
+  case Spacing::Linear:
+    return (x - m_origin) * m_scale;
+  case Spacing::Logarithmic:
+    return (tableLog(x) - m_origin) * m_scale;
+  default:
+    return 0.;
+  }
+}
+
+/** Walk from a guessed bin to the one holding x. Rounding in the analytic
+ * estimate leaves the guess at most a bin away, so this is usually one or two
+ * comparisons.
+ * @param x :: a value in [X.front(), X.back())
+ * @param guess :: the guessed bin index
+ * @return the index of the bin holding x
+ */
+inline size_t BinEdgeIndexer::refine(const double x, size_t guess) const {
+  while (guess > 0 && x < m_edges[guess])
+    --guess;
+  while (x >= m_edges[guess + 1])
+    ++guess;
+  return guess;
+}
+
+/** Find the bin holding x.
+ * @param x :: the value to look up
+ * @return the bin index, or npos if x is not in any bin
+ */
+inline size_t BinEdgeIndexer::index(const double x) const {
+  // Written so that NaN also fails the test
+  if (m_numBins == 0 || !(x >= m_edges.front() && x < m_edges.back()))
+    return npos;
+  if (m_spacing == Spacing::Arbitrary)
+    return searchEdges(x);
+  const double position = estimate(x);
+  const size_t guess =
+      position < static_cast<double>(m_numBins)
+          ? static_cast<size_t>(std::max(position, 0.))
+          : m_numBins - 1;
+  return refine(x, guess);
+}
+
+/** Place events in Y, counting one per event. The events do not need to be
+ * sorted. Y must already be sized to numberOfBins() and zeroed.
+ * @param begin :: iterator to the first event
+ * @param end :: iterator past the last event
+ * @param getTof :: returns the x value of an event
+ * @param Y :: the counts histogram to add to
+ */
+template <typename Iterator, typename TofFunc>
+void BinEdgeIndexer::countsHistogram(Iterator begin, Iterator end,
+                                     const TofFunc &getTof,
+                                     MantidVec &Y) const {
+  for (auto it = begin; it != end; ++it) {
+    const size_t bin = index(getTof(*it));
+    if (bin != npos)
+      Y[bin] += 1.0;
+  }
+}
+
+/** Place events in Y and their squared errors in E. The events do not need to
+ * be sorted. Y and E must already be sized to numberOfBins() and zeroed; E
+ * holds the squared errors on return.
+ * @param begin :: iterator to the first event
+ * @param end :: iterator past the last event
+ * @param getTof :: returns the x value of an event
+ * @param getWeight :: returns the weight of an event
+ * @param getErrorSquared :: returns the squared error of an event
+ * @param Y :: the histogram to add the weights to
+ * @param E :: the histogram to add the squared errors to
+ */
+template <typename Iterator, typename TofFunc, typename WeightFunc,
+          typename ErrorFunc>
+void BinEdgeIndexer::weightedHistogram(Iterator begin, Iterator end,
+                                       const TofFunc &getTof,
+                                       const WeightFunc &getWeight,
+                                       const ErrorFunc &getErrorSquared,
+                                       MantidVec &Y, MantidVec &E) const {
+  for (auto it = begin; it != end; ++it) {
+    const size_t bin = index(getTof(*it));
+    if (bin != npos) {
+      Y[bin] += getWeight(*it);
+      E[bin] += getErrorSquared(*it);
+    }
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
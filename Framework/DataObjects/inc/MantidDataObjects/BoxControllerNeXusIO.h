@@ -56,6 +56,11 @@ public:
   void setDataType(const size_t blockSize,
                    const std::string &typeName) override;
   void getDataType(size_t &CoordSize, std::string &typeName) const override;
+  /** Set whether the chunks of a new event data array are compressed. Has to
+   * be called before the file is opened; existing arrays keep their layout */
+  void setCompressEvents(const bool compress) { m_compressEvents = compress; }
+  /// @return true if the chunks of new event data arrays are compressed
+  bool getCompressEvents() const { return m_compressEvents; }
   //------------------------------------------------------------------------------------------------------------------------
   // Auxiliary functions (non-virtual, used for testing)
   int64_t getNDataColums() const { return m_BlockSize[1]; }
@@ -87,6 +92,8 @@ private:
   /// the vector, which describes the event specific data size, namely how many
   /// column an event is composed into and this class reads/writres
   std::vector<int64_t> m_BlockSize;
+  /// if true, the chunks of a newly created event data array are compressed
+  bool m_compressEvents;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
 
@@ -26,6 +26,7 @@ using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class BinEdgeIndexer;
 class EventWorkspaceMRU;
 
 /// How the event list is sorted.
@@ -56,6 +57,9 @@ enum EventSortType {
 
 class DLLExport EventList : public Mantid::API::IEventList {
 public:
+  /// Event lists at least this long are sorted using several threads
+  static constexpr size_t PARALLEL_SORT_MIN_EVENTS = 1 << 20;
+
   EventList();
 
   EventList(EventWorkspaceMRU *mru, specnum_t specNo);
@@ -213,9 +217,23 @@ public:
   void compressFatEvents(const double tolerance,
                          const Types::Core::DateAndTime &timeStart,
                          const double seconds, EventList *destination);
+  void compressAndAddEvents(std::vector<Types::Event::TofEvent> &events,
+                            const double tolerance);
+  void compressAndAddEvents(std::vector<WeightedEvent> &events,
+                            const double tolerance);
+  void compressFatAndAddEvents(std::vector<Types::Event::TofEvent> &events,
+                               const double tolerance,
+                               const Types::Core::DateAndTime &timeStart,
+                               const double seconds);
+  void compressFatAndAddEvents(std::vector<WeightedEvent> &events,
+                               const double tolerance,
+                               const Types::Core::DateAndTime &timeStart,
+                               const double seconds);
   // get EventType declaration
   void generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E,
                          bool skipError = false) const override;
+  void generateHistogram(const BinEdgeIndexer &indexer, MantidVec &Y,
+                         MantidVec &E, bool skipError = false) const;
   void generateHistogramPulseTime(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E,
                                   bool skipError = false) const override;
@@ -433,11 +451,24 @@ private:
       const std::vector<T> &events, std::vector<WeightedEvent> &out,
       const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
       const double seconds);
+  template <class T>
+  void compressAndAddEventsHelper(std::vector<T> &events,
+                                  const double tolerance);
+  template <class T>
+  void compressFatAndAddEventsHelper(
+      std::vector<T> &events, const double tolerance,
+      const Mantid::Types::Core::DateAndTime &timeStart, const double seconds);
 
   template <class T>
   static void histogramForWeightsHelper(const std::vector<T> &events,
                                         const MantidVec &X, MantidVec &Y,
                                         MantidVec &E);
+  void generateHistogramOnOwnX(MantidVec &Y, MantidVec &E,
+                               bool skipError = false) const;
+  template <class T>
+  static void histogramUnsortedForWeightsHelper(const std::vector<T> &events,
+                                                const BinEdgeIndexer &indexer,
+                                                MantidVec &Y, MantidVec &E);
   template <class T>
   static void integrateHelper(std::vector<T> &events, const double minX,
                               const double maxX, const bool entireRange,
@@ -514,20 +545,22 @@ private:
   void
   splitByPulseTimeWithMatrixHelper(const std::vector<int64_t> &vec_split_times,
                                    const std::vector<int> &vec_split_target,
-                                   std::map<int, EventList *> outputs,
+                                   const std::map<int, EventList *> &outputs,
                                    typename std::vector<T> &events) const;
 
   template <class T>
   std::string splitByFullTimeVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      const std::map<int, EventList *> &outputs,
+      typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+      double tofshift) const;
 
   template <class T>
   std::string splitByFullTimeSparseVectorSplitterHelper(
       const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-      std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-      bool docorrection, double toffactor, double tofshift) const;
+      const std::map<int, EventList *> &outputs,
+      typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+      double tofshift) const;
 
   template <class T>
   static void multiplyHelper(std::vector<T> &events, const double value,
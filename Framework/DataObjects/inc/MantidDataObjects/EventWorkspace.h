@@ -141,6 +141,8 @@ public:
 
   std::size_t MRUSize() const;
 
+  EventWorkspaceMRU &getMRU() const;
+
   void clearMRU() const override;
 
   EventSortType getSortType() const;
@@ -8,14 +8,15 @@
 
 #include "MantidHistogramData/HistogramE.h"
 #include "MantidHistogramData/HistogramY.h"
-#include "MantidKernel/Exception.h"
-#include "MantidKernel/MRUList.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
 
-#include "Poco/RWLock.h"
-
+#include <atomic>
 #include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 
 namespace Mantid {
@@ -23,55 +24,33 @@ namespace DataObjects {
 
 class EventList;
 
-//============================================================================
-//============================================================================
-/**
- * This little class holds data and an index marker that is used for uniqueness.
- * This is used in the MRUList.
- */
-template <class T> class TypeWithMarker {
-public:
-  /**
-   * Constructor.
-   * @param the_index :: unique index into the workspace of this data
-   */
-  TypeWithMarker(const uintptr_t the_index) : m_index(the_index) {}
-  TypeWithMarker(const TypeWithMarker &other) = delete;
-  TypeWithMarker &operator=(const TypeWithMarker &other) = delete;
-
-public:
-  /// Unique index value.
-  uintptr_t m_index;
-
-  /// Pointer to a vector of data
-  T m_data;
-
-  /// Function returns a unique index, used for hashing for MRU list
-  uintptr_t hashIndexFunction() const { return m_index; }
-
-  /// Set the unique index value.
-  void setIndex(const uintptr_t the_index) { m_index = the_index; }
-};
-
 //============================================================================
 //============================================================================
 /** This is a container for the MRU (most-recently-used) list
  * of generated histograms.
+ *
+ * The cache is split into shards, one per thread, each guarded by its own
+ * mutex, so threads generating histograms do not contend with each other.
+ * Threads beyond the number of shards made at construction get shards of
+ * their own when they first use the cache. A shard only evicts entries
+ * inserted through it and never the one inserted last, which keeps the
+ * reference returned by EventList::y() valid until the same thread has cached
+ * another histogram.
+ *
+ * Each shard keeps at most a fixed number of histograms and, if a memory
+ * budget is set, its share of that budget in bytes. Histograms of pinned
+ * event lists are never evicted, only invalidated when the list changes.
  */
 class DLLExport EventWorkspaceMRU {
 public:
   using YType = Kernel::cow_ptr<HistogramData::HistogramY>;
   using EType = Kernel::cow_ptr<HistogramData::HistogramE>;
-  using YWithMarker = TypeWithMarker<YType>;
-  using EWithMarker = TypeWithMarker<EType>;
-  // Typedef for a Most-Recently-Used list of Data objects.
-  using mru_listY = Kernel::MRUList<YWithMarker>;
-  using mru_listE = Kernel::MRUList<EWithMarker>;
 
-  ~EventWorkspaceMRU();
+  /// Number of Y (and E) histograms kept per shard by default
+  static constexpr size_t DEFAULT_ENTRIES_PER_SHARD = 50;
 
-  void ensureEnoughBuffersY(size_t thread_num) const;
-  void ensureEnoughBuffersE(size_t thread_num) const;
+  explicit EventWorkspaceMRU(size_t numShards = 0);
+  ~EventWorkspaceMRU();
 
   void clear();
 
@@ -82,21 +61,49 @@ public:
 
   void deleteIndex(const EventList *index);
 
+  void setMemoryBudget(size_t bytes);
+  /// @return the memory budget in bytes for all shards, 0 if unlimited
+  size_t memoryBudget() const { return m_memoryBudget; }
+  size_t memoryUsed() const;
+
+  void pin(const EventList *index);
+  void unpin(const EventList *index);
+  bool isPinned(const EventList *index) const;
+
+  size_t hits() const;
+  size_t misses() const;
+  void resetStatistics();
+
+  /// @return the number of shards the cache is split into
+  size_t numberOfShards() const { return m_shards.size(); }
+
   /** Return how many entries in the Y MRU list are used.
    * Only used in tests. It only returns the 0-th MRU list size.
    * @return :: number of entries in the MRU list. */
   size_t MRUSize() const;
 
-protected:
-  /// The most-recently-used list of dataY histograms
-  mutable std::vector<std::unique_ptr<mru_listY>> m_bufferedDataY;
-
-  /// The most-recently-used list of dataE histograms
-  mutable std::vector<std::unique_ptr<mru_listE>> m_bufferedDataE;
-
-  /// Mutex when adding entries in the MRU list
-  mutable Poco::RWLock m_changeMruListsMutexE;
-  mutable Poco::RWLock m_changeMruListsMutexY;
+private:
+  struct Shard;
+  Shard &shard(size_t thread_num) const;
+  bool isPinned(std::uintptr_t key) const;
+  size_t shardBudget(const size_t used) const;
+  template <typename Func> void forEachShard(const Func &func) const;
+
+  /// The shards of the cache, indexed by thread number
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  /// Shards of the threads numbered beyond m_shards, made on first use
+  mutable std::map<size_t, std::unique_ptr<Shard>> m_extraShards;
+  /// Mutex protecting m_extraShards
+  mutable std::mutex m_extraShardsMutex;
+  /// Memory budget in bytes for all shards, 0 for no limit
+  std::atomic<size_t> m_memoryBudget{0};
+
+  /// Event lists whose histograms are never evicted
+  std::unordered_set<std::uintptr_t> m_pinned;
+  /// Set when m_pinned is not empty, to skip the lookup otherwise
+  std::atomic<bool> m_hasPinned{false};
+  /// Mutex protecting m_pinned; taken after a shard mutex, never before one
+  mutable std::mutex m_pinnedMutex;
 };
 
 } // namespace DataObjects
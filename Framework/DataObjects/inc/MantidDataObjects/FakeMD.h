@@ -37,10 +37,11 @@ private:
 
   template <typename MDE, size_t nd>
   void addFakeRandomData(const std::vector<double> &params,
-                         typename MDEventWorkspace<MDE, nd>::sptr ws);
+                         std::vector<MDE> &events);
   template <typename MDE, size_t nd>
   void addFakeRegularData(const std::vector<double> &params,
-                          typename MDEventWorkspace<MDE, nd>::sptr ws);
+                          typename MDEventWorkspace<MDE, nd>::sptr ws,
+                          std::vector<MDE> &events);
 
   detid_t pickDetectorID();
 
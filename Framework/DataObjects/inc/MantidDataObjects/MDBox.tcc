@@ -602,6 +602,68 @@ TMDE(void MDBox)::integrateSphere(
     const bool useOnePercentBackgroundCorrection) const {
   // If the box is cached to disk, you need to retrieve it
   const std::vector<MDE> &events = this->getConstEvents();
+  integrateEventsInSphere(events, radiusTransform, radiusSquared, signal,
+                          errorSquared, innerRadiusSquared,
+                          useOnePercentBackgroundCorrection);
+  // it is constant access, so no saving or fiddling with the buffer is needed.
+  // Events just can be dropped if necessary
+  // m_Saveable->releaseEvents();
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
+/** Integrate the signal within several spheres or spherical shells. The events
+ * are retrieved once for all the spheres.
+ *
+ * @param spheres :: the spheres to integrate in
+ * @param indices :: indices into spheres of the spheres to integrate in
+ * @param[out] signal :: the integrated signal of the sphere given by each
+ *        index is added to signal[i]
+ * @param[out] errorSquared :: the integrated squared error of the sphere given
+ *        by each index is added to errorSquared[i]
+ * @param useOnePercentBackgroundCorrection :: remove the top 1% of the events
+ *        in a spherical shell
+ * @param parallel :: unused; the events of a box are integrated by one thread
+ */
+TMDE(void MDBox)::integrateSpheres(
+    const std::vector<MDIntegrationSphere> &spheres,
+    const std::vector<size_t> &indices, signal_t *signal,
+    signal_t *errorSquared, const bool useOnePercentBackgroundCorrection,
+    const bool parallel) const {
+  UNUSED_ARG(parallel);
+  const std::vector<MDE> &events = this->getConstEvents();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto &sphere = spheres[indices[i]];
+    integrateEventsInSphere(events, *sphere.radiusTransform,
+                            sphere.radiusSquared, signal[i], errorSquared[i],
+                            sphere.innerRadiusSquared,
+                            useOnePercentBackgroundCorrection);
+  }
+  if (m_Saveable) {
+    m_Saveable->setBusy(false);
+  }
+}
+
+/** Integrate the signal of events within a sphere or spherical shell
+ *
+ * @param events :: the events to integrate
+ * @param radiusTransform :: nd-to-1 coordinate transformation that converts
+ *        from these dimensions to the distance (squared) from the center of
+ *        the sphere.
+ * @param radiusSquared :: radius^2 below which to integrate
+ * @param[out] signal :: the integrated signal is added to it
+ * @param[out] errorSquared :: the integrated squared error is added to it
+ * @param innerRadiusSquared :: radius^2 above which to integrate
+ * @param useOnePercentBackgroundCorrection :: remove the top 1% of the events
+ *        in a spherical shell
+ */
+TMDE(void MDBox)::integrateEventsInSphere(
+    const std::vector<MDE> &events,
+    const Mantid::API::CoordTransform &radiusTransform,
+    const coord_t radiusSquared, signal_t &signal, signal_t &errorSquared,
+    const coord_t innerRadiusSquared,
+    const bool useOnePercentBackgroundCorrection) {
   if (innerRadiusSquared == 0.0) {
     // For each MDLeanEvent
     for (const auto &it : events) {
@@ -642,12 +704,6 @@ TMDE(void MDBox)::integrateSphere(
       errorSquared += vals[k].second;
     }
   }
-  // it is constant access, so no saving or fiddling with the buffer is needed.
-  // Events just can be dropped if necessary
-  // m_Saveable->releaseEvents();
-  if (m_Saveable) {
-    m_Saveable->setBusy(false);
-  }
 }
 
 /** Integrate the signal within a sphere; for example, to perform single-crystal
@@ -26,6 +26,22 @@
 namespace Mantid {
 namespace DataObjects {
 
+//===============================================================================================
+/** A sphere or spherical shell to integrate the signal in with
+ * MDBoxBase::integrateSpheres: the region where the radius transform gives a
+ * value below radiusSquared and above innerRadiusSquared.
+ */
+struct MDIntegrationSphere {
+  /// Transform giving the distance (squared) from the center of the sphere
+  API::CoordTransform *radiusTransform;
+  /// Center of the sphere in all the dimensions of the boxes
+  const coord_t *center;
+  /// radius^2 below which to integrate
+  coord_t radiusSquared;
+  /// radius^2 above which to integrate
+  coord_t innerRadiusSquared;
+};
+
 #ifndef __INTEL_COMPILER // As of July 13, the packing has no effect for the
                          // Intel compiler and produces a warning
 #pragma pack(push, 4)    // Ensure the structure is no larger than it needs to
@@ -140,6 +156,12 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override = 0;
 
+  virtual void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                                const std::vector<size_t> &indices,
+                                signal_t *signal, signal_t *errorSquared,
+                                const bool useOnePercentBackgroundCorrection,
+                                const bool parallel) const;
+
   /** Find the centroid around a sphere */
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
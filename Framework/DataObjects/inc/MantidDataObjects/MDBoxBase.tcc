@@ -284,5 +284,34 @@ TMDE(size_t MDBoxBase)::addEventsUnsafe(const std::vector<MDE> &events) {
   return 0;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within several spheres or spherical shells; for
+ * example, to integrate all the peaks of a single-crystal run. The result is
+ * the same as calling integrateSphere for each sphere.
+ *
+ * @param spheres :: the spheres to integrate in
+ * @param indices :: indices into spheres of the spheres to integrate in
+ * @param[out] signal :: the integrated signal of the sphere given by each
+ *        index is added to signal[i]
+ * @param[out] errorSquared :: the integrated squared error of the sphere given
+ *        by each index is added to errorSquared[i]
+ * @param useOnePercentBackgroundCorrection :: remove the top 1% of the events
+ *        of each box in a spherical shell, as in integrateSphere
+ * @param parallel :: if true, the work may be shared out to threads
+ */
+TMDE(void MDBoxBase)::integrateSpheres(
+    const std::vector<MDIntegrationSphere> &spheres,
+    const std::vector<size_t> &indices, signal_t *signal,
+    signal_t *errorSquared, const bool useOnePercentBackgroundCorrection,
+    const bool parallel) const {
+  UNUSED_ARG(parallel);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto &sphere = spheres[indices[i]];
+    this->integrateSphere(*sphere.radiusTransform, sphere.radiusSquared,
+                          signal[i], errorSquared[i], sphere.innerRadiusSquared,
+                          useOnePercentBackgroundCorrection);
+  }
+}
+
 } // namespace DataObjects
 } // namespace Mantid
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/MDGridBox.h"
 #include "MantidKernel/Matrix.h"
+#include "MantidKernel/ProgressBase.h"
 
 namespace Mantid {
 namespace DataObjects {
@@ -135,6 +136,17 @@ public:
 
   static void saveWSGenericInfo(::NeXus::File *const file,
                                 const API::IMDWorkspace_const_sptr &ws);
+
+  // save the events of boxes which are in memory into an opened file
+  static void saveBoxesEvents(const std::vector<API::IMDNode *> &boxes,
+                              const std::vector<uint64_t> &eventIndex,
+                              API::IBoxControllerIO *const saver,
+                              Kernel::ProgressBase *const progress = nullptr);
+  // load the events of boxes from an opened file into memory
+  static void loadBoxesEvents(const std::vector<API::IMDNode *> &boxes,
+                              const std::vector<uint64_t> &eventIndex,
+                              API::IBoxControllerIO *const loader,
+                              Kernel::ProgressBase *const progress = nullptr);
 };
 
 template <typename T>
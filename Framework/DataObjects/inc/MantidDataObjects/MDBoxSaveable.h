@@ -9,6 +9,8 @@
 #include "MantidAPI/IMDNode.h"
 #include "MantidKernel/ISaveable.h"
 
+#include <mutex>
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -31,6 +33,10 @@ public:
   /// Load the data which are not in memory yet and merge them with the data in
   /// memory;
   void load() override;
+  /// Load the data from the prefetch thread of the disk buffer
+  size_t loadAhead() override;
+  /// Remove the prefetched data if it has not been used
+  void unloadAhead() override;
   /// Method to flush the data to disk and ensure it is written.
   void flushData() const override;
   /// remove objects data from memory but keep all averages
@@ -49,7 +55,15 @@ public:
   }
 
 private:
+  void loadFromFile();
+
   API::IMDNode *const m_MDNode;
+  /// Serializes loading between the prefetch thread and the users of the box
+  std::mutex m_loadMutex;
+  /// True if the data was loaded by the prefetch thread and not used yet
+  bool m_prefetched;
+  /// Number of events in memory after the data was prefetched
+  size_t m_prefetchedSize;
 };
 } // namespace DataObjects
 } // namespace Mantid
@@ -0,0 +1,197 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MDGridBox.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDBoxTreeBuilder : adds a batch of events to the box structure of an
+  MDEventWorkspace in one go, instead of adding the events one at a time and
+  then calling splitAllIfNeeded.
+
+  The events of a grid box are sorted into the ranges of its children with an
+  in-place counting sort. A box that would hold more events than the split
+  threshold is split before the events are added to it, so each event is
+  moved once per level of the tree and the new boxes get their events in a
+  single allocation. Any split factors, top level splitting and number of
+  dimensions are supported, and events can be added to a workspace that
+  already has boxes and events. The subtrees of the children of the top level
+  box are built in parallel.
+
+  As after splitAllIfNeeded, the caller must refreshCache() on the workspace
+  once all the events have been added.
+*/
+template <typename MDE, size_t nd> class MDBoxTreeBuilder {
+public:
+  /** Constructor
+   * @param ws :: initialized workspace to add the events to
+   */
+  explicit MDBoxTreeBuilder(MDEventWorkspace<MDE, nd> &ws)
+      : m_ws(ws), m_bc(*ws.getBoxController()) {}
+
+  size_t addEvents(std::vector<MDE> &events);
+
+private:
+  using EventIterator = typename std::vector<MDE>::iterator;
+
+  void addToGridBox(MDGridBox<MDE, nd> *gridBox, EventIterator begin,
+                    EventIterator end, const bool parallel);
+  void addToChild(MDGridBox<MDE, nd> *gridBox, const size_t index,
+                  EventIterator begin, EventIterator end);
+  void addToBox(MDBox<MDE, nd> *box, EventIterator begin, EventIterator end);
+
+  /// The workspace the events are added to
+  MDEventWorkspace<MDE, nd> &m_ws;
+  /// Box controller of the workspace
+  API::BoxController &m_bc;
+};
+
+/** Add events to the workspace, splitting the boxes as needed. Events outside
+ * of the workspace are dropped; as with MDGridBox::addEvent, events on the
+ * upper edge of a dimension are kept.
+ *
+ * @param events :: events to add. They are reordered.
+ * @return the number of events that were outside of the workspace
+ */
+template <typename MDE, size_t nd>
+size_t MDBoxTreeBuilder<MDE, nd>::addEvents(std::vector<MDE> &events) {
+  MDBoxBase<MDE, nd> *root = m_ws.getBox();
+  const auto end = std::partition(
+      events.begin(), events.end(), [root](const MDE &event) {
+        for (size_t d = 0; d < nd; d++) {
+          const auto &extents = root->getExtents(d);
+          const coord_t x = event.getCenter(d);
+          if (!(x >= extents.getMin() && x <= extents.getMax()))
+            return false;
+        }
+        return true;
+      });
+  const auto numBad = static_cast<size_t>(std::distance(end, events.end()));
+  const auto numGood = static_cast<size_t>(std::distance(events.begin(), end));
+  if (numGood == 0)
+    return numBad;
+
+  auto *box = dynamic_cast<MDBox<MDE, nd> *>(root);
+  if (box && m_bc.willSplit(box->getNPoints() + numGood, box->getDepth())) {
+    m_ws.splitBox();
+    box = nullptr;
+  }
+  if (box)
+    addToBox(box, events.begin(), end);
+  else
+    addToGridBox(dynamic_cast<MDGridBox<MDE, nd> *>(m_ws.getBox()),
+                 events.begin(), end, true);
+  return numBad;
+}
+
+/** Sort events into the children of a grid box and add them to the children
+ * @param gridBox :: box to add to
+ * @param begin :: start of the events to add
+ * @param end :: end of the events to add
+ * @param parallel :: if true, the children are filled in parallel
+ */
+template <typename MDE, size_t nd>
+void MDBoxTreeBuilder<MDE, nd>::addToGridBox(MDGridBox<MDE, nd> *gridBox,
+                                             EventIterator begin,
+                                             EventIterator end,
+                                             const bool parallel) {
+  const size_t numChildren = gridBox->getNumChildren();
+  // starts[i] is the offset of the events of child i
+  std::vector<size_t> starts(numChildren + 1, 0);
+  for (auto it = begin; it != end; ++it)
+    ++starts[gridBox->getChildIndexFromEvent(*it) + 1];
+  std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+  // Swap each event straight into the range of its child
+  std::vector<size_t> next(starts.begin(), starts.end() - 1);
+  for (size_t child = 0; child < numChildren; ++child) {
+    while (next[child] < starts[child + 1]) {
+      auto &event = begin[next[child]];
+      const size_t target = gridBox->getChildIndexFromEvent(event);
+      if (target == child)
+        ++next[child];
+      else
+        std::swap(event, begin[next[target]++]);
+    }
+  }
+
+  std::exception_ptr error;
+  PARALLEL_FOR_IF_DYNAMIC(parallel, 1)
+  for (int64_t i = 0; i < static_cast<int64_t>(numChildren); ++i) {
+    PARALLEL_START_EXCEPTION_REGION
+    const auto child = static_cast<size_t>(i);
+    if (starts[child] < starts[child + 1])
+      addToChild(gridBox, child, begin + starts[child],
+                 begin + starts[child + 1]);
+    PARALLEL_END_EXCEPTION_REGION(error)
+  }
+  PARALLEL_CHECK_EXCEPTION_REGION(error)
+}
+
+/** Add events to a child of a grid box, splitting it first if it would hold
+ * too many events.
+ * @param gridBox :: parent of the child
+ * @param index :: index of the child
+ * @param begin :: start of the events to add
+ * @param end :: end of the events to add
+ */
+template <typename MDE, size_t nd>
+void MDBoxTreeBuilder<MDE, nd>::addToChild(MDGridBox<MDE, nd> *gridBox,
+                                           const size_t index,
+                                           EventIterator begin,
+                                           EventIterator end) {
+  MDBoxBase<MDE, nd> *child = gridBox->getBoxes()[index];
+  auto *box = dynamic_cast<MDBox<MDE, nd> *>(child);
+  if (!box) {
+    addToGridBox(dynamic_cast<MDGridBox<MDE, nd> *>(child), begin, end, false);
+    return;
+  }
+  const auto numEvents = static_cast<size_t>(std::distance(begin, end));
+  if (!m_bc.willSplit(box->getNPoints() + numEvents, box->getDepth())) {
+    addToBox(box, begin, end);
+    return;
+  }
+  // Split the box now, so that the new events go straight to its children
+  auto newGridBox = new MDGridBox<MDE, nd>(box);
+  // Track how many MDBoxes there are in the overall workspace
+  m_bc.trackNumBoxes(box->getDepth());
+  // Replace (and delete) the old box
+  gridBox->setChild(index, newGridBox);
+  addToGridBox(newGridBox, begin, end, false);
+}
+
+/** Add events to a box that will not be split
+ * @param box :: box to add to
+ * @param begin :: start of the events to add
+ * @param end :: end of the events to add
+ */
+template <typename MDE, size_t nd>
+void MDBoxTreeBuilder<MDE, nd>::addToBox(MDBox<MDE, nd> *box,
+                                         EventIterator begin,
+                                         EventIterator end) {
+  if (box->getDataInMemorySize() == 0)
+    box->reserveMemoryForLoad(std::distance(begin, end));
+  for (auto it = begin; it != end; ++it)
+    box->addEventUnsafe(*it);
+  // As in splitAllIfNeeded, let the disk buffer write out boxes in memory
+  Kernel::ISaveable *const saveable = box->getISaveable();
+  if (saveable && box->getDataInMemorySize() > 0)
+    m_bc.getFileIO()->toWrite(saveable);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
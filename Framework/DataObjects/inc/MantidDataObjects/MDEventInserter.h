@@ -53,10 +53,26 @@ public:
   */
   void insertMDEvent(float signal, float errorSQ, uint16_t runindex,
                      int32_t detectno, Mantid::coord_t *coords) {
+    m_ws->addEvent(makeMDEvent(signal, errorSQ, runindex, detectno, coords));
+  }
+
+  /**
+  Creates an mdevent of the type stored in the MDEW without adding it, e.g. to
+  add a batch of events with MDBoxTreeBuilder.
+  @param signal : intensity
+  @param errorSQ : squared value of the error
+  @param runindex : run index (index into the vector of ExperimentInfo)
+  @param detectno : detector number
+  @param coords : pointer to coordinates array
+  @return the new event
+  */
+  static MDEventType makeMDEvent(float signal, float errorSQ,
+                                 uint16_t runindex, int32_t detectno,
+                                 const Mantid::coord_t *coords) {
     // compile-time overload selection based on nested type information on the
     // MDEventType.
-    insertMDEvent(signal, errorSQ, runindex, detectno, coords,
-                  IntToType<MDEventType::is_full_mdevent>());
+    return makeMDEvent(signal, errorSQ, runindex, detectno, coords,
+                       IntToType<MDEventType::is_full_mdevent>());
   }
 
 private:
@@ -64,28 +80,30 @@ private:
   MDEW_SPTR m_ws;
 
   /**
-  Creates a LEAN MDEvent and adds it to the MDEW.
+  Creates a LEAN MDEvent.
   @param signal : intensity
   @param errorSQ : squared value of the error
   @param coords : pointer to coordinates array
  */
-  void insertMDEvent(float signal, float errorSQ, uint16_t, int32_t,
-                     Mantid::coord_t *coords, IntToType<false>) {
-    m_ws->addEvent(MDEventType(signal, errorSQ, coords));
+  static MDEventType makeMDEvent(float signal, float errorSQ, uint16_t,
+                                 int32_t, const Mantid::coord_t *coords,
+                                 IntToType<false>) {
+    return MDEventType(signal, errorSQ, coords);
   }
 
   /**
-  Creates a FULL MDEvent and adds it to the MDEW.
+  Creates a FULL MDEvent.
   @param signal : intensity
   @param errorSQ : squared value of the error
   @param runindex : run index
   @param detectno : detector number
   @param coords : pointer to coordinates array
   */
-  void insertMDEvent(float signal, float errorSQ, uint16_t runindex,
-                     int32_t detectno, Mantid::coord_t *coords,
-                     IntToType<true>) {
-    m_ws->addEvent(MDEventType(signal, errorSQ, runindex, detectno, coords));
+  static MDEventType makeMDEvent(float signal, float errorSQ,
+                                 uint16_t runindex, int32_t detectno,
+                                 const Mantid::coord_t *coords,
+                                 IntToType<true>) {
+    return MDEventType(signal, errorSQ, runindex, detectno, coords);
   }
 };
 
@@ -112,6 +112,7 @@ public:
   bool isBox() const override { return false; }
 
   size_t getChildIndexFromID(size_t childId) const;
+  size_t getChildIndexFromEvent(const MDE &event) const;
   API::IMDNode *getChild(size_t index) override;
   void setChild(size_t index, MDGridBox<MDE, nd> *newChild);
 
@@ -165,6 +166,12 @@ public:
       const coord_t innerRadiusSquared = 0.0,
       const bool useOnePercentBackgroundCorrection = true) const override;
 
+  void integrateSpheres(const std::vector<MDIntegrationSphere> &spheres,
+                        const std::vector<size_t> &indices, signal_t *signal,
+                        signal_t *errorSquared,
+                        const bool useOnePercentBackgroundCorrection,
+                        const bool parallel) const override;
+
   void centroidSphere(Mantid::API::CoordTransform &radiusTransform,
                       const coord_t radiusSquared, coord_t *centroid,
                       signal_t &signal) const override;
@@ -256,6 +263,7 @@ private:
 
   size_t computeSizesFromSplit();
   void fillBoxShell(const size_t tot, const coord_t ChildInverseVolume);
+  void deleteChildren();
   /**private default copy constructor as the only correct constructor is the one
    * with box controller */
   MDGridBox(const MDGridBox<MDE, nd> &box);
@@ -8,6 +8,7 @@
 #include "MantidDataObjects/MDEvent.h"
 #include "MantidDataObjects/MDGridBox.h"
 #include "MantidKernel/FunctionTask.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/Task.h"
 #include "MantidKernel/ThreadPool.h"
@@ -16,6 +17,7 @@
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/WarningSuppressions.h"
+#include <algorithm>
 #include <boost/math/special_functions/round.hpp>
 #include <boost/optional.hpp>
 #include <ostream>
@@ -111,9 +113,19 @@ TMDE(MDGridBox)::MDGridBox(MDBox<MDE, nd> *box)
   // Prepare to distribute the events that were in the box before, this will
   // load missing events from HDD in file based ws if there are some.
   const std::vector<MDE> &events = box->getConstEvents();
-  // just add event to the existing internal box
+  // Count the events going to each child first, so that every child allocates
+  // its events once, at their final size, instead of growing its vector.
+  std::vector<uint64_t> childSizes(numBoxes, 0);
+  for (const auto &evnt : events) {
+    // Events on the upper boundary go to the last box, as in addEvent
+    const size_t cindex = std::min(calculateChildIndex(evnt), numBoxes - 1);
+    ++childSizes[cindex];
+  }
+  for (size_t i = 0; i < numBoxes; ++i)
+    m_Children[i]->reserveMemoryForLoad(childSizes[i]);
+  // The children are new, so nobody else can be adding to them
   for (const auto &evnt : events)
-    addEvent(evnt);
+    addEventUnsafe(evnt);
 
   // Copy the cached numbers from the incoming box. This is quick - don't need
   // to refresh cache
@@ -194,28 +206,34 @@ TMDE(MDGridBox)::MDGridBox(const MDGridBox<MDE, nd> &other,
     splitCumul[d] = other.splitCumul[d];
     m_SubBoxSize[d] = other.m_SubBoxSize[d];
   }
-  // Copy all the boxes
-  m_Children.clear();
-  m_Children.reserve(numBoxes);
-  for (size_t i = 0; i < other.m_Children.size(); i++) {
+  // Copy all the boxes. The subtrees of the top level box are copied in
+  // parallel as they share nothing but the (thread-safe) disk buffer.
+  const auto numChildren = static_cast<int64_t>(other.m_Children.size());
+  m_Children.assign(other.m_Children.size(), nullptr);
+  std::exception_ptr error;
+  PARALLEL_FOR_IF(this->m_depth == 0)
+  for (int64_t i = 0; i < numChildren; i++) {
+    PARALLEL_START_EXCEPTION_REGION
     API::IMDNode *otherBox = other.m_Children[i];
     const MDBox<MDE, nd> *otherMDBox =
         dynamic_cast<const MDBox<MDE, nd> *>(otherBox);
     const MDGridBox<MDE, nd> *otherMDGridBox =
         dynamic_cast<const MDGridBox<MDE, nd> *>(otherBox);
-    if (otherMDBox) {
-      auto newBox = new MDBox<MDE, nd>(*otherMDBox, otherBC);
-      newBox->setParent(this);
-      m_Children.emplace_back(newBox);
-    } else if (otherMDGridBox) {
-      auto newBox = new MDGridBox<MDE, nd>(*otherMDGridBox, otherBC);
-      newBox->setParent(this);
-      m_Children.emplace_back(newBox);
-    } else {
+    MDBoxBase<MDE, nd> *newBox = nullptr;
+    if (otherMDBox)
+      newBox = new MDBox<MDE, nd>(*otherMDBox, otherBC);
+    else if (otherMDGridBox)
+      newBox = new MDGridBox<MDE, nd>(*otherMDGridBox, otherBC);
+    else
       throw std::runtime_error(
           "MDGridBox::copy_ctor(): an unexpected child box type was found.");
-    }
+    newBox->setParent(this);
+    m_Children[i] = newBox;
+    PARALLEL_END_EXCEPTION_REGION(error)
   }
+  if (error)
+    deleteChildren();
+  PARALLEL_CHECK_EXCEPTION_REGION(error)
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -257,13 +275,23 @@ TMDE(size_t MDGridBox)::computeSizesFromSplit() {
 
 //-----------------------------------------------------------------------------------------------
 /// Destructor
-TMDE(MDGridBox)::~MDGridBox() {
-  // Delete all contained boxes (this should fire the MDGridBox destructors
-  // recursively).
-  auto it = m_Children.begin();
-  for (; it != m_Children.end(); ++it)
-    delete *it;
+TMDE(MDGridBox)::~MDGridBox() { deleteChildren(); }
+
+/** Delete all contained boxes (this fires the MDGridBox destructors
+ * recursively). The subtrees of the top level box are freed in parallel, which
+ * matters for workspaces with millions of boxes.
+ */
+TMDE(void MDGridBox)::deleteChildren() {
+  const auto numChildren = static_cast<int64_t>(m_Children.size());
+  std::exception_ptr error;
+  PARALLEL_FOR_IF(this->m_depth == 0)
+  for (int64_t i = 0; i < numChildren; i++) {
+    PARALLEL_START_EXCEPTION_REGION
+    delete m_Children[i];
+    PARALLEL_END_EXCEPTION_REGION(error)
+  }
   m_Children.clear();
+  PARALLEL_CHECK_EXCEPTION_REGION(error)
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -729,6 +757,30 @@ TMDE(size_t MDGridBox)::getChildIndexFromID(size_t childId) const {
   return UNDEF_SIZET;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Get the index of the child box containing an event. Unlike addEvent, each
+ * dimension is clamped to the grid separately, so an event on the upper edge
+ * of any dimension goes to the last box along that dimension.
+ *
+ * @param event :: event within the extents of this box
+ * @return the index into the children of this grid box
+ */
+TMDE(size_t MDGridBox)::getChildIndexFromEvent(const MDE &event) const {
+  size_t cindex(0);
+  for (size_t d = 0; d < nd; d++) {
+    const double position =
+        (event.getCenter(d) - this->extents[d].getMin()) / m_SubBoxSize[d];
+    // Written so that a NaN position (zero-width box) goes to the first box
+    size_t i(0);
+    if (position >= static_cast<double>(split[d]))
+      i = split[d] - 1;
+    else if (position > 0.)
+      i = static_cast<size_t>(position);
+    cindex += i * splitCumul[d];
+  }
+  return cindex;
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Goes through all the sub-boxes and splits them if they contain
  * enough events to be worth it.
@@ -1294,6 +1346,166 @@ TMDE(void MDGridBox)::integrateSphere(
   delete[] boxMightTouch;
 }
 
+//-----------------------------------------------------------------------------------------------
+/** Integrate the signal within several spheres or spherical shells in one
+ * traversal of the boxes; for example, to integrate all the peaks of a
+ * single-crystal run.
+ *
+ * Each sphere only looks at the children within its radius plus a box
+ * diagonal of its center, found from the extents of the children. Each of
+ * those is tested as in integrateSphere: it is fully contained if all its
+ * vertices are, and is otherwise integrated in detail if it might touch the
+ * sphere. Each child is then visited once for all the spheres touching it.
+ *
+ * @param spheres :: the spheres to integrate in
+ * @param indices :: indices into spheres of the spheres to integrate in
+ * @param[out] signal :: the integrated signal of the sphere given by each
+ *        index is added to signal[i]
+ * @param[out] errorSquared :: the integrated squared error of the sphere given
+ *        by each index is added to errorSquared[i]
+ * @param useOnePercentBackgroundCorrection :: remove the top 1% of the events
+ *        of each box in a spherical shell, as in integrateSphere
+ * @param parallel :: if true, the children are integrated in parallel
+ */
+TMDE(void MDGridBox)::integrateSpheres(
+    const std::vector<MDIntegrationSphere> &spheres,
+    const std::vector<size_t> &indices, signal_t *signal,
+    signal_t *errorSquared, const bool useOnePercentBackgroundCorrection,
+    const bool parallel) const {
+  // How many vertices does one box have? 2^nd, or bitwise shift left 1 by nd
+  // bits
+  const size_t maxVertices = 1 << nd;
+
+  // set up caches for box sizes and min box values
+  coord_t boxSize[nd];
+  coord_t minBoxVal[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    boxSize[d] = static_cast<coord_t>(m_SubBoxSize[d]);
+    minBoxVal[d] = static_cast<coord_t>(this->extents[d].getMin());
+  }
+  const coord_t diagonal = std::sqrt(diagonalSquared);
+
+  // The children each sphere might partly touch, as pairs of the index of
+  // the child and the position of the sphere in indices
+  std::vector<std::pair<size_t, size_t>> touching;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const auto &sphere = spheres[indices[i]];
+    const API::CoordTransform &radiusTransform = *sphere.radiusTransform;
+
+    // Range of the children which might touch the sphere in each dimension
+    const coord_t reach = std::sqrt(sphere.radiusSquared) + diagonal;
+    size_t first[nd];
+    size_t end[nd];
+    bool outside = false;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t low =
+          (sphere.center[d] - reach - minBoxVal[d]) / boxSize[d];
+      const coord_t high =
+          (sphere.center[d] + reach - minBoxVal[d]) / boxSize[d];
+      if (!(high >= 0) || !(low < static_cast<coord_t>(split[d]))) {
+        outside = true;
+        break;
+      }
+      first[d] = low > 0 ? static_cast<size_t>(low) : 0;
+      end[d] = std::min(split[d], static_cast<size_t>(high) + 1);
+    }
+    if (outside)
+      continue;
+
+    size_t childIndex[nd];
+    std::copy(first, first + nd, childIndex);
+    bool allDone = false;
+    while (!allDone) {
+      // Count the vertices of the child contained in the integration volume
+      size_t verticesContained = 0;
+      for (size_t vertex = 0; vertex < maxVertices; ++vertex) {
+        coord_t vertexCoord[nd];
+        for (size_t d = 0; d < nd; ++d)
+          vertexCoord[d] =
+              static_cast<coord_t>(childIndex[d] + ((vertex >> d) & 1)) *
+                  boxSize[d] +
+              minBoxVal[d];
+        coord_t out[nd];
+        radiusTransform.apply(vertexCoord, out);
+        if (out[0] < sphere.radiusSquared &&
+            out[0] > sphere.innerRadiusSquared)
+          ++verticesContained;
+      }
+
+      const size_t linearIndex = getLinearIndex(childIndex);
+      const API::IMDNode *box = m_Children[linearIndex];
+      if (verticesContained >= maxVertices) {
+        // Use the integrated sum of signal in the box
+        signal[i] += box->getSignal();
+        errorSquared[i] += box->getErrorSquared();
+      } else if (verticesContained > 0) {
+        touching.emplace_back(linearIndex, i);
+      } else {
+        // There is a chance that this part of the box is within integration
+        // volume, even if no vertex of it is.
+        coord_t boxCenter[nd];
+        box->getCenter(boxCenter);
+        coord_t out[nd];
+        radiusTransform.apply(boxCenter, out);
+        if (out[0] < diagonalSquared * 0.72 + sphere.radiusSquared ||
+            out[0] < diagonalSquared * 0.72 + sphere.innerRadiusSquared)
+          touching.emplace_back(linearIndex, i);
+      }
+
+      // Move on to the next child in the range
+      allDone = true;
+      for (size_t d = 0; d < nd; ++d) {
+        if (++childIndex[d] < end[d]) {
+          allDone = false;
+          break;
+        }
+        childIndex[d] = first[d];
+      }
+    }
+  }
+  if (touching.empty())
+    return;
+
+  // Group the spheres by child, keeping their order within each child
+  std::stable_sort(touching.begin(), touching.end(),
+                   [](const std::pair<size_t, size_t> &a,
+                      const std::pair<size_t, size_t> &b) {
+                     return a.first < b.first;
+                   });
+  std::vector<size_t> groupStarts;
+  for (size_t j = 0; j < touching.size(); ++j)
+    if (j == 0 || touching[j].first != touching[j - 1].first)
+      groupStarts.emplace_back(j);
+  groupStarts.emplace_back(touching.size());
+
+  // Each child adds to sums of its own, so the children can be integrated in
+  // parallel and the sums added up in a fixed order
+  std::vector<signal_t> childSignal(touching.size(), 0);
+  std::vector<signal_t> childErrorSquared(touching.size(), 0);
+  const auto numGroups = static_cast<int64_t>(groupStarts.size() - 1);
+  std::exception_ptr error;
+  PARALLEL_FOR_IF_DYNAMIC(parallel, 1)
+  for (int64_t group = 0; group < numGroups; ++group) {
+    PARALLEL_START_EXCEPTION_REGION
+    const size_t begin = groupStarts[group];
+    const size_t groupEnd = groupStarts[group + 1];
+    std::vector<size_t> childIndices;
+    childIndices.reserve(groupEnd - begin);
+    for (size_t j = begin; j < groupEnd; ++j)
+      childIndices.emplace_back(indices[touching[j].second]);
+    m_Children[touching[begin].first]->integrateSpheres(
+        spheres, childIndices, childSignal.data() + begin,
+        childErrorSquared.data() + begin, useOnePercentBackgroundCorrection,
+        false);
+    PARALLEL_END_EXCEPTION_REGION(error)
+  }
+  PARALLEL_CHECK_EXCEPTION_REGION(error)
+  for (size_t j = 0; j < touching.size(); ++j) {
+    signal[touching[j].second] += childSignal[j];
+    errorSquared[touching[j].second] += childErrorSquared[j];
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /** Find the centroid of all events contained within by doing a weighted average
  * of their coordinates.
@@ -1729,8 +1941,7 @@ TMDE(inline size_t MDGridBox)::addEventUnsafe(const MDE &event) {
  *children
  *@param newChild  -- the pointer to the new child grid box
  */
-TMDE(inline void MDGridBox)::setChild(size_t index,
-                                      MDGridBox<MDE, nd> *newChild) {
+TMDE(void MDGridBox)::setChild(size_t index, MDGridBox<MDE, nd> *newChild) {
   // Delete the old box  (supposetly ungridded);
   delete this->m_Children[index];
   // set new box, supposetly gridded
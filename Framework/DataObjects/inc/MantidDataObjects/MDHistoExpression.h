@@ -0,0 +1,85 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** MDHistoExpression : records a chain of the arithmetic operations done one
+  at a time by PlusMD, MinusMD, MultiplyMD, DivideMD, LogarithmMD,
+  ExponentialMD and PowerMD on MDHistoWorkspaces and scalars, and evaluates
+  the chain in a single pass over the bins.
+
+  The bins are evaluated in blocks shared out to the threads. Every operation
+  is applied to a block before moving on to the next block, so the
+  intermediate results stay in cache and only the final workspace is
+  allocated. The signals, errors and numbers of events are propagated as by
+  the operations of MDHistoWorkspace.
+
+  Building an expression is cheap: the operands are shared, not copied, and
+  nothing is computed until evaluate() is called.
+*/
+class MANTID_DATAOBJECTS_DLL MDHistoExpression {
+public:
+  MDHistoExpression(MDHistoWorkspace_const_sptr workspace);
+  MDHistoExpression(const signal_t signal, const signal_t error = 0.0);
+
+  MDHistoExpression log(const double filler = 0.0) const;
+  MDHistoExpression log10(const double filler = 0.0) const;
+  MDHistoExpression exp() const;
+  MDHistoExpression power(const double exponent) const;
+
+  MDHistoWorkspace_sptr evaluate() const;
+
+  friend MANTID_DATAOBJECTS_DLL MDHistoExpression
+  operator+(const MDHistoExpression &lhs, const MDHistoExpression &rhs);
+  friend MANTID_DATAOBJECTS_DLL MDHistoExpression
+  operator-(const MDHistoExpression &lhs, const MDHistoExpression &rhs);
+  friend MANTID_DATAOBJECTS_DLL MDHistoExpression
+  operator*(const MDHistoExpression &lhs, const MDHistoExpression &rhs);
+  friend MANTID_DATAOBJECTS_DLL MDHistoExpression
+  operator/(const MDHistoExpression &lhs, const MDHistoExpression &rhs);
+
+private:
+  /// Operations that can be recorded
+  enum class Operation {
+    Workspace,
+    Scalar,
+    Plus,
+    Minus,
+    Multiply,
+    Divide,
+    Log,
+    Log10,
+    Exp,
+    Power
+  };
+
+  struct Node;
+  struct Instruction;
+
+  MDHistoExpression(const Operation operation, const MDHistoExpression &lhs,
+                    const MDHistoExpression *rhs, const double parameter);
+
+  static size_t compile(const Node &node, std::vector<Instruction> &program);
+  static void execute(const std::vector<Instruction> &program,
+                      const size_t begin, const size_t count, signal_t *stack,
+                      signal_t *signal, signal_t *errorSquared,
+                      signal_t *numEvents);
+
+  /// Root of the tree of recorded operations
+  std::shared_ptr<const Node> m_node;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
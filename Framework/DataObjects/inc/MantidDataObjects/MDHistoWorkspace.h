@@ -11,12 +11,16 @@
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidAPI/MDGeometry.h"
 #include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/SparseTileArray.h"
 #include "MantidDataObjects/WorkspaceSingleValue.h"
 #include "MantidGeometry/MDGeometry/IMDDimension.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
 #include "MantidGeometry/MDGeometry/MDImplicitFunction.h"
 #include "MantidKernel/Exception.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Mantid {
 namespace DataObjects {
 
@@ -49,10 +53,12 @@ public:
   MDHistoWorkspace(
       std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
       Mantid::API::MDNormalization displayNormalization =
-          Mantid::API::NoNormalization);
+          Mantid::API::NoNormalization,
+      const bool sparse = false);
   MDHistoWorkspace(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
                    Mantid::API::MDNormalization displayNormalization =
-                       Mantid::API::NoNormalization);
+                       Mantid::API::NoNormalization,
+                   const bool sparse = false);
   MDHistoWorkspace &operator=(const MDHistoWorkspace &other) = delete;
 
   /// Returns a clone of the workspace
@@ -65,8 +71,10 @@ public:
     return std::unique_ptr<MDHistoWorkspace>(doCloneEmpty());
   }
 
-  void init(std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions);
-  void init(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions);
+  void init(std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
+            const bool sparse = false);
+  void init(std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
+            const bool sparse = false);
 
   void cacheValues();
 
@@ -143,7 +151,10 @@ public:
   const size_t *getIndexMultiplier() const { return indexMultiplier.data(); }
 
   /** @return the direct pointer to the signal array. For speed */
-  const signal_t *getSignalArray() const override { return m_signals.data(); }
+  const signal_t *getSignalArray() const override {
+    makeDense();
+    return m_signals.data();
+  }
 
   /** @return the inverse of volume of EACH cell in the workspace. For
    * normalizing. */
@@ -151,18 +162,23 @@ public:
 
   /** @return the direct pointer to the error squared array. For speed */
   const signal_t *getErrorSquaredArray() const override {
+    makeDense();
     return m_errorsSquared.data();
   }
 
   /** @return the direct pointer to the array of the number of events. For speed
    */
   const signal_t *getNumEventsArray() const override {
+    makeDense();
     return m_numEvents.data();
   }
 
   /** @return the direct pointer to the array of mask bits (bool). For
    * speed/testing */
-  const bool *getMaskArray() const { return m_masks.get(); }
+  const bool *getMaskArray() const {
+    makeDense();
+    return m_masks.get();
+  }
 
   /** Return the aray of bin withs  (the linear length of a box) for each
    * dimension */
@@ -170,21 +186,31 @@ public:
 
   /** @return the direct pointer to the signal array. For speed. non-const
    * version */
-  signal_t *mutableSignalArray() override { return m_signals.data(); }
+  signal_t *mutableSignalArray() override {
+    makeDense();
+    return m_signals.data();
+  }
 
   /** @return the direct pointer to the errors array. For speed. non-const
    * version */
   signal_t *mutableErrorSquaredArray() override {
+    makeDense();
     return m_errorsSquared.data();
   }
 
   /** @return the direct pointer to the errors array. For speed. non-const
    * version */
-  signal_t *mutableNumEventsArray() override { return m_numEvents.data(); }
+  signal_t *mutableNumEventsArray() override {
+    makeDense();
+    return m_numEvents.data();
+  }
 
   /** @return the direct pointer to the array of mask bits (bool). For
    * speed/testing */
-  bool *mutableMaskArray() { return m_masks.get(); }
+  bool *mutableMaskArray() {
+    makeDense();
+    return m_masks.get();
+  }
 
   /// Get the special coordinate system.
   Kernel::SpecialCoordinateSystem getSpecialCoordinateSystem() const override;
@@ -217,98 +243,115 @@ public:
 
   /// Sets the signal at the specified index.
   void setSignalAt(size_t index, signal_t value) override {
-    m_signals[index] = value;
+    if (m_sparse)
+      m_sparseSignals.set(index, value);
+    else
+      m_signals[index] = value;
   }
 
   /// Sets the error (squared) at the specified index.
   void setErrorSquaredAt(size_t index, signal_t value) override {
-    m_errorsSquared[index] = value;
+    if (m_sparse)
+      m_sparseErrorsSquared.set(index, value);
+    else
+      m_errorsSquared[index] = value;
   }
 
   /// Sets the number of contributing events in the bin at the specified index.
   void setNumEventsAt(size_t index, signal_t value) {
-    m_numEvents[index] = value;
+    if (m_sparse)
+      m_sparseNumEvents.set(index, value);
+    else
+      m_numEvents[index] = value;
   }
 
   /// Returns the number of contributing events from the bin at the specified
   /// index.
-  signal_t getNumEventsAt(size_t index) const { return m_numEvents[index]; }
+  signal_t getNumEventsAt(size_t index) const {
+    return m_sparse ? m_sparseNumEvents.get(index) : m_numEvents[index];
+  }
 
   /// Get the error of the signal at the specified index.
   signal_t getErrorAt(size_t index) const override {
-    return std::sqrt(m_errorsSquared[index]);
+    return std::sqrt(storedErrorSquared(index));
   }
 
   /// Get the error at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t)
   signal_t getErrorAt(size_t index1, size_t index2) const override {
-    return std::sqrt(m_errorsSquared[index1 + indexMultiplier[0] * index2]);
+    return std::sqrt(storedErrorSquared(index1 + indexMultiplier[0] * index2));
   }
 
   /// Get the error at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t)
   signal_t getErrorAt(size_t index1, size_t index2,
                       size_t index3) const override {
-    return std::sqrt(m_errorsSquared[index1 + indexMultiplier[0] * index2 +
-                                     indexMultiplier[1] * index3]);
+    return std::sqrt(storedErrorSquared(index1 + indexMultiplier[0] * index2 +
+                                        indexMultiplier[1] * index3));
   }
 
   /// Get the error at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t)
   signal_t getErrorAt(size_t index1, size_t index2, size_t index3,
                       size_t index4) const override {
-    return std::sqrt(m_errorsSquared[index1 + indexMultiplier[0] * index2 +
-                                     indexMultiplier[1] * index3 +
-                                     indexMultiplier[2] * index4]);
+    return std::sqrt(storedErrorSquared(index1 + indexMultiplier[0] * index2 +
+                                        indexMultiplier[1] * index3 +
+                                        indexMultiplier[2] * index4));
   }
 
   /**
   Getter for the masking at a specified linear index.
   */
-  bool getIsMaskedAt(size_t index) const { return m_masks[index]; }
+  bool getIsMaskedAt(size_t index) const {
+    return m_sparse ? m_sparseMasks.get(index) : m_masks[index];
+  }
 
   /// Get the signal at the specified index.
-  signal_t getSignalAt(size_t index) const override { return m_signals[index]; }
+  signal_t getSignalAt(size_t index) const override {
+    return storedSignal(index);
+  }
 
   /// Get the signal at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t)
   signal_t getSignalAt(size_t index1, size_t index2) const override {
-    return m_signals[index1 + indexMultiplier[0] * index2];
+    return storedSignal(index1 + indexMultiplier[0] * index2);
   }
 
   /// Get the signal at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t)
   signal_t getSignalAt(size_t index1, size_t index2,
                        size_t index3) const override {
-    return m_signals[index1 + indexMultiplier[0] * index2 +
-                     indexMultiplier[1] * index3];
+    return storedSignal(index1 + indexMultiplier[0] * index2 +
+                        indexMultiplier[1] * index3);
   }
 
   /// Get the signal at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t)
   signal_t getSignalAt(size_t index1, size_t index2, size_t index3,
                        size_t index4) const override {
-    return m_signals[index1 + indexMultiplier[0] * index2 +
-                     indexMultiplier[1] * index3 + indexMultiplier[2] * index4];
+    return storedSignal(index1 + indexMultiplier[0] * index2 +
+                        indexMultiplier[1] * index3 +
+                        indexMultiplier[2] * index4);
   }
 
   /// Get the signal at the specified index, normalized by cell volume
   signal_t getSignalNormalizedAt(size_t index) const override {
-    return m_signals[index] * m_inverseVolume;
+    return storedSignal(index) * m_inverseVolume;
   }
 
   /// Get the signal at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t), normalized by cell volume
   signal_t getSignalNormalizedAt(size_t index1, size_t index2) const override {
-    return m_signals[index1 + indexMultiplier[0] * index2] * m_inverseVolume;
+    return storedSignal(index1 + indexMultiplier[0] * index2) *
+           m_inverseVolume;
   }
 
   /// Get the signal at the specified index given in 4 dimensions (typically
   /// X,Y,Z,t), normalized by cell volume
   signal_t getSignalNormalizedAt(size_t index1, size_t index2,
                                  size_t index3) const override {
-    return m_signals[index1 + indexMultiplier[0] * index2 +
-                     indexMultiplier[1] * index3] *
+    return storedSignal(index1 + indexMultiplier[0] * index2 +
+                        indexMultiplier[1] * index3) *
            m_inverseVolume;
   }
 
@@ -316,16 +359,16 @@ public:
   /// X,Y,Z,t), normalized by cell volume
   signal_t getSignalNormalizedAt(size_t index1, size_t index2, size_t index3,
                                  size_t index4) const override {
-    return m_signals[index1 + indexMultiplier[0] * index2 +
-                     indexMultiplier[1] * index3 +
-                     indexMultiplier[2] * index4] *
+    return storedSignal(index1 + indexMultiplier[0] * index2 +
+                        indexMultiplier[1] * index3 +
+                        indexMultiplier[2] * index4) *
            m_inverseVolume;
   }
 
   /// Get the error of the signal at the specified index, normalized by cell
   /// volume
   signal_t getErrorNormalizedAt(size_t index) const override {
-    return std::sqrt(m_errorsSquared[index]) * m_inverseVolume;
+    return std::sqrt(storedErrorSquared(index)) * m_inverseVolume;
   }
 
   /// Get the signal at the specified index given in 4 dimensions (typically
@@ -353,7 +396,8 @@ public:
    * @param index :: linear index (see getLinearIndex).  */
   signal_t &errorSquaredAt(size_t index) override {
     if (index < m_length)
-      return m_errorsSquared[index];
+      return m_sparse ? m_sparseErrorsSquared.at(index)
+                      : m_errorsSquared[index];
     else
       throw std::invalid_argument("MDHistoWorkspace::array index out of range");
   }
@@ -362,7 +406,7 @@ public:
    * @param index :: linear index (see getLinearIndex).  */
   signal_t &signalAt(size_t index) override {
     if (index < m_length)
-      return m_signals[index];
+      return m_sparse ? m_sparseSignals.at(index) : m_signals[index];
     else
       throw std::invalid_argument("MDHistoWorkspace::array index out of range");
   }
@@ -409,7 +453,7 @@ public:
    */
   signal_t &operator[](const size_t &index) override {
     if (index < m_length)
-      return m_signals[index];
+      return m_sparse ? m_sparseSignals.at(index) : m_signals[index];
     else
       throw std::invalid_argument("MDHistoWorkspace::array index out of range");
   }
@@ -446,6 +490,11 @@ public:
   /// Return if this workspace is a MDHistoWorkspace. Will always return true.
   bool isMDHistoWorkspace() const override { return true; }
 
+  void setSparse(const bool sparse);
+  /// @return true if the bins are stored in tiles allocated on first write
+  bool isSparse() const { return m_sparse; }
+  size_t skipEmptyTiles(const size_t index) const;
+
 private:
   MDHistoWorkspace *doClone() const override {
     return new MDHistoWorkspace(*this);
@@ -460,17 +509,45 @@ private:
 
   void initVertexesArray();
 
+  void makeDense() const;
+  void freeSparseStorage() const;
+  static signal_t emptyValue(const std::vector<signal_t> &values);
+
+  /// Signal at a linear index, from the dense or the sparse storage
+  signal_t storedSignal(const size_t index) const {
+    return m_sparse ? m_sparseSignals.get(index) : m_signals[index];
+  }
+
+  /// Error squared at a linear index, from the dense or the sparse storage
+  signal_t storedErrorSquared(const size_t index) const {
+    return m_sparse ? m_sparseErrorsSquared.get(index)
+                    : m_errorsSquared[index];
+  }
+
   /// Number of dimensions in this workspace
   size_t numDimensions;
 
-  /// Linear array of signals for each bin
-  std::vector<signal_t> m_signals;
+  /// Linear array of signals for each bin. Mutable so that the direct
+  /// pointers to the arrays can switch back to the dense storage
+  mutable std::vector<signal_t> m_signals;
 
   /// Linear array of errors for each bin
-  std::vector<signal_t> m_errorsSquared;
+  mutable std::vector<signal_t> m_errorsSquared;
 
   /// Number of contributing events for each bin.
-  std::vector<signal_t> m_numEvents;
+  mutable std::vector<signal_t> m_numEvents;
+
+  /// True when the bins are held by the sparse arrays below instead of the
+  /// dense arrays
+  mutable std::atomic<bool> m_sparse{false};
+  /// Sparse storage of the signals, errors, numbers of events and masks
+  mutable SparseTileArray<signal_t> m_sparseSignals;
+  mutable SparseTileArray<signal_t> m_sparseErrorsSquared;
+  mutable SparseTileArray<signal_t> m_sparseNumEvents;
+  mutable SparseTileArray<bool> m_sparseMasks;
+  /// Guards switching from the sparse to the dense storage, which frees the
+  /// tiles
+  mutable std::mutex m_sparseMutex;
 
   /// Length of the m_signals / m_errorsSquared arrays.
   size_t m_length;
@@ -522,7 +599,7 @@ protected:
 
   /// Linear array of masks for each bin. Avoids using vector<bool>
   /// due to performance concerns.
-  std::unique_ptr<bool[]> m_masks;
+  mutable std::unique_ptr<bool[]> m_masks;
 };
 
 /// A shared pointer to a MDHistoWorkspace
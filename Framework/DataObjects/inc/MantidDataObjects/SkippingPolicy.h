@@ -22,6 +22,12 @@ namespace DataObjects {
 class DLLExport SkippingPolicy {
 public:
   virtual bool keepGoing() const = 0;
+  /**
+  Whether the iterator may jump over the tiles of a sparse MDHistoWorkspace
+  that hold no data.
+  @return True to skip the empty tiles.
+  */
+  virtual bool skipEmptyTiles() const { return false; }
   virtual ~SkippingPolicy() = default;
 };
 
@@ -40,6 +46,22 @@ public:
   bool keepGoing() const override { return m_iterator->getIsMasked(); };
 };
 
+/// Policy that indicates skipping of the tiles of bins of a sparse
+/// MDHistoWorkspace that hold no data. Other bins are not skipped.
+class DLLExport SkipEmptyTiles : public SkippingPolicy {
+public:
+  /**
+  Always returns false: bins are only skipped a tile at a time.
+  @return false to cancel continuation
+  */
+  bool keepGoing() const override { return false; }
+  /**
+  Always returns true to jump over the empty tiles.
+  @return true to skip the empty tiles
+  */
+  bool skipEmptyTiles() const override { return true; }
+};
+
 /// Policy that indicates no skipping should be applied.
 class DLLExport SkipNothing : public SkippingPolicy {
 public:
@@ -0,0 +1,186 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** SparseTileArray : a linear array of values stored in tiles of TILE_SIZE
+  consecutive values. A tile is only allocated when one of its values is set
+  to something other than the fill value of the array; the values of the
+  tiles that are not allocated are the fill value.
+
+  Used by MDHistoWorkspace to hold the bins of mostly empty grids. As with a
+  std::vector, different values may be set from different threads, as long as
+  no two threads allocate the same tile at once.
+*/
+template <typename T> class SparseTileArray {
+public:
+  /// Number of values in a tile
+  static constexpr size_t TILE_SIZE = 4096;
+
+  SparseTileArray() = default;
+  SparseTileArray(const SparseTileArray &other);
+  SparseTileArray &operator=(const SparseTileArray &other);
+  SparseTileArray(SparseTileArray &&) noexcept = default;
+  SparseTileArray &operator=(SparseTileArray &&) noexcept = default;
+
+  void assign(const size_t size, const T fill);
+  void assign(const T *values, const size_t size, const T fill);
+  void copyTo(T *values) const;
+
+  /// @return the number of values in the array
+  size_t size() const { return m_size; }
+  /// @return the value of the values that are not stored
+  T fill() const { return m_fill; }
+  /// @return the number of tiles covering the array
+  size_t numTiles() const { return m_tiles.size(); }
+  size_t numStoredTiles() const;
+  size_t getMemorySize() const;
+
+  /** @return the values of a tile, or nullptr if it is not allocated
+   * @param tile :: index of the tile  */
+  const T *tile(const size_t tile) const { return m_tiles[tile].get(); }
+
+  /** @return true if the tile holding a value is allocated
+   * @param index :: index of the value  */
+  bool isStored(const size_t index) const {
+    return static_cast<bool>(m_tiles[index / TILE_SIZE]);
+  }
+
+  /** @return the value at an index
+   * @param index :: index of the value  */
+  T get(const size_t index) const {
+    const auto &tile = m_tiles[index / TILE_SIZE];
+    return tile ? tile[index % TILE_SIZE] : m_fill;
+  }
+
+  /** Set the value at an index, allocating its tile unless the value is the
+   * fill value
+   * @param index :: index of the value
+   * @param value :: new value  */
+  void set(const size_t index, const T value) {
+    auto &tile = m_tiles[index / TILE_SIZE];
+    if (!tile) {
+      if (isFill(value))
+        return;
+      tile = newTile();
+    }
+    tile[index % TILE_SIZE] = value;
+  }
+
+  /** @return a reference to the value at an index, allocating its tile
+   * @param index :: index of the value  */
+  T &at(const size_t index) {
+    auto &tile = m_tiles[index / TILE_SIZE];
+    if (!tile)
+      tile = newTile();
+    return tile[index % TILE_SIZE];
+  }
+
+private:
+  /// Compare the bits, so that a NaN fill value is recognised
+  bool isFill(const T &value) const {
+    return std::memcmp(&value, &m_fill, sizeof(T)) == 0;
+  }
+
+  std::unique_ptr<T[]> newTile() const {
+    std::unique_ptr<T[]> tile(new T[TILE_SIZE]);
+    std::fill_n(tile.get(), TILE_SIZE, m_fill);
+    return tile;
+  }
+
+  /// Number of values in the array
+  size_t m_size = 0;
+  /// Value of the values in the tiles that are not allocated
+  T m_fill = T();
+  /// Tiles of values, null when not allocated
+  std::vector<std::unique_ptr<T[]>> m_tiles;
+};
+
+template <typename T>
+SparseTileArray<T>::SparseTileArray(const SparseTileArray &other)
+    : m_size(other.m_size), m_fill(other.m_fill), m_tiles(other.numTiles()) {
+  for (size_t t = 0; t < m_tiles.size(); ++t) {
+    if (other.m_tiles[t]) {
+      m_tiles[t].reset(new T[TILE_SIZE]);
+      std::copy_n(other.m_tiles[t].get(), TILE_SIZE, m_tiles[t].get());
+    }
+  }
+}
+
+template <typename T>
+SparseTileArray<T> &
+SparseTileArray<T>::operator=(const SparseTileArray &other) {
+  if (this != &other)
+    *this = SparseTileArray(other);
+  return *this;
+}
+
+/** Resize the array and set all of its values to the fill value, freeing the
+ * tiles
+ * @param size :: number of values
+ * @param fill :: value of all the values  */
+template <typename T>
+void SparseTileArray<T>::assign(const size_t size, const T fill) {
+  m_size = size;
+  m_fill = fill;
+  m_tiles.clear();
+  m_tiles.resize((size + TILE_SIZE - 1) / TILE_SIZE);
+}
+
+/** Copy the values of a dense array, allocating only the tiles holding
+ * values other than the fill value
+ * @param values :: array of size values
+ * @param size :: number of values
+ * @param fill :: value of the values that are not stored  */
+template <typename T>
+void SparseTileArray<T>::assign(const T *values, const size_t size,
+                                const T fill) {
+  assign(size, fill);
+  for (size_t t = 0; t < m_tiles.size(); ++t) {
+    const T *begin = values + t * TILE_SIZE;
+    const T *end = values + std::min(size, (t + 1) * TILE_SIZE);
+    if (std::all_of(begin, end, [this](const T &v) { return isFill(v); }))
+      continue;
+    m_tiles[t] = newTile();
+    std::copy(begin, end, m_tiles[t].get());
+  }
+}
+
+/** Copy all the values to a dense array
+ * @param values :: array of size() values  */
+template <typename T> void SparseTileArray<T>::copyTo(T *values) const {
+  for (size_t t = 0; t < m_tiles.size(); ++t) {
+    const size_t count = std::min(TILE_SIZE, m_size - t * TILE_SIZE);
+    if (m_tiles[t])
+      std::copy_n(m_tiles[t].get(), count, values + t * TILE_SIZE);
+    else
+      std::fill_n(values + t * TILE_SIZE, count, m_fill);
+  }
+}
+
+/// @return the number of allocated tiles
+template <typename T> size_t SparseTileArray<T>::numStoredTiles() const {
+  return std::count_if(
+      m_tiles.cbegin(), m_tiles.cend(),
+      [](const std::unique_ptr<T[]> &tile) { return tile != nullptr; });
+}
+
+/// @return the memory used by the array, in bytes
+template <typename T> size_t SparseTileArray<T>::getMemorySize() const {
+  return numStoredTiles() * TILE_SIZE * sizeof(T) +
+         m_tiles.size() * sizeof(std::unique_ptr<T[]>);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,100 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/BinEdgeIndexer.h"
+
+#include <array>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Largest deviation of an edge from the fitted spacing, in units of bins,
+/// for the spacing to be used for the first guess
+constexpr double SPACING_TOLERANCE = 0.01;
+
+/** Check whether the transformed edges f(X[i]) lie on a straight line, all but
+ * the last one which may close a narrower bin (as Rebin produces when the
+ * range is not a whole number of steps).
+ * @param X :: the bin edges
+ * @param f :: the transform applied to each edge
+ * @param origin :: set to f(X[0])
+ * @param scale :: set to the inverse of the step in f
+ * @return true if the transformed edges are evenly spaced
+ */
+template <typename Transform>
+bool isEvenlySpaced(const MantidVec &X, const Transform &f, double &origin,
+                    double &scale) {
+  const size_t numFullEdges = X.size() > 2 ? X.size() - 1 : X.size();
+  origin = f(X.front());
+  const double step =
+      (f(X[numFullEdges - 1]) - origin) / static_cast<double>(numFullEdges - 1);
+  if (!(step > 0.) || !std::isfinite(step))
+    return false;
+  for (size_t i = 1; i < numFullEdges; ++i) {
+    const double expected = origin + static_cast<double>(i) * step;
+    if (std::abs(f(X[i]) - expected) > SPACING_TOLERANCE * step)
+      return false;
+  }
+  if (!(X.back() > X[numFullEdges - 1]) && numFullEdges != X.size())
+    return false;
+  scale = 1. / step;
+  return true;
+}
+
+/** The table used by BinEdgeIndexer::tableLog: the logarithms of the
+ * mantissas 1 + i / n at the start of each of the n intervals, followed by
+ * their inverses.
+ * @return the table, calculated on first use
+ */
+template <size_t n> const std::array<double, 2 * n> &logTable() {
+  static const std::array<double, 2 * n> table = [] {
+    std::array<double, 2 * n> values;
+    for (size_t i = 0; i < n; ++i) {
+      const double mantissa = 1. + static_cast<double>(i) / n;
+      values[i] = std::log(mantissa);
+      values[n + i] = 1. / mantissa;
+    }
+    return values;
+  }();
+  return table;
+}
+} // namespace
+
+/** Constructor. Inspects the bin edges to find their spacing.
+ * @param X :: the bin edges; must be sorted and outlive the indexer
+ */
+BinEdgeIndexer::BinEdgeIndexer(const MantidVec &X)
+    : m_edges(X), m_numBins(X.size() > 1 ? X.size() - 1 : 0),
+      m_spacing(Spacing::Arbitrary), m_origin(0.), m_scale(0.),
+      m_logTable(nullptr) {
+  if (m_numBins == 0)
+    return;
+  if (isEvenlySpaced(
+          X, [](const double x) { return x; }, m_origin, m_scale)) {
+    m_spacing = Spacing::Linear;
+  } else if (X.front() >= std::numeric_limits<double>::min() &&
+             isEvenlySpaced(
+                 X, [](const double x) { return std::log(x); }, m_origin,
+                 m_scale)) {
+    m_spacing = Spacing::Logarithmic;
+    m_logTable = logTable<LOG_TABLE_SIZE>().data();
+  }
+}
+
+/** Binary search of the edges, used for arbitrary bins.
+ * @param x :: a value in [X.front(), X.back())
+ * @return the index of the bin holding x
+ */
+size_t BinEdgeIndexer::searchEdges(const double x) const {
+  return static_cast<size_t>(
+             std::upper_bound(m_edges.cbegin(), m_edges.cend(), x) -
+             m_edges.cbegin()) -
+         1;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
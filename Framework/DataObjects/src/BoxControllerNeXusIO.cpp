@@ -32,7 +32,8 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
     : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc),
-      m_BlockStart(2, 0), m_BlockSize(2, 0), m_CoordSize(sizeof(coord_t)),
+      m_BlockStart(2, 0), m_BlockSize(2, 0), m_compressEvents(false),
+      m_CoordSize(sizeof(coord_t)),
       m_EventType(FatEvent), m_EventsVersion("1.0"),
       m_ReadConversion(noConversion) {
   m_BlockSize[1] = 4 + m_bc->getNDims();
@@ -222,14 +223,17 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
     // Now the chunk size.
     std::vector<int64_t> chunk(m_BlockSize);
     chunk[0] = static_cast<int64_t>(m_dataChunk);
+    // The chunks are compressed independently and HDF5 indexes them, so any
+    // block of events can still be read or rewritten without the others
+    const auto compression = m_compressEvents ? ::NeXus::LZW : ::NeXus::NONE;
 
     // Make and open the data
     if (m_CoordSize == 4)
       m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
     else
       m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize,
-                           ::NeXus::NONE, chunk, true);
+                           compression, chunk, true);
 
     // A little bit of description for humans to read later
     m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
@@ -470,6 +474,8 @@ void BoxControllerNeXusIO::flushData() const {
 /** flush disk buffer data from memory and close underlying NeXus file*/
 void BoxControllerNeXusIO::closeFile() {
   if (m_File) {
+    // stop loading boxes ahead before the file goes away
+    this->cancelPrefetch();
     // write all file-backed data still stack in the data buffer into the file.
     this->flushCache();
     // lock file
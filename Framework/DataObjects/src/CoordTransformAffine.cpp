@@ -16,6 +16,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
 using Mantid::API::CoordTransform;
@@ -283,6 +285,38 @@ void CoordTransformAffine::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a batch of points, stored one
+ * dimension after the other (see CoordTransform::applyBatch). Each output
+ * dimension is built up one input dimension at a time, so the inner loops run
+ * over contiguous coordinates and vectorize. The terms are summed in the same
+ * order as in apply(), so that both give exactly the same points.
+ *
+ * @param inputVectors :: inD * numPoints input coordinates
+ * @param outVectors :: outD * numPoints output coordinates
+ * @param numPoints :: number of points to transform
+ */
+void CoordTransformAffine::applyBatch(const coord_t *inputVectors,
+                                      coord_t *outVectors,
+                                      const size_t numPoints) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *rawMatrixRow = m_rawMatrix[out];
+    coord_t *outValues = outVectors + out * numPoints;
+    std::fill(outValues, outValues + numPoints, coord_t(0.0));
+    for (size_t in = 0; in < inD; ++in) {
+      const coord_t factor = rawMatrixRow[in];
+      const coord_t *inValues = inputVectors + in * numPoints;
+      for (size_t i = 0; i < numPoints; ++i)
+        outValues[i] += factor * inValues[i];
+    }
+    // The last input coordinate is "1" always (made homogenous coordinate out
+    // of the input x,y,etc.)
+    const coord_t translation = rawMatrixRow[inD];
+    for (size_t i = 0; i < numPoints; ++i)
+      outValues[i] += translation;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
  *
@@ -112,6 +112,28 @@ void CoordTransformAligned::apply(const coord_t *inputVector,
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to a batch of points, stored one
+ * dimension after the other (see CoordTransform::applyBatch).
+ *
+ * @param inputVectors :: inD * numPoints input coordinates
+ * @param outVectors :: outD * numPoints output coordinates
+ * @param numPoints :: number of points to transform
+ */
+void CoordTransformAligned::applyBatch(const coord_t *inputVectors,
+                                       coord_t *outVectors,
+                                       const size_t numPoints) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *inValues =
+        inputVectors + m_dimensionToBinFrom[out] * numPoints;
+    coord_t *outValues = outVectors + out * numPoints;
+    const coord_t origin = m_origin[out];
+    const coord_t scaling = m_scaling[out];
+    for (size_t i = 0; i < numPoints; ++i)
+      outValues[i] = (inValues[i] - origin) * scaling;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
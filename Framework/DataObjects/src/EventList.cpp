@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataObjects/EventList.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataObjects/BinEdgeIndexer.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidDataObjects/Histogram1D.h"
 #include "MantidKernel/DateAndTime.h"
@@ -23,8 +24,10 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <array>
 #include <cfloat>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <stdexcept>
@@ -44,6 +47,16 @@ namespace {
 
 const double SEC_TO_NANO = 1.e9;
 
+/// The indexer of the bin edges an event list last histogrammed its events on
+/// with its own X on this thread, so that the spectra sharing their X find its
+/// spacing once. Holding the edges keeps them alive and unchanged, as a write
+/// to shared edges copies them first.
+struct CachedIndexer {
+  Kernel::cow_ptr<HistogramData::HistogramX> edges{nullptr};
+  std::unique_ptr<BinEdgeIndexer> indexer;
+};
+thread_local CachedIndexer cachedIndexer;
+
 /**
  * Calculate the corrected full time in nanoseconds
  * @param event : The event with pulse time and time-of-flight
@@ -89,6 +102,192 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Lists shorter than this are sorted with std::sort
+constexpr size_t RADIX_SORT_MIN_EVENTS = 256;
+
+/// Map a double onto an unsigned integer with the same ordering
+inline uint64_t orderedBits(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  constexpr uint64_t signBit = uint64_t(1) << 63;
+  return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+/// Map a signed integer onto an unsigned integer with the same ordering
+inline uint64_t orderedBits(const int64_t value) {
+  return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+/**
+ * Stable least-significant-digit radix sort of events on a 64 bit key, one
+ * byte per pass. The counts for every pass are gathered in a single sweep, and
+ * passes where all events share the same byte (e.g. the high bytes of the
+ * pulse times of one run) are skipped.
+ * @param events : The events to sort
+ * @param key : Returns the ordered 64 bit key of an event
+ */
+template <typename T, typename KeyFunc>
+void radixSort(std::vector<T> &events, const KeyFunc &key) {
+  constexpr size_t numPasses = sizeof(uint64_t);
+  constexpr size_t numBuckets = 256;
+  const size_t numEvents = events.size();
+  std::array<std::array<size_t, numBuckets>, numPasses> counts{};
+  for (const auto &event : events) {
+    const uint64_t k = key(event);
+    for (size_t pass = 0; pass < numPasses; ++pass)
+      ++counts[pass][(k >> (8 * pass)) & 0xFF];
+  }
+
+  std::vector<T> buffer;
+  for (size_t pass = 0; pass < numPasses; ++pass) {
+    auto &count = counts[pass];
+    if (std::any_of(count.cbegin(), count.cend(),
+                    [numEvents](const size_t c) { return c == numEvents; }))
+      continue;
+    if (buffer.empty())
+      buffer.resize(numEvents);
+    // Turn the counts into the first output position of each bucket
+    size_t offset = 0;
+    for (auto &c : count) {
+      const size_t bucketSize = c;
+      c = offset;
+      offset += bucketSize;
+    }
+    for (const auto &event : events)
+      buffer[count[(key(event) >> (8 * pass)) & 0xFF]++] = event;
+    events.swap(buffer);
+  }
+}
+
+/**
+ * Sort events with the algorithm best suited to the length of the list:
+ * std::sort for short lists, a radix sort on the integer keys for most lists
+ * and tbb::parallel_sort, splitting the work across threads, for very long
+ * ones.
+ * @param events : The events to sort
+ * @param compare : Comparison giving the requested order
+ * @param keys : Ordered 64 bit keys, least significant first, that together
+ * give the same order as compare
+ */
+template <typename T, typename Compare, typename... KeyFuncs>
+void sortEvents(std::vector<T> &events, const Compare &compare,
+                const KeyFuncs &... keys) {
+  if (events.size() < RADIX_SORT_MIN_EVENTS) {
+    std::sort(events.begin(), events.end(), compare);
+  } else if (events.size() < EventList::PARALLEL_SORT_MIN_EVENTS) {
+    (radixSort(events, keys), ...);
+  } else {
+    tbb::parallel_sort(events.begin(), events.end(), compare);
+  }
+}
+
+/// Key for sorting by time-of-flight
+template <typename T> uint64_t tofKey(const T &event) {
+  return orderedBits(event.tof());
+}
+
+/// Key for sorting by pulse time
+template <typename T> uint64_t pulseTimeKey(const T &event) {
+  return orderedBits(event.pulseTime().totalNanoseconds());
+}
+
+/**
+ * Full time (pulse time + time-of-flight) of each event in nanoseconds, as
+ * compared against matrix splitters. The correction is decided once for the
+ * whole list so that each loop is branch free and can be vectorised.
+ */
+template <typename EventType>
+std::vector<int64_t> fullTimes(const std::vector<EventType> &events,
+                               const bool docorrection, const double toffactor,
+                               const double tofshift) {
+  std::vector<int64_t> times(events.size());
+  if (docorrection) {
+    for (size_t i = 0; i < events.size(); ++i)
+      times[i] = events[i].pulseTime().totalNanoseconds() +
+                 static_cast<int64_t>(toffactor * events[i].tof() * 1000 +
+                                      tofshift * 1.0E9);
+  } else {
+    for (size_t i = 0; i < events.size(); ++i)
+      times[i] = events[i].pulseTime().totalNanoseconds() +
+                 static_cast<int64_t>(events[i].tof() * 1000);
+  }
+  return times;
+}
+
+/// Pulse time of each event in nanoseconds
+template <typename EventType>
+std::vector<int64_t> pulseTimes(const std::vector<EventType> &events) {
+  std::vector<int64_t> times(events.size());
+  for (size_t i = 0; i < events.size(); ++i)
+    times[i] = events[i].pulseTime().totalNanoseconds();
+  return times;
+}
+
+/**
+ * Index of the last splitter that starts at or before the given time,
+ * searching from splitter `first` onwards. Splitter i covers
+ * [splitTimes[i], splitTimes[i + 1]).
+ */
+size_t findSplitter(const std::vector<int64_t> &splitTimes, const size_t first,
+                    const int64_t time) {
+  const auto next =
+      std::upper_bound(splitTimes.cbegin() + first + 1, splitTimes.cend(), time);
+  return static_cast<size_t>(next - splitTimes.cbegin()) - 1;
+}
+
+/**
+ * The event lists that events are split into, looked up by group through a
+ * flat table rather than the map given by the caller.
+ */
+class SplitOutputs {
+public:
+  /// Destination of events that are not copied anywhere
+  static constexpr int DISCARD = -1;
+
+  explicit SplitOutputs(const std::map<int, EventList *> &outputs) {
+    if (outputs.empty())
+      return;
+    m_firstGroup = outputs.begin()->first;
+    m_lists.resize(
+        static_cast<size_t>(outputs.rbegin()->first - m_firstGroup) + 1);
+    for (const auto &output : outputs)
+      m_lists[output.first - m_firstGroup] = output.second;
+  }
+
+  /// @return the slot of a group, or DISCARD if the group has no output
+  int slot(const int group) const {
+    const auto index = static_cast<int64_t>(group) - m_firstGroup;
+    if (index < 0 || index >= static_cast<int64_t>(m_lists.size()) ||
+        !m_lists[index])
+      return DISCARD;
+    return static_cast<int>(index);
+  }
+
+  /**
+   * Copy each event to the output at its slot. The outputs are reserved for
+   * the events they receive before copying, so no output is reallocated
+   * while the events are added.
+   */
+  template <typename EventType>
+  void copy(const std::vector<EventType> &events,
+            const std::vector<int> &slots) const {
+    std::vector<size_t> counts(m_lists.size(), 0);
+    for (const int slot : slots)
+      if (slot != DISCARD)
+        ++counts[slot];
+    for (size_t i = 0; i < m_lists.size(); ++i)
+      if (counts[i] > 0)
+        m_lists[i]->reserve(m_lists[i]->getNumberEvents() + counts[i]);
+    for (size_t i = 0; i < events.size(); ++i)
+      if (slots[i] != DISCARD)
+        m_lists[slots[i]]->addEventQuickly(events[i]);
+  }
+
+private:
+  int64_t m_firstGroup{0};
+  std::vector<EventList *> m_lists;
+};
 } // namespace
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -126,12 +325,10 @@ struct comparePulseTimeTOFDelta {
       : startNano(start.totalNanoseconds()),
         deltaNano(static_cast<int64_t>(seconds * SEC_TO_NANO)) {}
 
-  bool operator()(const TofEvent &e1, const TofEvent &e2) {
+  bool operator()(const TofEvent &e1, const TofEvent &e2) const {
     // get the pulse times converted into bin number from start time
-    const int64_t e1Pulse =
-        (e1.pulseTime().totalNanoseconds() - startNano) / deltaNano;
-    const int64_t e2Pulse =
-        (e2.pulseTime().totalNanoseconds() - startNano) / deltaNano;
+    const int64_t e1Pulse = pulseBin(e1);
+    const int64_t e2Pulse = pulseBin(e2);
 
     // compare with the calculated bin information
     if (e1Pulse < e2Pulse) {
@@ -143,6 +340,11 @@ struct comparePulseTimeTOFDelta {
     return false;
   }
 
+  /// @return the number of the interval of pulse times holding an event
+  int64_t pulseBin(const TofEvent &e) const {
+    return (e.pulseTime().totalNanoseconds() - startNano) / deltaNano;
+  }
+
   int64_t startNano;
   int64_t deltaNano;
 };
@@ -212,6 +414,8 @@ EventList::~EventList() {
   //  EventWorkspaces.
   //  Therefore, for performance, they are kept commented:
   clear();
+  if (mru)
+    mru->unpin(this);
 
   // this->events.clear();
   // std::vector<TofEvent>().swap(events); //Trick to release the vector memory.
@@ -1005,14 +1209,15 @@ void EventList::sortTof() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end());
+    sortEvents(events, std::less<TofEvent>(), tofKey<TofEvent>);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end());
+    sortEvents(weightedEvents, std::less<WeightedEvent>(),
+               tofKey<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(),
-                       weightedEventsNoTime.end());
+    sortEvents(weightedEventsNoTime, std::less<WeightedEventNoTime>(),
+               tofKey<WeightedEventNoTime>);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -1077,11 +1282,11 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    sortEvents(events, compareEventPulseTime, pulseTimeKey<TofEvent>);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTime);
+    sortEvents(weightedEvents, compareEventPulseTime,
+               pulseTimeKey<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1107,11 +1312,12 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    sortEvents(events, compareEventPulseTimeTOF, tofKey<TofEvent>,
+               pulseTimeKey<TofEvent>);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(),
-                       compareEventPulseTimeTOF);
+    sortEvents(weightedEvents, compareEventPulseTimeTOF,
+               tofKey<WeightedEvent>, pulseTimeKey<WeightedEvent>);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1314,7 +1520,7 @@ MantidVec *EventList::makeDataY() const {
   auto Y = new MantidVec();
   MantidVec E;
   // Generate the Y histogram while skipping the E if possible.
-  generateHistogram(readX(), *Y, E, true);
+  generateHistogramOnOwnX(*Y, E, true);
   return Y;
 }
 
@@ -1326,7 +1532,7 @@ MantidVec *EventList::makeDataY() const {
 MantidVec *EventList::makeDataE() const {
   MantidVec Y;
   auto E = new MantidVec();
-  generateHistogram(readX(), Y, *E);
+  generateHistogramOnOwnX(Y, *E);
   // Y is unused.
   return E;
 }
@@ -1384,14 +1590,13 @@ Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
 
   // Is the data in the mrulist?
   if (mru) {
-    mru->ensureEnoughBuffersY(thread);
     yData = mru->findY(thread, this);
   }
 
   if (!yData) {
     MantidVec Y;
     MantidVec E;
-    this->generateHistogram(readX(), Y, E);
+    this->generateHistogramOnOwnX(Y, E);
 
     // Create the MRU object
     yData = Kernel::make_cow<HistogramData::HistogramY>(std::move(Y));
@@ -1400,7 +1605,6 @@ Kernel::cow_ptr<HistogramData::HistogramY> EventList::sharedY() const {
     if (mru) {
       mru->insertY(thread, yData, this);
       auto eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
-      mru->ensureEnoughBuffersE(thread);
       mru->insertE(thread, eData, this);
     }
   }
@@ -1414,7 +1618,6 @@ Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
 
   // Is the data in the mrulist?
   if (mru) {
-    mru->ensureEnoughBuffersE(thread);
     eData = mru->findE(thread, this);
   }
 
@@ -1422,7 +1625,7 @@ Kernel::cow_ptr<HistogramData::HistogramE> EventList::sharedE() const {
     // Now use that to get E -- Y values are generated from another function
     MantidVec Y_ignored;
     MantidVec E;
-    this->generateHistogram(readX(), Y_ignored, E);
+    this->generateHistogramOnOwnX(Y_ignored, E);
     eData = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
 
     // Lets save it in the MRU
@@ -1854,6 +2057,228 @@ void EventList::compressFatEvents(
   destination->clearUnused();
 }
 
+namespace {
+/// A compressed event with a different weight and error
+WeightedEventNoTime withWeight(const WeightedEventNoTime &event,
+                               const double weight,
+                               const double errorSquared) {
+  return WeightedEventNoTime(event.tof(), weight, errorSquared);
+}
+
+/// A compressed event with a different weight and error
+WeightedEvent withWeight(const WeightedEvent &event, const double weight,
+                         const double errorSquared) {
+  return WeightedEvent(event.tof(), event.pulseTime(), weight, errorSquared);
+}
+
+/** Merge newly compressed events into the end of a list of compressed events.
+ * Each new event is combined with the nearest event of the list that is in the
+ * same group and within the tolerance. The event of the list keeps its TOF and
+ * pulse time, so that adding blocks one after the other cannot move it away
+ * from the raw events it already holds; these stay within twice the tolerance
+ * of it. The other new events are inserted in order. The events of the list
+ * are never combined with each other.
+ *
+ * @param events :: compressed events, sorted by less.
+ * @param tail :: first event of events that may be combined with the new
+ *events. Only the events from tail onwards are copied.
+ * @param added :: newly compressed events, sorted by less.
+ * @param tolerance :: how close do two event's TOF have to be to be combined.
+ * @param less :: order of the events.
+ * @param sameGroup :: true if two events may be combined.
+ */
+template <class E, class Less, class SameGroup>
+void mergeCompressedEvents(std::vector<E> &events,
+                           const typename std::vector<E>::iterator tail,
+                           const std::vector<E> &added, const double tolerance,
+                           const Less &less, const SameGroup &sameGroup) {
+  std::vector<E> old(std::make_move_iterator(tail),
+                     std::make_move_iterator(events.end()));
+  events.erase(tail, events.end());
+  // The events of old to which the added events are combined
+  std::vector<size_t> target(added.size(), old.size());
+  std::vector<double> weights(old.size(), 0.), errors(old.size(), 0.);
+  size_t next = 0;
+  for (size_t i = 0; i < added.size(); ++i) {
+    const auto &event = added[i];
+    while (next < old.size() && less(old[next], event))
+      ++next;
+    double distance = tolerance;
+    const auto consider = [&](const size_t candidate) {
+      const double d = std::fabs(old[candidate].tof() - event.tof());
+      if (sameGroup(old[candidate], event) && d <= distance) {
+        target[i] = candidate;
+        distance = d;
+      }
+    };
+    if (next > 0)
+      consider(next - 1);
+    if (next < old.size())
+      consider(next);
+    if (target[i] < old.size()) {
+      weights[target[i]] += event.weight();
+      errors[target[i]] += event.errorSquared();
+    }
+  }
+
+  events.reserve(events.size() + old.size() + added.size());
+  size_t j = 0;
+  for (size_t i = 0; i < added.size(); ++i) {
+    if (target[i] < old.size())
+      continue;
+    for (; j < old.size() && !less(added[i], old[j]); ++j)
+      events.emplace_back(withWeight(old[j], old[j].weight() + weights[j],
+                                     old[j].errorSquared() + errors[j]));
+    events.emplace_back(added[i]);
+  }
+  for (; j < old.size(); ++j)
+    events.emplace_back(withWeight(old[j], old[j].weight() + weights[j],
+                                   old[j].errorSquared() + errors[j]));
+}
+} // namespace
+
+// --------------------------------------------------------------------------
+/** Compress events and add them to this list, combining them with the events
+ * it already holds. Used to compress events a block at a time while they are
+ * loaded, so that the uncompressed events never all have to be held at once.
+ * The event list is switched to WeightedEventNoTime.
+ *
+ * @param events :: the events to add; sorted by TOF and emptied, but their
+ *storage is kept so that it can be filled again.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same.
+ */
+template <class T>
+void EventList::compressAndAddEventsHelper(std::vector<T> &events,
+                                           const double tolerance) {
+  sortEvents(events, std::less<T>(), tofKey<T>);
+  std::vector<WeightedEventNoTime> compressed;
+  compressEventsHelper(events, compressed, tolerance);
+  events.clear();
+
+  if (this->empty()) {
+    weightedEventsNoTime.swap(compressed);
+  } else {
+    if (eventType != WEIGHTED_NOTIME)
+      this->compressEvents(tolerance, this);
+    // Both lists are sorted by TOF, so any event of the list may be near one
+    // of the new events.
+    mergeCompressedEvents(
+        weightedEventsNoTime, weightedEventsNoTime.begin(), compressed,
+        tolerance, std::less<WeightedEventNoTime>(),
+        [](const WeightedEventNoTime &, const WeightedEventNoTime &) {
+          return true;
+        });
+  }
+  eventType = WEIGHTED_NOTIME;
+  order = TOF_SORT;
+  clearUnused();
+}
+
+/** Compress TOF events and add them to this list, combining them with the
+ * events it already holds. See compressAndAddEventsHelper().
+ * @param events :: the events to add; emptied.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same.
+ */
+void EventList::compressAndAddEvents(std::vector<TofEvent> &events,
+                                     const double tolerance) {
+  compressAndAddEventsHelper(events, tolerance);
+}
+
+/** Compress weighted events and add them to this list, combining them with
+ * the events it already holds. See compressAndAddEventsHelper().
+ * @param events :: the events to add; emptied.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same.
+ */
+void EventList::compressAndAddEvents(std::vector<WeightedEvent> &events,
+                                     const double tolerance) {
+  compressAndAddEventsHelper(events, tolerance);
+}
+
+// --------------------------------------------------------------------------
+/** Compress events, keeping their pulse times within a given tolerance, and
+ * add them to this list, combining them with the events it already holds.
+ * The event list is switched to WeightedEvent.
+ *
+ * @param events :: the events to add; sorted and emptied, but their storage
+ *is kept so that it can be filled again.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same.
+ * @param timeStart :: start of the first interval of pulse times.
+ * @param seconds :: length of the intervals of pulse times, in seconds.
+ */
+template <class T>
+void EventList::compressFatAndAddEventsHelper(
+    std::vector<T> &events, const double tolerance,
+    const Types::Core::DateAndTime &timeStart, const double seconds) {
+  if (eventType == WEIGHTED_NOTIME && !this->empty())
+    throw std::invalid_argument(
+        "Cannot compress events that do not have pulsetime");
+  if (events.empty())
+    return;
+
+  const comparePulseTimeTOFDelta comparator(timeStart, seconds);
+  std::sort(events.begin(), events.end(), comparator);
+  std::vector<WeightedEvent> compressed;
+  compressFatEventsHelper(events, compressed, tolerance, timeStart, seconds);
+  events.clear();
+
+  if (this->empty()) {
+    weightedEvents.swap(compressed);
+  } else {
+    if (eventType == TOF)
+      this->compressFatEvents(tolerance, timeStart, seconds, this);
+    // The average pulse time of compressed events stays within their
+    // interval, so both lists are sorted the same way. Blocks of events are
+    // normally added in order of pulse time: only the events of the list in
+    // the intervals of the new events, at its end, are merged.
+    const int64_t firstBin = comparator.pulseBin(compressed.front());
+    const auto tail = std::partition_point(
+        weightedEvents.begin(), weightedEvents.end(),
+        [&comparator, firstBin](const WeightedEvent &event) {
+          return comparator.pulseBin(event) < firstBin;
+        });
+    mergeCompressedEvents(
+        weightedEvents, tail, compressed, tolerance, comparator,
+        [&comparator](const WeightedEvent &e1, const WeightedEvent &e2) {
+          return comparator.pulseBin(e1) == comparator.pulseBin(e2);
+        });
+  }
+  eventType = WEIGHTED;
+  order = PULSETIMETOF_SORT;
+  clearUnused();
+}
+
+/** Compress TOF events, keeping their pulse times within a given tolerance,
+ * and add them to this list. See compressFatAndAddEventsHelper().
+ * @param events :: the events to add; emptied.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same.
+ * @param timeStart :: start of the first interval of pulse times.
+ * @param seconds :: length of the intervals of pulse times, in seconds.
+ */
+void EventList::compressFatAndAddEvents(
+    std::vector<TofEvent> &events, const double tolerance,
+    const Types::Core::DateAndTime &timeStart, const double seconds) {
+  compressFatAndAddEventsHelper(events, tolerance, timeStart, seconds);
+}
+
+/** Compress weighted events, keeping their pulse times within a given
+ * tolerance, and add them to this list. See compressFatAndAddEventsHelper().
+ * @param events :: the events to add; emptied.
+ * @param tolerance :: how close do two event's TOF have to be to be considered
+ *the same.
+ * @param timeStart :: start of the first interval of pulse times.
+ * @param seconds :: length of the intervals of pulse times, in seconds.
+ */
+void EventList::compressFatAndAddEvents(
+    std::vector<WeightedEvent> &events, const double tolerance,
+    const Types::Core::DateAndTime &timeStart, const double seconds) {
+  compressFatAndAddEventsHelper(events, tolerance, timeStart, seconds);
+}
+
 // --------------------------------------------------------------------------
 /** Utility function:
  * Returns the iterator into events of the first TofEvent with
@@ -2039,6 +2464,30 @@ void EventList::histogramForWeightsHelper(const std::vector<T> &events,
                  static_cast<double (*)(double)>(sqrt));
 }
 
+// --------------------------------------------------------------------------
+/** Generates both the Y and E (error) histograms for unsorted weighted events,
+ * using the bin index computed by the indexer for each event.
+ *
+ * @param events: vector of events (with weights)
+ * @param indexer: finds the bin of each event
+ * @param Y: counts returned
+ * @param E: errors returned
+ */
+template <class T>
+void EventList::histogramUnsortedForWeightsHelper(
+    const std::vector<T> &events, const BinEdgeIndexer &indexer, MantidVec &Y,
+    MantidVec &E) {
+  Y.assign(indexer.numberOfBins(), 0.0);
+  // Note: Errors will be squared until the last step.
+  E.assign(indexer.numberOfBins(), 0.0);
+  indexer.weightedHistogram(
+      events.cbegin(), events.cend(), [](const T &event) { return event.tof(); },
+      [](const T &event) { return double(event.m_weight); },
+      [](const T &event) { return double(event.m_errorSquared); }, Y, E);
+  std::transform(E.begin(), E.end(), E.begin(),
+                 static_cast<double (*)(double)>(sqrt));
+}
+
 // --------------------------------------------------------------------------
 /** Generates both the Y and E (error) histograms w.r.t Pulse Time
  * for an EventList with or without WeightedEvents.
@@ -2121,8 +2570,14 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
                                   MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Linear and logarithmic bins give the bin of each event directly, so an
+  // unsorted list can be histogrammed without sorting it first
+  if (this->order != TOF_SORT && X.size() > 1) {
+    generateHistogram(BinEdgeIndexer(X), Y, E, skipError);
+    return;
+  }
 
+  // All types of weights need to be sorted by TOF
   this->sortTof();
 
   switch (eventType) {
@@ -2143,6 +2598,68 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y,
   }
 }
 
+/** Generates both the Y and E (error) histograms w.r.t TOF on bin edges whose
+ * spacing is already known, as when many spectra are histogrammed on the same
+ * edges.
+ *
+ * @param indexer: finds the bin of each event on the x-bins
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error. This has no effect for weighted
+ *        events; you can just ignore the returned E vector.
+ */
+void EventList::generateHistogram(const BinEdgeIndexer &indexer, MantidVec &Y,
+                                  MantidVec &E, bool skipError) const {
+  if (this->order == TOF_SORT ||
+      indexer.spacing() == BinEdgeIndexer::Spacing::Arbitrary) {
+    // Arbitrary edges are searched faster for events sorted by TOF
+    this->sortTof();
+    generateHistogram(indexer.edges(), Y, E, skipError);
+    return;
+  }
+
+  switch (eventType) {
+  case TOF:
+    Y.assign(indexer.numberOfBins(), 0.0);
+    indexer.countsHistogram(
+        events.cbegin(), events.cend(),
+        [](const TofEvent &event) { return event.tof(); }, Y);
+    if (!skipError)
+      this->generateErrorsHistogram(Y, E);
+    break;
+  case WEIGHTED:
+    histogramUnsortedForWeightsHelper(this->weightedEvents, indexer, Y, E);
+    break;
+  case WEIGHTED_NOTIME:
+    histogramUnsortedForWeightsHelper(this->weightedEventsNoTime, indexer, Y,
+                                      E);
+    break;
+  }
+}
+
+/** Generates both the Y and E (error) histograms w.r.t TOF on the x-bins of
+ * this list. The spacing of the bins is found once per thread for the spectra
+ * sharing them.
+ *
+ * @param Y: counts returned
+ * @param E: errors returned
+ * @param skipError: skip calculating the error.
+ */
+void EventList::generateHistogramOnOwnX(MantidVec &Y, MantidVec &E,
+                                        bool skipError) const {
+  auto x = m_histogram.sharedX();
+  if (this->order == TOF_SORT || x->size() <= 1) {
+    generateHistogram(x->rawData(), Y, E, skipError);
+    return;
+  }
+  auto &cache = cachedIndexer;
+  if (cache.edges != x) {
+    cache.indexer = std::make_unique<BinEdgeIndexer>(x->rawData());
+    cache.edges = std::move(x);
+  }
+  generateHistogram(*cache.indexer, Y, E, skipError);
+}
+
 // --------------------------------------------------------------------------
 /** With respect to PulseTime Fill a histogram given specified histogram bounds.
  * Does not modify
@@ -4334,52 +4851,42 @@ void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter,
 template <class T>
 std::string EventList::splitByFullTimeVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-    bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  typename std::vector<T>::iterator eviter;
+    const std::map<int, EventList *> &outputs,
+    typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+    double tofshift) const {
   std::stringstream msgss;
-
-  // Loop through events
-  for (eviter = vecEvents.begin(); eviter != vecEvents.end(); ++eviter) {
-    // Obtain time of event
-    int64_t evabstimens;
-    if (docorrection)
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(toffactor * eviter->m_tof * 1000 +
-                                         tofshift * 1.0E9);
-    else
-      evabstimens = eviter->m_pulsetime.totalNanoseconds() +
-                    static_cast<int64_t>(eviter->m_tof * 1000);
-
-    // Search in vector
-    int index = static_cast<int>(
-        lower_bound(vectimes.begin(), vectimes.end(), evabstimens) -
-        vectimes.begin());
+  const SplitOutputs outputLists(outputs);
+  const auto times = fullTimes(vecEvents, docorrection, toffactor, tofshift);
+  std::vector<int> slots(times.size());
+
+  // Events are sorted by pulse time, so consecutive events usually fall
+  // into the same splitter: check the previous one before searching.
+  size_t index = 0;
+  for (size_t i = 0; i < times.size(); ++i) {
+    const int64_t evabstimens = times[i];
+    // index is the first splitter time at or after the event (lower_bound)
+    if (!((index == vectimes.size() || vectimes[index] >= evabstimens) &&
+          (index == 0 || vectimes[index - 1] < evabstimens)))
+      index = static_cast<size_t>(
+          lower_bound(vectimes.begin(), vectimes.end(), evabstimens) -
+          vectimes.begin());
     int group;
     // FIXME - whether lower_bound() equal to vectimes.size()-1 should be
     // filtered out?
-    if (index == 0 || index > static_cast<int>(vectimes.size() - 1)) {
+    if (index == 0 || index > vectimes.size() - 1) {
       // Event is before first splitter or after last splitter.  Put to -1
       group = -1;
     } else {
       group = vecgroups[index - 1];
     }
 
-    // Copy event to the proper group
-    EventList *myOutput = outputs[group];
-    if (!myOutput) {
-      std::stringstream errss;
-      errss << "Group " << group << " has a NULL output EventList. "
+    slots[i] = outputLists.slot(group);
+    if (slots[i] == SplitOutputs::DISCARD)
+      msgss << "Group " << group << " has a NULL output EventList. "
             << "\n";
-      msgss << errss.str();
-    } else {
-      const T eventCopy(*eviter);
-      myOutput->addEventQuickly(eventCopy);
-    }
   }
 
+  outputLists.copy(vecEvents, slots);
   return (msgss.str());
 }
 
@@ -4406,82 +4913,45 @@ std::string EventList::splitByFullTimeVectorSplitterHelper(
 template <class T>
 std::string EventList::splitByFullTimeSparseVectorSplitterHelper(
     const std::vector<int64_t> &vectimes, const std::vector<int> &vecgroups,
-    std::map<int, EventList *> outputs, typename std::vector<T> &vecEvents,
-    bool docorrection, double toffactor, double tofshift) const {
-  // Define variables for events
-  // size_t numevents = events.size();
-  // typename std::vector<T>::iterator eviter;
-  std::stringstream msgss;
-
-  size_t num_splitters = vecgroups.size();
-  // prepare to Iterate through all events (sorted by tof)
-  auto iter_events = vecEvents.begin();
-  auto iter_events_end = vecEvents.end();
-
-  // std::stringstream debug_ss;
-  // debug_ss << "\nFilter events...:\n";
-
-  for (size_t i = 0; i < num_splitters; ++i) {
-    // get one splitter
-    int64_t start_i64 = vectimes[i];
-    int64_t stop_i64 = vectimes[i + 1];
-    int group = vecgroups[i];
-    // debug_ss << "working on splitter: " << i << " from " << start_i64 << " to
-    // " << stop_i64 << "\n";
-
-    // go over events
-    while (iter_events != iter_events_end) {
-      int64_t absolute_time;
-      if (docorrection)
-        absolute_time =
-            iter_events->m_pulsetime.totalNanoseconds() +
-            static_cast<int64_t>(toffactor * iter_events->m_tof * 1000 +
-                                 tofshift * 1.0E9);
-      else
-        absolute_time = iter_events->m_pulsetime.totalNanoseconds() +
-                        static_cast<int64_t>(iter_events->m_tof * 1000);
-
-      // debug_ss << "  event " << iter_events - vecEvents.begin() << " abs.time
-      // = " << absolute_time << "\n";
-
-      if (absolute_time < start_i64) {
-        // event occurs before the splitter. only can happen with first
-        // splitter. Then ignore and move to next
-        ++iter_events;
-        continue;
-      }
-
-      if (absolute_time < stop_i64) {
-        // in the splitter, then copy the event into another
-        const T eventCopy(*iter_events);
-        // Copy event to the proper group
-        EventList *myOutput = outputs[group];
-        if (!myOutput) {
-          // there is no such group defined. quit for this group
-          std::stringstream errss;
-          errss << "Group " << group << " has a NULL output EventList. "
-                << "\n";
-          msgss << errss.str();
-          throw std::runtime_error(errss.str());
-        }
-        // Add the copy to the output
-        myOutput->addEventQuickly(eventCopy);
-        ++iter_events;
-      } else {
-        // event occurs after the stop time, it should belonged to the next
-        // splitter
+    const std::map<int, EventList *> &outputs,
+    typename std::vector<T> &vecEvents, bool docorrection, double toffactor,
+    double tofshift) const {
+  const SplitOutputs outputLists(outputs);
+  const auto times = fullTimes(vecEvents, docorrection, toffactor, tofshift);
+  std::vector<int> slots(times.size(), SplitOutputs::DISCARD);
+
+  // Walk through the events (sorted by pulse time) and the splitters
+  // together. An event past the current splitter jumps straight to the
+  // splitter containing it, so splitters without events cost nothing.
+  const size_t num_splitters = vecgroups.size();
+  size_t i = 0;
+  for (size_t iev = 0; iev < times.size() && i < num_splitters; ++iev) {
+    const int64_t absolute_time = times[iev];
+    if (absolute_time < vectimes[i]) {
+      // event occurs before the splitter. only can happen with first
+      // splitter. Then ignore and move to next
+      continue;
+    }
+    if (absolute_time >= vectimes[i + 1]) {
+      // event occurs after the stop time, it belongs to a later splitter
+      i = findSplitter(vectimes, i, absolute_time);
+      if (i >= num_splitters)
         break;
-      }
-    } // while
-
-    // quit the loop if there is no more event left
-    if (iter_events == iter_events_end)
-      break;
-  } // for splitter
-
-  // std::cout << debug_ss.str();
+    }
+    // in the splitter, then copy the event into its group
+    const int group = vecgroups[i];
+    slots[iev] = outputLists.slot(group);
+    if (slots[iev] == SplitOutputs::DISCARD) {
+      // there is no such group defined
+      std::stringstream errss;
+      errss << "Group " << group << " has a NULL output EventList. "
+            << "\n";
+      throw std::runtime_error(errss.str());
+    }
+  }
 
-  return (msgss.str());
+  outputLists.copy(vecEvents, slots);
+  return std::string();
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4724,54 +5194,44 @@ template <class T>
 void EventList::splitByPulseTimeWithMatrixHelper(
     const std::vector<int64_t> &vec_split_times,
     const std::vector<int> &vec_split_target,
-    std::map<int, EventList *> outputs, typename std::vector<T> &events) const {
+    const std::map<int, EventList *> &outputs,
+    typename std::vector<T> &events) const {
   // Prepare to TimeSplitter Iterate through the splitter at the same time
   if (vec_split_times.size() != vec_split_target.size() + 1)
     throw std::runtime_error("Splitter time vector size and splitter target "
                              "vector size are not correct.");
 
-  // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
-
-  // Iterate (loop) on all splitters
-  for (size_t i_target = 0; i_target < vec_split_target.size(); ++i_target) {
-    // Get the splitting interval times and destination group
-    int64_t start = vec_split_times[i_target];
-    int64_t stop = vec_split_times[i_target + 1];
-    const int index = vec_split_target[i_target];
-
-    // Skip the events before the start of the time and put to 'unfiltered'
-    // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
+  const SplitOutputs outputLists(outputs);
+  const auto times = pulseTimes(events);
+  std::vector<int> slots(times.size(), SplitOutputs::DISCARD);
+  const auto slotOf = [&outputLists](const int group) {
+    const int slot = outputLists.slot(group);
+    if (slot == SplitOutputs::DISCARD)
+      throw std::runtime_error("Group " + std::to_string(group) +
+                               " has a NULL output EventList.");
+    return slot;
+  };
+
+  // Walk through the events (sorted by pulse time) and the splitters
+  // together. Events before the start of a splitter go to the 'unfiltered'
+  // EventList (index = -1), an event past a splitter jumps straight to the
+  // splitter containing it.
+  const size_t num_splitters = vec_split_target.size();
+  size_t i_target = 0;
+  for (size_t iev = 0; iev < times.size() && num_splitters > 0; ++iev) {
+    const int64_t pulse_time = times[iev];
+    if (pulse_time >= vec_split_times[i_target + 1]) {
+      i_target = findSplitter(vec_split_times, i_target, pulse_time);
+      if (i_target >= num_splitters)
         break;
-      }
-    }
-
-    // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
     }
+    if (pulse_time < vec_split_times[i_target])
+      slots[iev] = slotOf(-1);
+    else
+      slots[iev] = slotOf(vec_split_target[i_target]);
+  }
 
-    // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
-      break;
-  } // END-WHILE Splitter
+  outputLists.copy(events, slots);
 }
 
 //--------------------------------------------------------------------------
@@ -25,6 +25,7 @@
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include "tbb/parallel_for.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -460,6 +461,12 @@ bool EventWorkspace::isHistogramData() const { return true; }
  */
 size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
 
+/** Access the MRU of the generated histograms, e.g. to set its memory budget,
+ * pin spectra or read its hit/miss counters.
+ * @return :: the MRU shared by all event lists of this workspace
+ */
+EventWorkspaceMRU &EventWorkspace::getMRU() const { return *mru; }
+
 /** Clears the MRU lists */
 void EventWorkspace::clearMRU() const { mru->clear(); }
 
@@ -623,33 +630,6 @@ void EventWorkspace::resetAllXToSingleBin() {
   setAllX({tofmin, tofmax});
 }
 
-/** Task for sorting an event list */
-class EventSortingTask {
-public:
-  /// ctor
-  EventSortingTask(const EventWorkspace *WS, EventSortType sortType,
-                   Mantid::API::Progress *prog)
-      : m_sortType(sortType), m_WS(WS), prog(prog) {}
-
-  // Execute the sort as specified.
-  void operator()(const tbb::blocked_range<size_t> &range) const {
-    for (size_t wi = range.begin(); wi < range.end(); ++wi) {
-      m_WS->getSpectrum(wi).sort(m_sortType);
-    }
-    // Report progress
-    if (prog)
-      prog->report("Sorting");
-  }
-
-private:
-  /// How to sort
-  EventSortType m_sortType;
-  /// EventWorkspace on which to sort
-  const EventWorkspace *m_WS;
-  /// Optional Progress dialog.
-  Mantid::API::Progress *prog;
-};
-
 /*
  * Review each event list to get the sort type
  * If any 2 have different order type, then be unsorted
@@ -665,6 +645,12 @@ EventSortType EventWorkspace::getSortType() const {
 }
 
 /*** Sort all event lists. Uses a parallelized algorithm
+ *
+ * The lists are sorted longest first so that a few heavily populated
+ * detector pixels do not leave the other threads idle at the end. Lists long
+ * enough to be sorted by several threads are sorted one after another; the
+ * remaining ones are handed out to threads in batches of similar total event
+ * count, so that many tiny lists do not each cost a scheduling step.
  * @param sortType :: How to sort the event lists.
  * @param prog :: a progress report object. If the pointer is not NULL, each
  * event list will call prog.report() once.
@@ -678,9 +664,50 @@ void EventWorkspace::sortAll(EventSortType sortType,
     return;
   }
 
-  // Create the thread pool, and optimize by doing the longest sorts first.
-  EventSortingTask task(this, sortType, prog);
-  tbb::parallel_for(tbb::blocked_range<size_t>(0, data.size()), task);
+  std::vector<size_t> numEvents(data.size());
+  for (size_t wi = 0; wi < data.size(); ++wi)
+    numEvents[wi] = data[wi]->getNumberEvents();
+  std::vector<size_t> order(data.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&numEvents](size_t lhs, size_t rhs) {
+    return numEvents[lhs] > numEvents[rhs];
+  });
+
+  // The longest lists use all threads themselves
+  size_t next = 0;
+  for (; next < order.size() &&
+         numEvents[order[next]] >= EventList::PARALLEL_SORT_MIN_EVENTS;
+       ++next) {
+    data[order[next]]->sort(sortType);
+    if (prog)
+      prog->report("Sorting");
+  }
+
+  // Group the others into batches of about the same number of events
+  constexpr size_t eventsPerBatch = 1 << 16;
+  std::vector<size_t> batchStart{next};
+  size_t eventsInBatch = 0;
+  for (; next < order.size(); ++next) {
+    eventsInBatch += numEvents[order[next]];
+    if (eventsInBatch >= eventsPerBatch) {
+      batchStart.emplace_back(next + 1);
+      eventsInBatch = 0;
+    }
+  }
+  if (batchStart.back() != order.size())
+    batchStart.emplace_back(order.size());
+
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, batchStart.size() - 1),
+      [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t batch = range.begin(); batch < range.end(); ++batch) {
+          for (size_t i = batchStart[batch]; i < batchStart[batch + 1]; ++i)
+            data[order[i]]->sort(sortType);
+          if (prog)
+            prog->reportIncrement(batchStart[batch + 1] - batchStart[batch],
+                                  "Sorting");
+        }
+      });
 }
 
 /** Integrate all the spectra in the matrix workspace within the range given.
@@ -5,81 +5,203 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <unordered_map>
+
 namespace Mantid {
 namespace DataObjects {
 
-EventWorkspaceMRU::~EventWorkspaceMRU() {
-  // Make sure you free up the memory in the MRUs
-  {
-    Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-    for (auto &data : m_bufferedDataY) {
-      if (data) {
-        data->clear();
-      }
-    }
+namespace {
+/// Key of an event list in the cache
+std::uintptr_t toKey(const EventList *index) {
+  return reinterpret_cast<std::uintptr_t>(index);
+}
+
+/** Most-recently-used list of one kind of histogram (Y or E) in a shard.
+ * Not thread-safe; the owning shard holds the lock.
+ */
+template <class T> class HistogramCache {
+public:
+  /// Find the histogram of a list and move it to the front
+  T find(const std::uintptr_t key) {
+    auto found = m_lookup.find(key);
+    if (found == m_lookup.end())
+      return T(nullptr);
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    return found->second->data;
+  }
+
+  /// Insert (or replace) the histogram of a list at the front
+  void insert(const std::uintptr_t key, T data, const bool pinned) {
+    erase(key);
+    const size_t bytes =
+        data ? data->size() * sizeof(double) + sizeof(Entry) : sizeof(Entry);
+    m_entries.push_front(Entry{key, std::move(data), bytes, pinned});
+    m_lookup.emplace(key, m_entries.begin());
+    m_bytes += bytes;
+    if (!pinned)
+      ++m_numUnpinned;
   }
-  Poco::ScopedWriteRWLock _lock2(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
+
+  /// Remove the histogram of a list, if present
+  void erase(const std::uintptr_t key) {
+    auto found = m_lookup.find(key);
+    if (found == m_lookup.end())
+      return;
+    remove(found->second);
+  }
+
+  /// Change whether the histogram of a list may be evicted
+  void setPinned(const std::uintptr_t key, const bool pinned) {
+    auto found = m_lookup.find(key);
+    if (found == m_lookup.end() || found->second->pinned == pinned)
+      return;
+    found->second->pinned = pinned;
+    if (pinned)
+      --m_numUnpinned;
+    else
+      ++m_numUnpinned;
+  }
+
+  /** Evict the least recently used unpinned histograms until within limits.
+   * The most recently used histogram is kept even if it alone is over the
+   * limits, as the caller may still hold a reference to it.
+   */
+  void trim(const size_t maxEntries, const size_t maxBytes) {
+    if (m_entries.empty())
+      return;
+    const auto newest = m_entries.begin();
+    auto it = m_entries.end();
+    while ((m_numUnpinned > maxEntries || m_bytes > maxBytes) &&
+           --it != newest) {
+      if (it->pinned)
+        continue;
+      it = remove(it);
     }
   }
+
+  /// Remove all histograms
+  void clear() {
+    m_lookup.clear();
+    m_entries.clear();
+    m_bytes = 0;
+    m_numUnpinned = 0;
+  }
+
+  size_t size() const { return m_entries.size(); }
+  size_t bytes() const { return m_bytes; }
+
+private:
+  struct Entry {
+    std::uintptr_t key;
+    T data;
+    size_t bytes;
+    bool pinned;
+  };
+  using EntryIterator = typename std::list<Entry>::iterator;
+
+  EntryIterator remove(EntryIterator it) {
+    m_bytes -= it->bytes;
+    if (!it->pinned)
+      --m_numUnpinned;
+    m_lookup.erase(it->key);
+    return m_entries.erase(it);
+  }
+
+  /// Entries, most recently used first
+  std::list<Entry> m_entries;
+  /// Position of each list's entry in m_entries
+  std::unordered_map<std::uintptr_t, EntryIterator> m_lookup;
+  /// Memory held by the entries
+  size_t m_bytes{0};
+  /// Number of entries that may be evicted
+  size_t m_numUnpinned{0};
+};
+} // namespace
+
+/// One shard of the cache, used by a single thread
+struct EventWorkspaceMRU::Shard {
+  /// Lock for this shard; only contended by deleteIndex() and clear()
+  std::mutex mutex;
+  /// The cached Y histograms
+  HistogramCache<YType> y;
+  /// The cached E histograms
+  HistogramCache<EType> e;
+  /// Number of lookups that found a cached histogram
+  size_t hits{0};
+  /// Number of lookups that did not find a cached histogram
+  size_t misses{0};
+};
+
+/** Constructor
+ * @param numShards :: number of shards; 0 uses the maximum number of threads
+ */
+EventWorkspaceMRU::EventWorkspaceMRU(size_t numShards) {
+  if (numShards == 0)
+    numShards = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  m_shards.resize(std::max(numShards, size_t(1)));
+  for (auto &s : m_shards)
+    s = std::make_unique<Shard>();
 }
 
+EventWorkspaceMRU::~EventWorkspaceMRU() = default;
+
 //---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for E for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+/** Get the shard used by a thread. Threads beyond the number of shards made
+ * at construction get a shard of their own, so that no thread evicts the
+ * histograms of another.
+ * @param thread_num :: thread number
+ * @return the shard for the thread
  */
-void EventWorkspaceMRU::ensureEnoughBuffersE(size_t thread_num) const {
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexE);
-  if (m_bufferedDataE.size() <= thread_num) {
-    m_bufferedDataE.resize(thread_num + 1);
-    for (auto &data : m_bufferedDataE) {
-      if (!data)
-        data = std::make_unique<mru_listE>(
-            50); // Create a MRU list with this many entries.
-    }
-  }
+EventWorkspaceMRU::Shard &EventWorkspaceMRU::shard(size_t thread_num) const {
+  if (thread_num < m_shards.size())
+    return *m_shards[thread_num];
+  std::lock_guard<std::mutex> lock(m_extraShardsMutex);
+  auto &extra = m_extraShards[thread_num];
+  if (!extra)
+    extra = std::make_unique<Shard>();
+  return *extra;
 }
-//---------------------------------------------------------------------------
-/** This function makes sure that there are enough data
- * buffers (MRU's) for Y for the number of threads requested.
- * @param thread_num :: thread number that wants a MRU buffer
+
+/** Call a function for every shard, with the lock of the shard held.
+ * @param func :: the function, taking a Shard &
  */
-void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-  if (m_bufferedDataY.size() <= thread_num) {
-    m_bufferedDataY.resize(thread_num + 1);
-    for (auto &data : m_bufferedDataY) {
-      if (!data)
-        data = std::make_unique<mru_listY>(
-            50); // Create a MRU list with this many entries.
-    }
+template <typename Func>
+void EventWorkspaceMRU::forEachShard(const Func &func) const {
+  for (const auto &s : m_shards) {
+    std::lock_guard<std::mutex> lock(s->mutex);
+    func(*s);
+  }
+  std::lock_guard<std::mutex> extraLock(m_extraShardsMutex);
+  for (const auto &s : m_extraShards) {
+    std::lock_guard<std::mutex> lock(s.second->mutex);
+    func(*s.second);
   }
 }
 
+/** @param used :: memory already held in the shard by the other histogram type
+ * @return the memory budget left in a shard
+ */
+size_t EventWorkspaceMRU::shardBudget(const size_t used) const {
+  const size_t budget = m_memoryBudget;
+  if (budget == 0)
+    return std::numeric_limits<size_t>::max();
+  const size_t perShard = budget / m_shards.size();
+  return perShard > used ? perShard - used : 0;
+}
+
 //---------------------------------------------------------------------------
-/// Clear all the data in the MRU buffers
+/// Clear all the data in the MRU buffers. Pinned lists stay pinned.
 void EventWorkspaceMRU::clear() {
-  {
-    // Make sure you free up the memory in the MRUs
-    Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
-    for (auto &data : m_bufferedDataY) {
-      if (data) {
-        data->clear();
-      }
-    }
-  }
-
-  Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexE);
-  for (auto &data : m_bufferedDataE) {
-    if (data) {
-      data->clear();
-    }
-  }
+  forEachShard([](Shard &s) {
+    s.y.clear();
+    s.e.clear();
+  });
 }
 
 //---------------------------------------------------------------------------
@@ -87,32 +209,30 @@ void EventWorkspaceMRU::clear() {
  *
  * @param thread_num :: number of the thread in which this is run
  * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @return the cached data; NULL if not found.
  */
-Kernel::cow_ptr<HistogramData::HistogramY>
-EventWorkspaceMRU::findY(size_t thread_num, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto result = m_bufferedDataY[thread_num]->find(
-      reinterpret_cast<std::uintptr_t>(index));
-  if (result)
-    return result->m_data;
-  return YType(nullptr);
+EventWorkspaceMRU::YType EventWorkspaceMRU::findY(size_t thread_num,
+                                                  const EventList *index) {
+  auto &s = shard(thread_num);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto result = s.y.find(toKey(index));
+  ++(result ? s.hits : s.misses);
+  return result;
 }
 
-/** Find a Y histogram in the MRU
+/** Find a E histogram in the MRU
  *
  * @param thread_num :: number of the thread in which this is run
  * @param index :: index of the data to return
- * @return pointer to the TypeWithMarker that has the data; NULL if not found.
+ * @return the cached data; NULL if not found.
  */
-Kernel::cow_ptr<HistogramData::HistogramE>
-EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto result = m_bufferedDataE[thread_num]->find(
-      reinterpret_cast<std::uintptr_t>(index));
-  if (result)
-    return result->m_data;
-  return EType(nullptr);
+EventWorkspaceMRU::EType EventWorkspaceMRU::findE(size_t thread_num,
+                                                  const EventList *index) {
+  auto &s = shard(thread_num);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto result = s.e.find(toKey(index));
+  ++(result ? s.hits : s.misses);
+  return result;
 }
 
 /** Insert a new histogram into the MRU
@@ -123,12 +243,13 @@ EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
  */
 void EventWorkspaceMRU::insertY(size_t thread_num, YType data,
                                 const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
-  auto yWithMarker = std::make_shared<TypeWithMarker<YType>>(
-      reinterpret_cast<std::uintptr_t>(index));
-  yWithMarker->m_data = std::move(data);
-  m_bufferedDataY[thread_num]->insert(yWithMarker);
-  // the memory is cleared automatically due to being a smart_ptr
+  const auto key = toKey(index);
+  auto &s = shard(thread_num);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  // Checked with the shard locked, so that pin() either finds the new entry
+  // or has already recorded the list as pinned
+  s.y.insert(key, std::move(data), isPinned(key));
+  s.y.trim(DEFAULT_ENTRIES_PER_SHARD, shardBudget(s.e.bytes()));
 }
 
 /** Insert a new histogram into the MRU
@@ -139,12 +260,13 @@ void EventWorkspaceMRU::insertY(size_t thread_num, YType data,
  */
 void EventWorkspaceMRU::insertE(size_t thread_num, EType data,
                                 const EventList *index) {
-  Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
-  auto eWithMarker = std::make_shared<TypeWithMarker<EType>>(
-      reinterpret_cast<std::uintptr_t>(index));
-  eWithMarker->m_data = std::move(data);
-  auto oldData = m_bufferedDataE[thread_num]->insert(eWithMarker);
-  // And clear up the memory of the old one, if it is dropping out.
+  const auto key = toKey(index);
+  auto &s = shard(thread_num);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  // Checked with the shard locked, so that pin() either finds the new entry
+  // or has already recorded the list as pinned
+  s.e.insert(key, std::move(data), isPinned(key));
+  s.e.trim(DEFAULT_ENTRIES_PER_SHARD, shardBudget(s.y.bytes()));
 }
 
 /** Delete any entries in the MRU at the given index
@@ -152,28 +274,109 @@ void EventWorkspaceMRU::insertE(size_t thread_num, EType data,
  * @param index :: index to delete.
  */
 void EventWorkspaceMRU::deleteIndex(const EventList *index) {
+  const auto key = toKey(index);
+  forEachShard([key](Shard &s) {
+    s.y.erase(key);
+    s.e.erase(key);
+  });
+}
+
+//---------------------------------------------------------------------------
+/** Set the memory budget of the cache, shared evenly between the shards made
+ * at construction. Shards made later for extra threads get the same share.
+ * Histograms beyond the budget are evicted on the next insertion.
+ * @param bytes :: the budget in bytes; 0 removes the limit
+ */
+void EventWorkspaceMRU::setMemoryBudget(size_t bytes) {
+  m_memoryBudget = bytes;
+}
+
+/// @return the memory held by the cached histograms, in bytes
+size_t EventWorkspaceMRU::memoryUsed() const {
+  size_t total = 0;
+  forEachShard([&total](Shard &s) { total += s.y.bytes() + s.e.bytes(); });
+  return total;
+}
+
+//---------------------------------------------------------------------------
+/** Keep the histograms of an event list in the cache regardless of the
+ * limits. They are still dropped when the event list changes.
+ * @param index :: the event list to pin
+ */
+void EventWorkspaceMRU::pin(const EventList *index) {
+  const auto key = toKey(index);
   {
-    Poco::ScopedReadRWLock _lock1(m_changeMruListsMutexE);
-    for (auto &data : m_bufferedDataE) {
-      if (data) {
-        data->deleteIndex(reinterpret_cast<std::uintptr_t>(index));
-      }
-    }
+    std::lock_guard<std::mutex> lock(m_pinnedMutex);
+    m_pinned.insert(key);
+    m_hasPinned = true;
   }
-  Poco::ScopedReadRWLock _lock2(m_changeMruListsMutexY);
-  for (auto &data : m_bufferedDataY) {
-    if (data) {
-      data->deleteIndex(reinterpret_cast<std::uintptr_t>(index));
-    }
+  forEachShard([key](Shard &s) {
+    s.y.setPinned(key, true);
+    s.e.setPinned(key, true);
+  });
+}
+
+/** Allow the histograms of an event list to be evicted again. An event list
+ * unpins itself when it is destroyed, so that a new list at the same address
+ * is not pinned.
+ * @param index :: the event list to unpin
+ */
+void EventWorkspaceMRU::unpin(const EventList *index) {
+  if (!m_hasPinned)
+    return;
+  const auto key = toKey(index);
+  {
+    std::lock_guard<std::mutex> lock(m_pinnedMutex);
+    if (m_pinned.erase(key) == 0)
+      return;
+    m_hasPinned = !m_pinned.empty();
   }
+  forEachShard([key](Shard &s) {
+    s.y.setPinned(key, false);
+    s.e.setPinned(key, false);
+  });
+}
+
+/** @param index :: an event list
+ * @return true if the histograms of the event list are pinned
+ */
+bool EventWorkspaceMRU::isPinned(const EventList *index) const {
+  return isPinned(toKey(index));
+}
+
+bool EventWorkspaceMRU::isPinned(std::uintptr_t key) const {
+  if (!m_hasPinned)
+    return false;
+  std::lock_guard<std::mutex> lock(m_pinnedMutex);
+  return m_pinned.count(key) > 0;
+}
+
+/// @return the number of lookups that found a cached histogram
+size_t EventWorkspaceMRU::hits() const {
+  size_t total = 0;
+  forEachShard([&total](Shard &s) { total += s.hits; });
+  return total;
+}
+
+/// @return the number of lookups that did not find a cached histogram
+size_t EventWorkspaceMRU::misses() const {
+  size_t total = 0;
+  forEachShard([&total](Shard &s) { total += s.misses; });
+  return total;
+}
+
+/// Reset the hit and miss counters
+void EventWorkspaceMRU::resetStatistics() {
+  forEachShard([](Shard &s) {
+    s.hits = 0;
+    s.misses = 0;
+  });
 }
 
 size_t EventWorkspaceMRU::MRUSize() const {
-  if (m_bufferedDataY.empty()) {
-    return 0;
-  } else {
-    return this->m_bufferedDataY.front()->size();
-  }
+  auto &s = shard(0);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  return s.y.size();
 }
 
 } // namespace DataObjects
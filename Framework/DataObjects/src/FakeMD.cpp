@@ -10,19 +10,15 @@
 #include "MantidDataObjects/FakeMD.h"
 
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataObjects/MDBoxTreeBuilder.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventInserter.h"
 #include "MantidGeometry/Instrument.h"
-#include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadScheduler.h"
 #include "MantidKernel/Utils.h"
 
 namespace Mantid {
 namespace DataObjects {
 
-using Kernel::ThreadPool;
-using Kernel::ThreadSchedulerFIFO;
-
 /**
  * Constructor
  * @param uniformParams Add a uniform, randomized distribution of events
@@ -75,6 +71,23 @@ void FakeMD::setupDetectorCache(const API::IMDEventWorkspace &workspace) {
   }
 }
 
+namespace {
+/// Helper to create the correct event type
+template <typename MDE, size_t nd>
+using EventInserter = MDEventInserter<typename MDEventWorkspace<MDE, nd>::sptr>;
+
+/** Add events to a workspace, splitting its boxes as needed
+ * @param ws The workspace that receives the events
+ * @param events The events to add. They are reordered.
+ */
+template <typename MDE, size_t nd>
+void addEvents(MDEventWorkspace<MDE, nd> &ws, std::vector<MDE> &events) {
+  ws.splitBox();
+  MDBoxTreeBuilder<MDE, nd>(ws).addEvents(events);
+  ws.refreshCache();
+}
+} // namespace
+
 /** Function makes up a fake single-crystal peak and adds it to the workspace.
  *
  * @param ws A pointer to the workspace that receives the events
@@ -96,10 +109,8 @@ void FakeMD::addFakePeak(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   std::mt19937 rng(static_cast<unsigned int>(m_randomSeed));
   std::uniform_real_distribution<coord_t> flat(0, 1.0);
 
-  // Inserter to help choose the correct event type
-  auto eventHelper =
-      MDEventInserter<typename MDEventWorkspace<MDE, nd>::sptr>(ws);
-
+  std::vector<MDE> events;
+  events.reserve(num);
   for (size_t i = 0; i < num; ++i) {
     // Algorithm to generate points along a random n-sphere (sphere with not
     // necessarily 3 dimensions)
@@ -137,17 +148,12 @@ void FakeMD::addFakePeak(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       errorSquared = float(0.5 + flat(rng));
     }
 
-    // Create and add the event.
-    eventHelper.insertMDEvent(signal, errorSquared, 0, pickDetectorID(),
-                              centers); // 0 = run index
+    // Create the event.
+    events.emplace_back(EventInserter<MDE, nd>::makeMDEvent(
+        signal, errorSquared, 0, pickDetectorID(), centers)); // 0 = run index
   }
 
-  ws->splitBox();
-  auto *ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-  ws->splitAllIfNeeded(ts);
-  tp.joinAll();
-  ws->refreshCache();
+  addEvents<MDE, nd>(*ws, events);
 }
 
 /**
@@ -202,36 +208,30 @@ void FakeMD::addFakeUniformData(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     throw std::invalid_argument(
         "UniformParams: needs to have ndims*2+1 arguments ");
 
+  std::vector<MDE> events;
   if (randomEvents)
-    addFakeRandomData<MDE, nd>(m_uniformParams, ws);
+    addFakeRandomData<MDE, nd>(m_uniformParams, events);
   else
-    addFakeRegularData<MDE, nd>(m_uniformParams, ws);
-
-  ws->splitBox();
-  auto *ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-  ws->splitAllIfNeeded(ts);
-  tp.joinAll();
-  ws->refreshCache();
+    addFakeRegularData<MDE, nd>(m_uniformParams, ws, events);
+
+  addEvents<MDE, nd>(*ws, events);
 }
 
 /**
- * Add fake randomized data to the workspace
+ * Make fake randomized data
  * @param params A reference to the parameter vector
- * @param ws The workspace to hold the data
+ * @param events The vector to add the events to
  */
 template <typename MDE, size_t nd>
 void FakeMD::addFakeRandomData(const std::vector<double> &params,
-                               typename MDEventWorkspace<MDE, nd>::sptr ws) {
+                               std::vector<MDE> &events) {
 
   auto num = size_t(params[0]);
   if (num == 0)
     throw std::invalid_argument(
         " number of distributed events can not be equal to 0");
 
-  // Inserter to help choose the correct event type
-  auto eventHelper =
-      MDEventInserter<typename MDEventWorkspace<MDE, nd>::sptr>(ws);
+  events.reserve(num);
 
   // Array of distributions for each dimension
   std::mt19937 rng(static_cast<unsigned int>(m_randomSeed));
@@ -261,15 +261,22 @@ void FakeMD::addFakeRandomData(const std::vector<double> &params,
       errorSquared = float(0.5 + flat(rng));
     }
 
-    // Create and add the event.
-    eventHelper.insertMDEvent(signal, errorSquared, 0, pickDetectorID(),
-                              centers); // 0 = run index
+    // Create the event.
+    events.emplace_back(EventInserter<MDE, nd>::makeMDEvent(
+        signal, errorSquared, 0, pickDetectorID(), centers)); // 0 = run index
   }
 }
 
+/**
+ * Make fake data on a regular grid
+ * @param params A reference to the parameter vector
+ * @param ws The workspace the data is made for
+ * @param events The vector to add the events to
+ */
 template <typename MDE, size_t nd>
 void FakeMD::addFakeRegularData(const std::vector<double> &params,
-                                typename MDEventWorkspace<MDE, nd>::sptr ws) {
+                                typename MDEventWorkspace<MDE, nd>::sptr ws,
+                                std::vector<MDE> &events) {
   // the parameters for regular distribution of events over the box
   std::vector<double> startPoint(nd), delta(nd);
   std::vector<size_t> indexMax(nd);
@@ -280,9 +287,7 @@ void FakeMD::addFakeRegularData(const std::vector<double> &params,
     throw std::invalid_argument(
         " number of distributed events can not be equal to 0");
 
-  // Inserter to help choose the correct event type
-  auto eventHelper =
-      MDEventInserter<typename MDEventWorkspace<MDE, nd>::sptr>(ws);
+  events.reserve(num);
 
   gridSize = 1;
   for (size_t d = 0; d < nd; ++d) {
@@ -334,9 +339,9 @@ void FakeMD::addFakeRegularData(const std::vector<double> &params,
     float signal = 1.0;
     float errorSquared = 1.0;
 
-    // Create and add the event.
-    eventHelper.insertMDEvent(signal, errorSquared, 0, pickDetectorID(),
-                              centers); // 0 = run index
+    // Create the event.
+    events.emplace_back(EventInserter<MDE, nd>::makeMDEvent(
+        signal, errorSquared, 0, pickDetectorID(), centers)); // 0 = run index
   }
 }
 
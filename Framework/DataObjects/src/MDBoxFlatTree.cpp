@@ -7,10 +7,12 @@
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidAPI/BoxController.h"
 #include "MantidAPI/FileBackedExperimentInfo.h"
+#include "MantidAPI/IBoxControllerIO.h"
 #include "MantidAPI/WorkspaceHistory.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/Logger.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include <Poco/File.h>
 
@@ -23,6 +25,24 @@ namespace DataObjects {
 namespace {
 /// static logger
 Kernel::Logger g_log("MDBoxFlatTree");
+/// Number of events converted in parallel between two file operations
+constexpr uint64_t EVENTS_PER_BATCH = 1 << 20;
+
+/** Find the end of the next batch of boxes to save or load
+ * @param eventIndex :: file position and number of events of each box
+ * @param first :: index of the first box of the batch
+ * @return the index one past the last box of the batch
+ */
+size_t endOfBatch(const std::vector<uint64_t> &eventIndex, size_t first) {
+  const size_t numBoxes = eventIndex.size() / 2;
+  uint64_t numEvents = 0;
+  size_t last = first;
+  while (last < numBoxes && (last == first || numEvents < EVENTS_PER_BATCH)) {
+    numEvents += eventIndex[2 * last + 1];
+    ++last;
+  }
+  return last;
+}
 } // namespace
 
 MDBoxFlatTree::MDBoxFlatTree() : m_nDim(-1) {}
@@ -853,5 +873,130 @@ void saveMatrix(::NeXus::File *const file, const std::string &name,
   }
   file->closeData();
 }
+/** Save the events of boxes which are in memory into an opened file at the
+ * file positions given by the event index.
+ *
+ * The boxes are converted into tables of event data in parallel, a batch of
+ * boxes at a time. Each run of boxes which lie next to each other on the file
+ * is then written with one call to the saver, as the file operations are
+ * serialised. Empty and masked boxes are not written.
+ *
+ * @param boxes :: the boxes of the workspace
+ * @param eventIndex :: the file position and number of events of each box
+ * @param saver :: the opened file to save the events into
+ * @param progress :: if not null, reports progress once per box
+ */
+void MDBoxFlatTree::saveBoxesEvents(const std::vector<API::IMDNode *> &boxes,
+                                    const std::vector<uint64_t> &eventIndex,
+                                    API::IBoxControllerIO *const saver,
+                                    Kernel::ProgressBase *const progress) {
+  const size_t numBoxes = boxes.size();
+  std::vector<coord_t> run;
+  for (size_t first = 0; first < numBoxes;) {
+    const size_t last = endOfBatch(eventIndex, first);
+    std::vector<std::vector<coord_t>> tables(last - first);
+    std::vector<size_t> numColumns(last - first, 1);
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = static_cast<int64_t>(first);
+         i < static_cast<int64_t>(last); ++i) {
+      const auto index = static_cast<size_t>(i);
+      const auto *box = boxes[index];
+      if (box && box->isBox() && eventIndex[2 * index + 1] > 0 &&
+          !box->getIsMasked())
+        box->getEventsData(tables[index - first], numColumns[index - first]);
+    }
+
+    for (size_t i = first; i < last;) {
+      if (tables[i - first].empty()) {
+        ++i;
+        continue;
+      }
+      const uint64_t start = eventIndex[2 * i];
+      uint64_t end = start;
+      run.clear();
+      for (; i < last && !tables[i - first].empty() && eventIndex[2 * i] == end;
+           ++i) {
+        const auto &table = tables[i - first];
+        run.insert(run.end(), table.begin(), table.end());
+        end += table.size() / numColumns[i - first];
+      }
+      saver->saveBlock(run, start);
+    }
+    if (progress)
+      progress->reportIncrement(last - first, "Saving Box");
+    first = last;
+  }
+}
+
+/** Load the events of boxes from an opened file at the file positions given by
+ * the event index, replacing any events the boxes hold.
+ *
+ * Each run of boxes which lie next to each other on the file is read with one
+ * call to the loader, a batch of boxes at a time, as the file operations are
+ * serialised. The events of the boxes of the batch are then created in
+ * parallel.
+ *
+ * @param boxes :: the boxes of the workspace
+ * @param eventIndex :: the file position and number of events of each box
+ * @param loader :: the opened file to load the events from
+ * @param progress :: if not null, reports progress once per box
+ */
+void MDBoxFlatTree::loadBoxesEvents(const std::vector<API::IMDNode *> &boxes,
+                                    const std::vector<uint64_t> &eventIndex,
+                                    API::IBoxControllerIO *const loader,
+                                    Kernel::ProgressBase *const progress) {
+  const size_t numBoxes = boxes.size();
+  auto toLoad = [&boxes, &eventIndex](const size_t i) {
+    return boxes[i] && boxes[i]->isBox() && eventIndex[2 * i + 1] > 0;
+  };
+  std::vector<std::vector<coord_t>> runs;
+  std::vector<uint64_t> runEvents;
+  for (size_t first = 0; first < numBoxes;) {
+    const size_t last = endOfBatch(eventIndex, first);
+    // The run holding each box and the offset of the box in its run
+    std::vector<size_t> runOfBox(last - first);
+    std::vector<uint64_t> offsetInRun(last - first);
+    size_t numRuns = 0;
+    for (size_t i = first; i < last;) {
+      if (!toLoad(i)) {
+        ++i;
+        continue;
+      }
+      const uint64_t start = eventIndex[2 * i];
+      uint64_t end = start;
+      for (; i < last && toLoad(i) && eventIndex[2 * i] == end; ++i) {
+        runOfBox[i - first] = numRuns;
+        offsetInRun[i - first] = end - start;
+        end += eventIndex[2 * i + 1];
+      }
+      if (runs.size() <= numRuns) {
+        runs.resize(numRuns + 1);
+        runEvents.resize(numRuns + 1);
+      }
+      loader->loadBlock(runs[numRuns], start, static_cast<size_t>(end - start));
+      runEvents[numRuns] = end - start;
+      ++numRuns;
+    }
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = static_cast<int64_t>(first);
+         i < static_cast<int64_t>(last); ++i) {
+      const auto box = static_cast<size_t>(i);
+      if (!toLoad(box))
+        continue;
+      const size_t runIndex = runOfBox[box - first];
+      const auto &run = runs[runIndex];
+      const uint64_t numColumns = run.size() / runEvents[runIndex];
+      const auto begin = run.begin() + offsetInRun[box - first] * numColumns;
+      boxes[box]->setEventsData(std::vector<coord_t>(
+          begin, begin + eventIndex[2 * box + 1] * numColumns));
+    }
+    if (progress)
+      progress->reportIncrement(last - first, "Loading Box");
+    first = last;
+  }
+}
+
 } // namespace DataObjects
 } // namespace Mantid
@@ -7,10 +7,13 @@
 #include "MantidDataObjects/MDBoxSaveable.h"
 #include "MantidDataObjects/MDBox.h"
 
+#include <chrono>
+
 namespace Mantid {
 namespace DataObjects {
 
-MDBoxSaveable::MDBoxSaveable(API::IMDNode *const Host) : m_MDNode(Host) {}
+MDBoxSaveable::MDBoxSaveable(API::IMDNode *const Host)
+    : m_MDNode(Host), m_prefetched(false), m_prefetchedSize(0) {}
 
 /** flush data out of the file buffer to the HDD */
 void MDBoxSaveable::flushData() const {
@@ -38,13 +41,55 @@ void MDBoxSaveable::save() const {
  * private function called from the DiskBuffer
  */
 void MDBoxSaveable::load() {
+  const auto start = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(m_loadMutex);
   // Is the data in memory right now (cached copy)?
-  if (!m_isLoaded) {
+  const bool readFile = !m_isLoaded;
+  if (readFile)
+    loadFromFile();
+  if (readFile || m_prefetched) {
     API::IBoxControllerIO *fileIO = m_MDNode->getBoxController()->getFileIO();
-    m_MDNode->loadAndAddFrom(fileIO, this->getFilePosition(),
-                             this->getFileSize());
-    this->setLoaded(true);
+    const std::chrono::duration<double> waitTime =
+        std::chrono::steady_clock::now() - start;
+    fileIO->recordLoad(!readFile, waitTime.count());
+    m_prefetched = false;
+    fileIO->prefetchUsed(this);
   }
 }
+
+/** Loads the data ahead of its use, if it has not been loaded already.
+ * Called from the prefetch thread of the DiskBuffer.
+ * @return the number of events loaded
+ */
+size_t MDBoxSaveable::loadAhead() {
+  std::lock_guard<std::mutex> lock(m_loadMutex);
+  if (m_isLoaded || !this->wasSaved())
+    return 0;
+  loadFromFile();
+  m_prefetched = true;
+  m_prefetchedSize = this->getDataMemorySize();
+  return m_prefetchedSize;
+}
+
+/** Removes the prefetched data from memory, unless it has been used or the
+ * box has been changed since it was prefetched. Called from the prefetch
+ * thread of the DiskBuffer.
+ */
+void MDBoxSaveable::unloadAhead() {
+  std::lock_guard<std::mutex> lock(m_loadMutex);
+  if (!m_prefetched || this->isBusy() ||
+      this->getDataMemorySize() != m_prefetchedSize)
+    return;
+  m_prefetched = false;
+  m_MDNode->clearDataFromMemory();
+}
+
+/// Read the data of the box from the file and mark it as loaded
+void MDBoxSaveable::loadFromFile() {
+  API::IBoxControllerIO *fileIO = m_MDNode->getBoxController()->getFileIO();
+  m_MDNode->loadAndAddFrom(fileIO, this->getFilePosition(),
+                           this->getFileSize());
+  this->setLoaded(true);
+}
 } // namespace DataObjects
 } // namespace Mantid
\ No newline at end of file
@@ -0,0 +1,385 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Number of bins evaluated at a time by a thread
+constexpr size_t BLOCK_SIZE = 1024;
+} // namespace
+
+/// A recorded operation and its operands
+struct MDHistoExpression::Node {
+  Operation operation;
+  /// Operand of a Workspace leaf
+  MDHistoWorkspace_const_sptr workspace;
+  /// Signal of a Scalar leaf
+  signal_t signal = 0.0;
+  /// Squared error of a Scalar leaf
+  signal_t errorSquared = 0.0;
+  /// Filler of Log and Log10, exponent of Power
+  double parameter = 0.0;
+  /// First operand of an operation
+  std::shared_ptr<const Node> lhs;
+  /// Second operand of a binary operation
+  std::shared_ptr<const Node> rhs;
+  /// First workspace found in the operands, or nullptr if there is none
+  const MDHistoWorkspace *firstWorkspace = nullptr;
+};
+
+/** An operation of the flattened expression, which works on a stack of
+ * blocks of bins: leaves push a block and operations replace the blocks of
+ * their operands with the result.
+ */
+struct MDHistoExpression::Instruction {
+  Operation operation;
+  const MDHistoWorkspace *workspace;
+  signal_t signal;
+  signal_t errorSquared;
+  double parameter;
+  /// For binary operations, true if the numbers of events of the result are
+  /// those of the rhs
+  bool eventsFromRhs;
+};
+
+//----------------------------------------------------------------------------------------------
+/** Constructor of an expression made of a workspace
+ * @param workspace :: operand. It must not be modified before the expression
+ * is evaluated.
+ */
+MDHistoExpression::MDHistoExpression(MDHistoWorkspace_const_sptr workspace) {
+  if (!workspace)
+    throw std::invalid_argument("MDHistoExpression: null workspace.");
+  auto node = std::make_shared<Node>();
+  node->operation = Operation::Workspace;
+  node->firstWorkspace = workspace.get();
+  node->workspace = std::move(workspace);
+  m_node = std::move(node);
+}
+
+/** Constructor of an expression made of a scalar
+ * @param signal :: value of the scalar
+ * @param error :: error (not squared) of the scalar
+ */
+MDHistoExpression::MDHistoExpression(const signal_t signal,
+                                     const signal_t error) {
+  auto node = std::make_shared<Node>();
+  node->operation = Operation::Scalar;
+  node->signal = signal;
+  node->errorSquared = error * error;
+  m_node = std::move(node);
+}
+
+/** Constructor of an expression recording an operation
+ * @param operation :: operation to record
+ * @param lhs :: first operand
+ * @param rhs :: second operand of a binary operation, nullptr otherwise
+ * @param parameter :: filler of Log and Log10, exponent of Power
+ * @throw std::invalid_argument if the operands are workspaces of different
+ * sizes
+ */
+MDHistoExpression::MDHistoExpression(const Operation operation,
+                                     const MDHistoExpression &lhs,
+                                     const MDHistoExpression *rhs,
+                                     const double parameter) {
+  auto node = std::make_shared<Node>();
+  node->operation = operation;
+  node->parameter = parameter;
+  node->lhs = lhs.m_node;
+  node->firstWorkspace = lhs.m_node->firstWorkspace;
+  if (rhs) {
+    node->rhs = rhs->m_node;
+    const MDHistoWorkspace *other = rhs->m_node->firstWorkspace;
+    if (!node->firstWorkspace) {
+      node->firstWorkspace = other;
+    } else if (other) {
+      if (other->getNumDims() != node->firstWorkspace->getNumDims())
+        throw std::invalid_argument(
+            "Cannot combine these MDHistoWorkspaces in an expression. The "
+            "number of dimensions does not match.");
+      if (other->getNPoints() != node->firstWorkspace->getNPoints())
+        throw std::invalid_argument(
+            "Cannot combine these MDHistoWorkspaces in an expression. The "
+            "length of the signals vector does not match.");
+    }
+  }
+  m_node = std::move(node);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Record the natural logarithm of the signal, as done by
+ * MDHistoWorkspace::log
+ * @param filler :: value given to bins with a signal <= 0
+ * @return the expression of the logarithm
+ */
+MDHistoExpression MDHistoExpression::log(const double filler) const {
+  return MDHistoExpression(Operation::Log, *this, nullptr, filler);
+}
+
+/** Record the base-10 logarithm of the signal, as done by
+ * MDHistoWorkspace::log10
+ * @param filler :: value given to bins with a signal <= 0
+ * @return the expression of the logarithm
+ */
+MDHistoExpression MDHistoExpression::log10(const double filler) const {
+  return MDHistoExpression(Operation::Log10, *this, nullptr, filler);
+}
+
+/** Record the exponential of the signal, as done by MDHistoWorkspace::exp
+ * @return the expression of the exponential
+ */
+MDHistoExpression MDHistoExpression::exp() const {
+  return MDHistoExpression(Operation::Exp, *this, nullptr, 0.0);
+}
+
+/** Record the signal to a power, as done by MDHistoWorkspace::power
+ * @param exponent :: exponent to apply
+ * @return the expression of the power
+ */
+MDHistoExpression MDHistoExpression::power(const double exponent) const {
+  return MDHistoExpression(Operation::Power, *this, nullptr, exponent);
+}
+
+/// Record the sum of two expressions, as done by MDHistoWorkspace::add
+MDHistoExpression operator+(const MDHistoExpression &lhs,
+                            const MDHistoExpression &rhs) {
+  return MDHistoExpression(MDHistoExpression::Operation::Plus, lhs, &rhs, 0.0);
+}
+
+/// Record the difference of two expressions, as done by
+/// MDHistoWorkspace::subtract
+MDHistoExpression operator-(const MDHistoExpression &lhs,
+                            const MDHistoExpression &rhs) {
+  return MDHistoExpression(MDHistoExpression::Operation::Minus, lhs, &rhs, 0.0);
+}
+
+/// Record the product of two expressions, as done by
+/// MDHistoWorkspace::multiply
+MDHistoExpression operator*(const MDHistoExpression &lhs,
+                            const MDHistoExpression &rhs) {
+  return MDHistoExpression(MDHistoExpression::Operation::Multiply, lhs, &rhs,
+                           0.0);
+}
+
+/// Record the ratio of two expressions, as done by MDHistoWorkspace::divide
+MDHistoExpression operator/(const MDHistoExpression &lhs,
+                            const MDHistoExpression &rhs) {
+  return MDHistoExpression(MDHistoExpression::Operation::Divide, lhs, &rhs,
+                           0.0);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Evaluate the expression. The result is a copy of the first workspace of
+ * the expression, as the output of the algorithms is a copy of their lhs,
+ * with the signals, errors and numbers of events replaced.
+ * @return the new workspace
+ * @throw std::runtime_error if the expression has no workspace
+ */
+MDHistoWorkspace_sptr MDHistoExpression::evaluate() const {
+  const MDHistoWorkspace *first = m_node->firstWorkspace;
+  if (!first)
+    throw std::runtime_error("MDHistoExpression: cannot evaluate an "
+                             "expression without a workspace.");
+  std::vector<Instruction> program;
+  const size_t depth = compile(*m_node, program);
+
+  MDHistoWorkspace_sptr out(first->clone());
+  signal_t *signal = out->mutableSignalArray();
+  signal_t *errorSquared = out->mutableErrorSquaredArray();
+  signal_t *numEvents = out->mutableNumEventsArray();
+  const size_t length = out->getNPoints();
+  const auto numBlocks = static_cast<int64_t>((length + BLOCK_SIZE - 1) /
+                                              BLOCK_SIZE);
+
+  std::exception_ptr error;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t block = 0; block < numBlocks; ++block) {
+    PARALLEL_START_EXCEPTION_REGION
+    // Signal, error and events of each level of the stack; left uninitialised
+    // as every level is written before it is read
+    std::unique_ptr<signal_t[]> stack(new signal_t[3 * depth * BLOCK_SIZE]);
+    const auto begin = static_cast<size_t>(block) * BLOCK_SIZE;
+    const size_t count = std::min(BLOCK_SIZE, length - begin);
+    execute(program, begin, count, stack.get(), signal + begin,
+            errorSquared + begin, numEvents + begin);
+    PARALLEL_END_EXCEPTION_REGION(error)
+  }
+  PARALLEL_CHECK_EXCEPTION_REGION(error)
+  out->updateSum();
+  return out;
+}
+
+/** Flatten the tree of an expression into postfix order
+ * @param node :: root of the tree
+ * @param program :: the instructions are appended to it
+ * @return the number of levels of stack needed to evaluate the tree
+ */
+size_t MDHistoExpression::compile(const Node &node,
+                                  std::vector<Instruction> &program) {
+  size_t depth = 1;
+  if (node.lhs) {
+    depth = compile(*node.lhs, program);
+    if (node.rhs)
+      depth = std::max(depth, compile(*node.rhs, program) + 1);
+  }
+  Instruction instruction;
+  instruction.operation = node.operation;
+  instruction.workspace = node.workspace.get();
+  instruction.signal = node.signal;
+  instruction.errorSquared = node.errorSquared;
+  instruction.parameter = node.parameter;
+  instruction.eventsFromRhs =
+      node.rhs && !node.lhs->firstWorkspace && node.rhs->firstWorkspace;
+  program.emplace_back(instruction);
+  return depth;
+}
+
+/** Evaluate a block of bins
+ * @param program :: the flattened expression
+ * @param begin :: index of the first bin of the block
+ * @param count :: number of bins in the block
+ * @param stack :: buffer for 3 * depth * BLOCK_SIZE values
+ * @param signal :: output signals of the block
+ * @param errorSquared :: output squared errors of the block
+ * @param numEvents :: output numbers of events of the block
+ */
+void MDHistoExpression::execute(const std::vector<Instruction> &program,
+                                const size_t begin, const size_t count,
+                                signal_t *stack, signal_t *signal,
+                                signal_t *errorSquared, signal_t *numEvents) {
+  size_t top = 0;
+  for (const auto &instruction : program) {
+    // Level of the result. Binary operations have their operands at a and b
+    size_t level = top - 2;
+    switch (instruction.operation) {
+    case Operation::Workspace:
+    case Operation::Scalar:
+      level = top;
+      break;
+    case Operation::Log:
+    case Operation::Log10:
+    case Operation::Exp:
+    case Operation::Power:
+      level = top - 1;
+      break;
+    default:
+      break;
+    }
+    signal_t *a = stack + 3 * level * BLOCK_SIZE;
+    signal_t *da2 = a + BLOCK_SIZE;
+    signal_t *na = da2 + BLOCK_SIZE;
+    const signal_t *b = na + BLOCK_SIZE;
+    const signal_t *db2 = b + BLOCK_SIZE;
+    const signal_t *nb = db2 + BLOCK_SIZE;
+
+    switch (instruction.operation) {
+    case Operation::Workspace: {
+      const auto *ws = instruction.workspace;
+      std::copy_n(ws->getSignalArray() + begin, count, a);
+      std::copy_n(ws->getErrorSquaredArray() + begin, count, da2);
+      std::copy_n(ws->getNumEventsArray() + begin, count, na);
+      ++top;
+      break;
+    }
+    case Operation::Scalar:
+      std::fill_n(a, count, instruction.signal);
+      std::fill_n(da2, count, instruction.errorSquared);
+      std::fill_n(na, count, 0.0);
+      ++top;
+      break;
+    case Operation::Plus:
+      for (size_t i = 0; i < count; ++i) {
+        a[i] += b[i];
+        da2[i] += db2[i];
+        na[i] += nb[i];
+      }
+      --top;
+      break;
+    case Operation::Minus:
+      for (size_t i = 0; i < count; ++i) {
+        a[i] -= b[i];
+        da2[i] += db2[i];
+        na[i] += nb[i];
+      }
+      --top;
+      break;
+    case Operation::Multiply:
+      for (size_t i = 0; i < count; ++i) {
+        const signal_t f = a[i] * b[i];
+        da2[i] = da2[i] * b[i] * b[i] + db2[i] * a[i] * a[i];
+        a[i] = f;
+      }
+      if (instruction.eventsFromRhs)
+        std::copy_n(nb, count, na);
+      --top;
+      break;
+    case Operation::Divide:
+      for (size_t i = 0; i < count; ++i) {
+        const signal_t f = a[i] / b[i];
+        da2[i] = da2[i] / (b[i] * b[i]) + db2[i] * f * f / (b[i] * b[i]);
+        a[i] = f;
+      }
+      if (instruction.eventsFromRhs)
+        std::copy_n(nb, count, na);
+      --top;
+      break;
+    case Operation::Log:
+      for (size_t i = 0; i < count; ++i) {
+        if (a[i] <= 0) {
+          a[i] = instruction.parameter;
+          da2[i] = 0;
+        } else {
+          da2[i] = da2[i] / (a[i] * a[i]);
+          a[i] = std::log(a[i]);
+        }
+      }
+      break;
+    case Operation::Log10:
+      for (size_t i = 0; i < count; ++i) {
+        if (a[i] <= 0) {
+          a[i] = instruction.parameter;
+          da2[i] = 0;
+        } else {
+          // 0.1886117  = ln(10)^-2
+          da2[i] = 0.1886117 * da2[i] / (a[i] * a[i]);
+          a[i] = std::log10(a[i]);
+        }
+      }
+      break;
+    case Operation::Exp:
+      for (size_t i = 0; i < count; ++i) {
+        const signal_t f = std::exp(a[i]);
+        da2[i] = f * f * da2[i];
+        a[i] = f;
+      }
+      break;
+    case Operation::Power: {
+      const double exponent = instruction.parameter;
+      const double exponentSquared = exponent * exponent;
+      for (size_t i = 0; i < count; ++i) {
+        const signal_t f = std::pow(a[i], exponent);
+        da2[i] = f * f * exponentSquared * da2[i] / (a[i] * a[i]);
+        a[i] = f;
+      }
+      break;
+    }
+    }
+  }
+  std::copy_n(stack, count, signal);
+  std::copy_n(stack + BLOCK_SIZE, count, errorSquared);
+  std::copy_n(stack + 2 * BLOCK_SIZE, count, numEvents);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -17,6 +17,7 @@
 #include "MantidKernel/VMD.h"
 #include "MantidKernel/WarningSuppressions.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <boost/scoped_array.hpp>
 #include <cmath>
@@ -64,14 +65,16 @@ MDHistoWorkspace::MDHistoWorkspace(
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
  * @param displayNormalization :: optional display normalization to use as the
  * default.
+ * @param sparse :: if true, start with the sparse storage, with no bin holding
+ * data, rather than allocating the dense arrays.
  */
 MDHistoWorkspace::MDHistoWorkspace(
     std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
-    Mantid::API::MDNormalization displayNormalization)
+    Mantid::API::MDNormalization displayNormalization, const bool sparse)
     : IMDHistoWorkspace(), numDimensions(0),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
       m_coordSystem(None), m_displayNormalization(displayNormalization) {
-  this->init(dimensions);
+  this->init(dimensions, sparse);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -79,14 +82,16 @@ MDHistoWorkspace::MDHistoWorkspace(
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
  * @param displayNormalization :: optional display normalization to use as the
  * default.
+ * @param sparse :: if true, start with the sparse storage, with no bin holding
+ * data, rather than allocating the dense arrays.
  */
 MDHistoWorkspace::MDHistoWorkspace(
     std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
-    Mantid::API::MDNormalization displayNormalization)
+    Mantid::API::MDNormalization displayNormalization, const bool sparse)
     : IMDHistoWorkspace(), numDimensions(0),
       m_nEventsContributed(std::numeric_limits<uint64_t>::quiet_NaN()),
       m_coordSystem(None), m_displayNormalization(displayNormalization) {
-  this->init(dimensions);
+  this->init(dimensions, sparse);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -101,6 +106,17 @@ MDHistoWorkspace::MDHistoWorkspace(const MDHistoWorkspace &other)
       m_displayNormalization(other.m_displayNormalization) {
   // Dimensions are copied by the copy constructor of MDGeometry
   this->cacheValues();
+  if (other.m_sparse) {
+    std::lock_guard<std::mutex> lock(other.m_sparseMutex);
+    if (other.m_sparse) {
+      m_sparseSignals = other.m_sparseSignals;
+      m_sparseErrorsSquared = other.m_sparseErrorsSquared;
+      m_sparseNumEvents = other.m_sparseNumEvents;
+      m_sparseMasks = other.m_sparseMasks;
+      m_sparse = true;
+      return;
+    }
+  }
   // Allocate the linear arrays
   m_signals = std::vector<signal_t>(m_length);
   m_errorsSquared = std::vector<signal_t>(m_length);
@@ -118,14 +134,15 @@ MDHistoWorkspace::MDHistoWorkspace(const MDHistoWorkspace &other)
  * @param dimensions :: vector of MDHistoDimension; no limit to how many.
  */
 void MDHistoWorkspace::init(
-    std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions) {
+    std::vector<Mantid::Geometry::MDHistoDimension_sptr> &dimensions,
+    const bool sparse) {
   std::vector<IMDDimension_sptr> dim2;
   dim2.reserve(dimensions.size());
   std::transform(dimensions.cbegin(), dimensions.cend(),
                  std::back_inserter(dim2), [](const auto dimension) {
                    return std::dynamic_pointer_cast<IMDDimension>(dimension);
                  });
-  this->init(dim2);
+  this->init(dim2, sparse);
   m_nEventsContributed = 0;
 }
 
@@ -134,17 +151,33 @@ void MDHistoWorkspace::init(
  * @param dimensions :: vector of IMDDimension; no limit to how many.
  */
 void MDHistoWorkspace::init(
-    std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions) {
+    std::vector<Mantid::Geometry::IMDDimension_sptr> &dimensions,
+    const bool sparse) {
   MDGeometry::initGeometry(dimensions);
   this->cacheValues();
 
+  signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+  freeSparseStorage();
+  m_sparse = sparse;
+  if (sparse) {
+    // No tiles are allocated until the bins are given values
+    std::vector<signal_t>().swap(m_signals);
+    std::vector<signal_t>().swap(m_errorsSquared);
+    std::vector<signal_t>().swap(m_numEvents);
+    m_masks.reset();
+    m_sparseSignals.assign(m_length, nan);
+    m_sparseErrorsSquared.assign(m_length, nan);
+    m_sparseNumEvents.assign(m_length, 0.0);
+    m_sparseMasks.assign(m_length, false);
+    return;
+  }
+
   // Allocate the linear arrays
   m_signals = std::vector<signal_t>(m_length);
   m_errorsSquared = std::vector<signal_t>(m_length);
   m_numEvents = std::vector<signal_t>(m_length);
   m_masks = std::make_unique<bool[]>(m_length);
   // Initialize them to NAN (quickly)
-  signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
   this->setTo(nan, nan, nan);
   m_nEventsContributed = 0;
 }
@@ -247,11 +280,19 @@ void MDHistoWorkspace::initVertexesArray() {
  */
 void MDHistoWorkspace::setTo(signal_t signal, signal_t errorSquared,
                              signal_t numEvents) {
+  m_nEventsContributed = static_cast<uint64_t>(numEvents) * m_length;
+  if (m_sparse) {
+    // Every bin has the fill value, so all the tiles are freed
+    m_sparseSignals.assign(m_length, signal);
+    m_sparseErrorsSquared.assign(m_length, errorSquared);
+    m_sparseNumEvents.assign(m_length, numEvents);
+    m_sparseMasks.assign(m_length, false);
+    return;
+  }
   std::fill_n(m_signals.begin(), m_length, signal);
   std::fill_n(m_errorsSquared.begin(), m_length, errorSquared);
   std::fill_n(m_numEvents.begin(), m_length, numEvents);
   std::fill_n(m_masks.get(), m_length, false);
-  m_nEventsContributed = static_cast<uint64_t>(numEvents) * m_length;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -275,10 +316,10 @@ void MDHistoWorkspace::applyImplicitFunction(
         coord[2] = m_dimensions[2]->getX(z);
 
         if (!function->isPointContained(coord)) {
-          m_signals[x + indexMultiplier[0] * y + indexMultiplier[1] * z] =
-              signal;
-          m_errorsSquared[x + indexMultiplier[0] * y + indexMultiplier[1] * z] =
-              errorSquared;
+          const size_t index =
+              x + indexMultiplier[0] * y + indexMultiplier[1] * z;
+          setSignalAt(index, signal);
+          setErrorSquaredAt(index, errorSquared);
         }
       }
     }
@@ -363,7 +404,7 @@ signal_t MDHistoWorkspace::getSignalAtCoord(
   size_t linearIndex = this->getLinearIndexAtCoord(coords);
   if (linearIndex < m_length) {
     signal_t normalizer = getNormalizationFactor(normalization, linearIndex);
-    return m_signals[linearIndex] * normalizer;
+    return storedSignal(linearIndex) * normalizer;
   } else
     return std::numeric_limits<signal_t>::quiet_NaN();
 }
@@ -451,6 +492,10 @@ MDHistoWorkspace::createIterators(
 //----------------------------------------------------------------------------------------------
 /** Return the memory used, in bytes */
 size_t MDHistoWorkspace::getMemorySize() const {
+  if (m_sparse)
+    return m_sparseSignals.getMemorySize() +
+           m_sparseErrorsSquared.getMemorySize() +
+           m_sparseNumEvents.getMemorySize() + m_sparseMasks.getMemorySize();
   return m_length * (sizeOfElement());
 }
 
@@ -460,7 +505,7 @@ std::vector<signal_t> MDHistoWorkspace::getSignalDataVector() const {
   std::vector<signal_t> out;
   out.resize(m_length, 0.0);
   for (size_t i = 0; i < m_length; ++i)
-    out[i] = m_signals[i];
+    out[i] = storedSignal(i);
   // This copies again! :(
   return out;
 }
@@ -470,7 +515,7 @@ std::vector<signal_t> MDHistoWorkspace::getErrorDataVector() const {
   std::vector<signal_t> out;
   out.resize(m_length, 0.0);
   for (size_t i = 0; i < m_length; ++i)
-    out[i] = m_errorsSquared[i];
+    out[i] = storedErrorSquared(i);
   // This copies again! :(
   return out;
 }
@@ -670,7 +715,7 @@ MDHistoWorkspace::getNormalizationFactor(const MDNormalization &normalize,
   case VolumeNormalization:
     return m_inverseVolume;
   case NumEventsNormalization:
-    return 1.0 / m_numEvents[linearIndex];
+    return 1.0 / getNumEventsAt(linearIndex);
   }
   return normalizer;
 }
@@ -764,6 +809,8 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * @param b :: workspace on the RHS of the operation
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "add");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] += b.m_signals[i];
@@ -780,6 +827,7 @@ void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
  * @param error :: error (not squared) to apply
  * */
 void MDHistoWorkspace::add(const signal_t signal, const signal_t error) {
+  makeDense();
   signal_t errorSquared = error * error;
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] += signal;
@@ -803,6 +851,8 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * @param b :: workspace on the RHS of the operation
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "subtract");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] -= b.m_signals[i];
@@ -819,6 +869,7 @@ void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
  * @param error :: error (not squared) to apply
  * */
 void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error) {
+  makeDense();
   signal_t errorSquared = error * error;
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] -= signal;
@@ -851,6 +902,8 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * @param b_ws :: workspace on the RHS of the operation
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
+  makeDense();
+  b_ws.makeDense();
   checkWorkspaceSize(b_ws, "multiply");
   for (size_t i = 0; i < m_length; ++i) {
     signal_t a = m_signals[i];
@@ -880,6 +933,7 @@ void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
  * @param error :: error (not squared) to apply
  * @return *this after operation */
 void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
+  makeDense();
   signal_t b = signal;
   signal_t db2 = error * error;
 
@@ -920,6 +974,8 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  * @param b_ws :: workspace on the RHS of the operation
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
+  makeDense();
+  b_ws.makeDense();
   checkWorkspaceSize(b_ws, "divide");
   for (size_t i = 0; i < m_length; ++i) {
     signal_t a = m_signals[i];
@@ -949,6 +1005,7 @@ void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
  * @param error :: error (not squared) to apply
  **/
 void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
+  makeDense();
   signal_t b = signal;
   signal_t db2 = error * error;
   signal_t db2_relative = db2 / (b * b);
@@ -971,6 +1028,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
  * \f$ df^2 = a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log(double filler) {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
@@ -991,6 +1049,7 @@ void MDHistoWorkspace::log(double filler) {
  * \f$ df^2 = (ln(10)^-2) * a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log10(double filler) {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
@@ -1011,6 +1070,7 @@ void MDHistoWorkspace::log10(double filler) {
  * \f$ df^2 = f^2 * da^2 \f$
  */
 void MDHistoWorkspace::exp() {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     signal_t f = std::exp(m_signals[i]);
     signal_t da2 = m_errorsSquared[i];
@@ -1027,6 +1087,7 @@ void MDHistoWorkspace::exp() {
  * \f$ df^2 = f^2 * b^2 * (da^2 / a^2) \f$
  */
 void MDHistoWorkspace::power(double exponent) {
+  makeDense();
   double exponent_squared = exponent * exponent;
   for (size_t i = 0; i < m_length; ++i) {
     signal_t a = m_signals[i];
@@ -1052,6 +1113,8 @@ void MDHistoWorkspace::power(double exponent) {
  * @param b :: workspace on the RHS of the operation
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "&= (and)");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) &&
@@ -1072,6 +1135,8 @@ MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
  * @param b :: workspace on the RHS of the operation
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "|= (or)");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ||
@@ -1092,6 +1157,8 @@ MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
  * @param b :: workspace on the RHS of the operation
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "^= (xor)");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ^
@@ -1110,6 +1177,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
  * 0.0 is "false", all other values are "true". All errors are set to 0.
  */
 void MDHistoWorkspace::operatorNot() {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = (m_signals[i] == 0.0 || m_masks[i]);
     m_errorsSquared[i] = 0;
@@ -1125,6 +1193,8 @@ void MDHistoWorkspace::operatorNot() {
  * @param b :: workspace on the RHS of the comparison.
  */
 void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "lessThan");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = (m_signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
@@ -1141,6 +1211,7 @@ void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::lessThan(const signal_t signal) {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = (m_signals[i] < signal) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
@@ -1156,6 +1227,8 @@ void MDHistoWorkspace::lessThan(const signal_t signal) {
  * @param b :: workspace on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "greaterThan");
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = (m_signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
@@ -1172,6 +1245,7 @@ void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const signal_t signal) {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     m_signals[i] = (m_signals[i] > signal) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
@@ -1189,6 +1263,8 @@ void MDHistoWorkspace::greaterThan(const signal_t signal) {
  */
 void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b,
                                const signal_t tolerance) {
+  makeDense();
+  b.makeDense();
   checkWorkspaceSize(b, "equalTo");
   for (size_t i = 0; i < m_length; ++i) {
     signal_t diff = fabs(m_signals[i] - b.m_signals[i]);
@@ -1208,6 +1284,7 @@ void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b,
  */
 void MDHistoWorkspace::equalTo(const signal_t signal,
                                const signal_t tolerance) {
+  makeDense();
   for (size_t i = 0; i < m_length; ++i) {
     signal_t diff = fabs(m_signals[i] - signal);
     m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
@@ -1233,6 +1310,9 @@ void MDHistoWorkspace::equalTo(const signal_t signal,
  */
 void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
                                     const MDHistoWorkspace &values) {
+  makeDense();
+  mask.makeDense();
+  values.makeDense();
   checkWorkspaceSize(mask, "setUsingMask");
   checkWorkspaceSize(values, "setUsingMask");
   for (size_t i = 0; i < m_length; ++i) {
@@ -1263,6 +1343,8 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
 void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask,
                                     const signal_t signal,
                                     const signal_t error) {
+  makeDense();
+  mask.makeDense();
   signal_t errorSquared = error * error;
   checkWorkspaceSize(mask, "setUsingMask");
   for (size_t i = 0; i < m_length; ++i) {
@@ -1297,7 +1379,10 @@ void MDHistoWorkspace::setMDMasking(
  * @param mask : True to mask. False to clear.
  */
 void MDHistoWorkspace::setMDMaskAt(const size_t &index, bool mask) {
-  m_masks[index] = mask;
+  if (m_sparse)
+    m_sparseMasks.set(index, mask);
+  else
+    m_masks[index] = mask;
   if (mask) {
     // Set signal and error of masked points to the value of MDMaskValue
     this->setSignalAt(index, MDMaskValue);
@@ -1311,6 +1396,10 @@ void MDHistoWorkspace::setMDMaskAt(const size_t &index, bool mask) {
  * which was set to NaN when it was masked.
  */
 void MDHistoWorkspace::clearMDMasking() {
+  if (m_sparse) {
+    m_sparseMasks.assign(m_length, false);
+    return;
+  }
   for (size_t i = 0; i < this->getNPoints(); ++i) {
     m_masks[i] = false;
   }
@@ -1319,7 +1408,7 @@ void MDHistoWorkspace::clearMDMasking() {
 uint64_t MDHistoWorkspace::getNEvents() const {
   volatile uint64_t cach = this->m_nEventsContributed;
   if (cach != this->m_nEventsContributed) {
-    if (m_numEvents.empty())
+    if (m_numEvents.empty() && !m_sparse)
       m_nEventsContributed = std::numeric_limits<uint64_t>::quiet_NaN();
     else
       m_nEventsContributed = sumNContribEvents();
@@ -1329,12 +1418,133 @@ uint64_t MDHistoWorkspace::getNEvents() const {
 
 uint64_t MDHistoWorkspace::sumNContribEvents() const {
   uint64_t sum(0);
+  if (m_sparse) {
+    // The empty tiles all hold the fill value
+    constexpr size_t tileSize = SparseTileArray<signal_t>::TILE_SIZE;
+    for (size_t t = 0; t < m_sparseNumEvents.numTiles(); ++t) {
+      const size_t count = std::min(tileSize, m_length - t * tileSize);
+      if (const auto *tile = m_sparseNumEvents.tile(t)) {
+        for (size_t i = 0; i < count; ++i)
+          sum += uint64_t(tile[i]);
+      } else if (m_sparseNumEvents.fill() > 0.0) {
+        // A NaN fill value counts no events
+        sum += uint64_t(m_sparseNumEvents.fill()) * count;
+      }
+    }
+    return sum;
+  }
   for (size_t i = 0; i < m_length; ++i)
     sum += uint64_t(m_numEvents[i]);
 
   return sum;
 }
 
+//----------------------------------------------------------------------------------------------
+/** Switch between the dense storage of the bins, in arrays covering the whole
+ * grid, and the sparse storage, in tiles of SparseTileArray::TILE_SIZE bins
+ * allocated when one of their bins is first given a value. The bins of the
+ * tiles that are not allocated are empty: a signal and an error of 0 (or NaN,
+ * for the signals or errors that are more often NaN than 0), no events and no
+ * mask. The values of the bins are kept. A workspace can also be made sparse
+ * from the start, without allocating the dense arrays, by the constructors.
+ *
+ * The single-bin accessors work on either storage. The direct pointers to the
+ * arrays (getSignalArray() etc.) and the arithmetic operations switch the
+ * workspace back to the dense storage and free the tiles. Among the
+ * algorithms, those densifying a sparse input are the binary, boolean and
+ * unary operations on MD histograms (PlusMD, AndMD, PowerMD, ...),
+ * SetMDUsingMask, SaveMD, SaveZODS, ConvertMDHistoToMatrixWorkspace,
+ * TransformMD and SINQTranspose3D, as are the getSignalArray() family of the
+ * Python interface.
+ *
+ * @param sparse :: true to use the sparse storage
+ */
+void MDHistoWorkspace::setSparse(const bool sparse) {
+  if (!sparse) {
+    makeDense();
+    return;
+  }
+  if (m_sparse)
+    return;
+  m_sparseSignals.assign(m_signals.data(), m_length, emptyValue(m_signals));
+  m_sparseErrorsSquared.assign(m_errorsSquared.data(), m_length,
+                               emptyValue(m_errorsSquared));
+  m_sparseNumEvents.assign(m_numEvents.data(), m_length, 0.0);
+  m_sparseMasks.assign(m_masks.get(), m_length, false);
+  std::vector<signal_t>().swap(m_signals);
+  std::vector<signal_t>().swap(m_errorsSquared);
+  std::vector<signal_t>().swap(m_numEvents);
+  m_masks.reset();
+  m_sparse = true;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Find the next bin that may hold data. With the sparse storage, the tiles
+ * that are not allocated in any of the arrays are skipped.
+ *
+ * @param index :: linear index to start from
+ * @return index itself if it may hold data, else the first bin of the next
+ * tile holding data, or the number of bins if there is none.
+ */
+size_t MDHistoWorkspace::skipEmptyTiles(const size_t index) const {
+  if (!m_sparse)
+    return index;
+  constexpr size_t tileSize = SparseTileArray<signal_t>::TILE_SIZE;
+  for (size_t i = index; i < m_length; i = (i / tileSize + 1) * tileSize) {
+    if (m_sparseSignals.isStored(i) || m_sparseErrorsSquared.isStored(i) ||
+        m_sparseNumEvents.isStored(i) || m_sparseMasks.isStored(i))
+      return i;
+  }
+  return m_length;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Switch back to the dense storage, if the workspace is sparse, and free the
+ * tiles, so that the workspace takes no more memory than a dense one.
+ * Const, and locked, because the direct pointers to the arrays need the
+ * dense storage even for a const workspace, so several threads may ask for
+ * them at once. The switch must not overlap the reading of single bins on
+ * other threads, which do not take the lock: algorithms reading a sparse
+ * workspace in parallel should get its arrays first.
+ */
+void MDHistoWorkspace::makeDense() const {
+  if (!m_sparse)
+    return;
+  std::lock_guard<std::mutex> lock(m_sparseMutex);
+  if (!m_sparse)
+    return;
+  m_signals.resize(m_length);
+  m_errorsSquared.resize(m_length);
+  m_numEvents.resize(m_length);
+  m_masks = std::make_unique<bool[]>(m_length);
+  m_sparseSignals.copyTo(m_signals.data());
+  m_sparseErrorsSquared.copyTo(m_errorsSquared.data());
+  m_sparseNumEvents.copyTo(m_numEvents.data());
+  m_sparseMasks.copyTo(m_masks.get());
+  m_sparse = false;
+  freeSparseStorage();
+}
+
+/// Free the tiles of the sparse storage, which must not be in use
+void MDHistoWorkspace::freeSparseStorage() const {
+  m_sparseSignals = SparseTileArray<signal_t>();
+  m_sparseErrorsSquared = SparseTileArray<signal_t>();
+  m_sparseNumEvents = SparseTileArray<signal_t>();
+  m_sparseMasks = SparseTileArray<bool>();
+}
+
+/** @return the value of the empty bins of a dense array for the sparse
+ * storage: NaN if the array holds more NaN than zeros, else 0
+ * @param values :: the dense array
+ */
+signal_t MDHistoWorkspace::emptyValue(const std::vector<signal_t> &values) {
+  const auto nans =
+      std::count_if(values.cbegin(), values.cend(),
+                    [](const signal_t value) { return std::isnan(value); });
+  const auto zeros = std::count(values.cbegin(), values.cend(), 0.0);
+  return nans > zeros ? std::numeric_limits<signal_t>::quiet_NaN() : 0.0;
+}
+
 /**
  * Get the Q frame system (if any) to use.
  */
@@ -196,6 +196,10 @@ void MDHistoWorkspaceIterator::init(
   }
   Utils::NestedForLoop::SetUpIndexMaker(m_nd, m_indexMaker, m_indexMax);
 
+  // Start at the first tile with data of a sparse workspace
+  if (!m_function && m_skippingPolicy->skipEmptyTiles())
+    m_pos = std::min(m_max, m_ws->skipEmptyTiles(m_pos));
+
   // Initialize the current index from the start position.
   Utils::NestedForLoop::GetIndicesFromLinearIndex(m_nd, m_pos, m_indexMaker,
                                                   m_indexMax, m_index);
@@ -328,6 +332,9 @@ bool MDHistoWorkspaceIterator::next() {
     // still valid.
     do {
       m_pos++;
+      // Jump over the tiles of a sparse workspace without data
+      if (m_skippingPolicy->skipEmptyTiles())
+        m_pos = std::min(m_max, m_ws->skipEmptyTiles(m_pos));
     } while (m_pos < m_max && m_skippingPolicy->keepGoing());
   }
 
@@ -0,0 +1,112 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/BinEdgeIndexer.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+using Mantid::Types::Event::TofEvent;
+
+class BinEdgeIndexerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BinEdgeIndexerTest *createSuite() { return new BinEdgeIndexerTest(); }
+  static void destroySuite(BinEdgeIndexerTest *suite) { delete suite; }
+
+  void test_detects_linear_bins() {
+    MantidVec X;
+    Kernel::VectorHelper::createAxisFromRebinParams({100., 3.7, 20000.}, X);
+    BinEdgeIndexer indexer(X);
+    TS_ASSERT_EQUALS(indexer.spacing(), BinEdgeIndexer::Spacing::Linear);
+    TS_ASSERT_EQUALS(indexer.numberOfBins(), X.size() - 1);
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_detects_logarithmic_bins() {
+    MantidVec X;
+    Kernel::VectorHelper::createAxisFromRebinParams({100., -0.003, 20000.}, X);
+    BinEdgeIndexer indexer(X);
+    TS_ASSERT_EQUALS(indexer.spacing(), BinEdgeIndexer::Spacing::Logarithmic);
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_fine_logarithmic_bins_over_many_decades() {
+    MantidVec X;
+    Kernel::VectorHelper::createAxisFromRebinParams({0.05, -0.0002, 5000.}, X);
+    BinEdgeIndexer indexer(X);
+    TS_ASSERT_EQUALS(indexer.spacing(), BinEdgeIndexer::Spacing::Logarithmic);
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_arbitrary_bins() {
+    const MantidVec X{1., 2., 5., 6., 100., 1000.};
+    BinEdgeIndexer indexer(X);
+    TS_ASSERT_EQUALS(indexer.spacing(), BinEdgeIndexer::Spacing::Arbitrary);
+    checkAgainstSearch(X, indexer);
+  }
+
+  void test_values_outside_bins() {
+    const MantidVec X{0., 1., 2., 3.};
+    BinEdgeIndexer indexer(X);
+    TS_ASSERT_EQUALS(indexer.index(-0.1), BinEdgeIndexer::npos);
+    TS_ASSERT_EQUALS(indexer.index(3.), BinEdgeIndexer::npos);
+    TS_ASSERT_EQUALS(indexer.index(std::nan("")), BinEdgeIndexer::npos);
+    TS_ASSERT_EQUALS(indexer.index(0.), 0);
+    TS_ASSERT_EQUALS(indexer.index(2.), 2);
+  }
+
+  void test_no_bins() {
+    const MantidVec X{1.};
+    BinEdgeIndexer indexer(X);
+    TS_ASSERT_EQUALS(indexer.numberOfBins(), 0);
+    TS_ASSERT_EQUALS(indexer.index(1.), BinEdgeIndexer::npos);
+  }
+
+  void test_unsorted_EventList_histogram_matches_sorted() {
+    EventList el;
+    for (int i = 0; i < 1000; ++i)
+      el += TofEvent(static_cast<double>((i * 7919) % 1000) + 0.5, i);
+    el.switchTo(API::WEIGHTED);
+    EventList sorted(el);
+    sorted.sortTof();
+
+    MantidVec X;
+    Kernel::VectorHelper::createAxisFromRebinParams({0., 12.5, 1000.}, X);
+    MantidVec Y, E, sortedY, sortedE;
+    el.generateHistogram(X, Y, E);
+    sorted.generateHistogram(X, sortedY, sortedE);
+    // histogramming linear bins must not sort the list
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(Y, sortedY);
+    TS_ASSERT_EQUALS(E, sortedE);
+  }
+
+private:
+  void checkAgainstSearch(const MantidVec &X, const BinEdgeIndexer &indexer) {
+    std::vector<double> values(X.cbegin(), X.cend());
+    const double width = X.back() - X.front();
+    for (size_t i = 0; i < 5000; ++i)
+      values.emplace_back(X.front() - 1. +
+                          (width + 2.) * static_cast<double>(i) / 5000.);
+    for (size_t i = 0; i < values.size(); ++i) {
+      const double x = values[i];
+      size_t expected = BinEdgeIndexer::npos;
+      if (x >= X.front() && x < X.back())
+        expected = std::upper_bound(X.cbegin(), X.cend(), x) - X.cbegin() - 1;
+      TS_ASSERT_EQUALS(indexer.index(x), expected);
+    }
+  }
+};
@@ -125,6 +125,29 @@ public:
                                ct.applyVMD(VMD(1.0, 2.0, 3.0)));
   }
 
+  /** applyBatch() gives exactly the same points as apply() */
+  void test_applyBatch() {
+    CoordTransformAffine ct(3, 2);
+    std::vector<VMD> bases{{cos(0.1), sin(0.1), 0.0},
+                           {-sin(0.1), cos(0.1), 0.0}};
+    ct.buildOrthogonal(VMD(1.0, 2.0, 3.0), bases, VMD(2.0, 0.5));
+
+    const size_t numPoints = 5;
+    std::vector<coord_t> in(3 * numPoints);
+    for (size_t i = 0; i < in.size(); ++i)
+      in[i] = static_cast<coord_t>(i) * 0.7f - 3.f;
+    std::vector<coord_t> out(2 * numPoints);
+    ct.applyBatch(in.data(), out.data(), numPoints);
+
+    for (size_t i = 0; i < numPoints; ++i) {
+      coord_t point[3] = {in[i], in[numPoints + i], in[2 * numPoints + i]};
+      coord_t expected[2];
+      ct.apply(point, expected);
+      TS_ASSERT_EQUALS(out[i], expected[0]);
+      TS_ASSERT_EQUALS(out[numPoints + i], expected[1]);
+    }
+  }
+
   /** Test rotation in isolation */
   void test_rotation() {
     using Mantid::Kernel::V3D;
@@ -423,4 +446,16 @@ public:
       ct.apply(in, out);
     }
   }
+  void test_applyBatch_4D_performance() {
+    CoordTransformAffine ct(4, 4);
+    coord_t translation[4] = {2.0, 3.0, 4.0, 5.0};
+    ct.addTranslation(translation);
+    const size_t numPoints = 1000;
+    std::vector<coord_t> in(4 * numPoints, 1.5);
+    std::vector<coord_t> out(4 * numPoints);
+
+    for (size_t i = 0; i < 1000 * 10; ++i) {
+      ct.applyBatch(in.data(), out.data(), numPoints);
+    }
+  }
 };
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidDataObjects/BinEdgeIndexer.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Histogram1D.h"
@@ -735,6 +736,28 @@ public:
     }
   }
 
+  void test_histogram_with_an_indexer_of_shared_bins() {
+    // Go through each possible EventType as the input
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_data(static_cast<EventType>(this_type));
+      const MantidVec X = this->makeX(1e5, 100);
+      // Built once for all the spectra with these bins
+      const BinEdgeIndexer indexer(X);
+      MantidVec Y, E;
+      el.generateHistogram(indexer, Y, E);
+
+      // The same histogram as the search of the edges of sorted events
+      el.sortTof();
+      MantidVec sortedY, sortedE;
+      el.generateHistogram(X, sortedY, sortedE);
+      TS_ASSERT_EQUALS(Y.size(), sortedY.size());
+      for (std::size_t i = 0; i < std::min(Y.size(), sortedY.size()); i++) {
+        TSM_ASSERT_EQUALS(this_type, Y[i], sortedY[i]);
+        TSM_ASSERT_DELTA(this_type, E[i], sortedE[i], 1e-12);
+      }
+    }
+  }
+
   //==================================================================================
   //--- Sorting Tests ---
   //==================================================================================
@@ -1681,6 +1704,35 @@ public:
     }
   }
 
+  void test_sort_long_lists_use_integer_keys() {
+    // Long enough for the radix sort, with negative time-of-flight and a
+    // large common pulse time offset
+    EventList el;
+    srand(1234);
+    const int64_t runStart = 1000000000000000000;
+    for (int i = 0; i < 5000; i++)
+      el += TofEvent(1e4 * (rand() * 1.0 / RAND_MAX) - 5e3,
+                     runStart + 1000 * (rand() % 100));
+
+    for (int this_type = 0; this_type < 2; this_type++) {
+      EventList copy(el);
+      copy.switchTo(static_cast<EventType>(this_type));
+      copy.sortPulseTimeTOF();
+      for (size_t i = 1; i < copy.getNumberEvents(); i++) {
+        TS_ASSERT_LESS_THAN_EQUALS(copy.getEvent(i - 1).pulseTime(),
+                                   copy.getEvent(i).pulseTime());
+        if (copy.getEvent(i - 1).pulseTime() == copy.getEvent(i).pulseTime())
+          TS_ASSERT_LESS_THAN_EQUALS(copy.getEvent(i - 1).tof(),
+                                     copy.getEvent(i).tof());
+      }
+      copy.sortTof();
+      for (size_t i = 1; i < copy.getNumberEvents(); i++)
+        TS_ASSERT_LESS_THAN_EQUALS(copy.getEvent(i - 1).tof(),
+                                   copy.getEvent(i).tof());
+      TS_ASSERT_EQUALS(copy.getNumberEvents(), 5000);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_filterByPulseTime() {
     // Go through each possible EventType (except the no-time one) as the input
@@ -1964,6 +2016,75 @@ public:
     return;
   }
 
+  /** Split by full time with fewer splitters than events, which walks the
+   * events and splitters together
+   */
+  void test_splitByFullTimeSparseVectorSplitter() {
+    // 1000 events with pulse times 0 to 999 ms and TOFs below 1 ms
+    fake_uniform_time_sns_data();
+
+    std::map<int, EventList *> outputs;
+    for (int i = -1; i < 4; i++)
+      outputs.emplace(i, new EventList());
+
+    // 80 splitters of 10 ms from 100 ms to 900 ms, cycling through 4 groups
+    std::vector<int64_t> vec_splitTimes;
+    std::vector<int> vec_splitGroup;
+    for (int64_t time = 100; time <= 900; time += 10)
+      vec_splitTimes.emplace_back(time * 1000000);
+    for (int i = 0; i < 80; i++)
+      vec_splitGroup.emplace_back(i % 4);
+    el.splitByFullTimeMatrixSplitter(vec_splitTimes, vec_splitGroup, outputs,
+                                     false, 1.0, 0.0);
+
+    // Events outside the splitters are dropped
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 0);
+    for (int i = 0; i < 4; i++) {
+      TS_ASSERT_EQUALS(outputs[i]->getNumberEvents(), 200);
+      for (const auto &event : outputs[i]->getEvents()) {
+        const int64_t time = event.pulseTime().totalNanoseconds() / 1000000;
+        TS_ASSERT_EQUALS((time - 100) / 10 % 4, i);
+      }
+    }
+
+    for (auto &output : outputs)
+      delete output.second;
+  }
+
+  /** Split by pulse time with many splitters, most of which have no events
+   */
+  void test_splitByPulseTimeWithMatrix() {
+    // 1000 events with pulse times 0 to 999 ms
+    fake_uniform_time_sns_data();
+
+    std::map<int, EventList *> outputs;
+    for (int i = -1; i < 4; i++)
+      outputs.emplace(i, new EventList());
+
+    // Splitters of 0.25 ms from 100 ms to 900 ms; the group changes every ms
+    std::vector<int64_t> vec_times;
+    std::vector<int> vec_target;
+    for (int64_t time = 400; time <= 3600; time++)
+      vec_times.emplace_back(time * 250000);
+    for (int i = 0; i < 3200; i++)
+      vec_target.emplace_back(i / 4 % 4);
+    el.splitByPulseTimeWithMatrix(vec_times, vec_target, outputs);
+
+    // Events before the first splitter are unfiltered, events after the last
+    // splitter are dropped
+    TS_ASSERT_EQUALS(outputs[-1]->getNumberEvents(), 100);
+    for (int i = 0; i < 4; i++) {
+      TS_ASSERT_EQUALS(outputs[i]->getNumberEvents(), 200);
+      for (const auto &event : outputs[i]->getEvents()) {
+        const int64_t time = event.pulseTime().totalNanoseconds() / 1000000;
+        TS_ASSERT_EQUALS((time - 100) % 4, i);
+      }
+    }
+
+    for (auto &output : outputs)
+      delete output.second;
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2237,6 +2358,105 @@ public:
     TS_ASSERT_DELTA(el_weight_output.integrate(XMIN, XMAX, true), 2., .0001);
   }
 
+  void test_compressAndAddEvents() {
+    // Add the events in two blocks, interleaved in TOF
+    this->fake_uniform_data();
+    std::vector<TofEvent> first, second;
+    const auto &events = el.getEvents();
+    for (size_t i = 0; i < events.size(); ++i)
+      (i % 2 == 0 ? first : second).emplace_back(events[i]);
+    EventList blocks;
+    TS_ASSERT_THROWS_NOTHING(blocks.compressAndAddEvents(first, 1.));
+    TS_ASSERT(first.empty());
+    TS_ASSERT_THROWS_NOTHING(blocks.compressAndAddEvents(second, 1.));
+    TS_ASSERT_EQUALS(blocks.getEventType(), WEIGHTED_NOTIME);
+    TS_ASSERT(blocks.isSortedByTof());
+
+    // Events further apart than the tolerance stay apart, as when compressing
+    // them all at once
+    EventList once;
+    el.compressEvents(1., &once);
+    TS_ASSERT_EQUALS(blocks, once);
+
+    // Events of the two blocks within the tolerance are combined
+    first.assign(events.cbegin(), events.cend());
+    second.assign(events.cbegin(), events.cend());
+    EventList combined;
+    combined.compressAndAddEvents(first, 1.);
+    combined.compressAndAddEvents(second, 1.);
+    TS_ASSERT_EQUALS(combined.getNumberEvents(), el.getNumberEvents());
+    TS_ASSERT_DELTA(combined.integrate(0., 0., true),
+                    2. * static_cast<double>(el.getNumberEvents()), 1e-6);
+  }
+
+  void test_compressAndAddEvents_does_not_move_compressed_events() {
+    // One event per block, each 0.6 after the previous one. Compressing the
+    // whole list again would chain them all into a single event.
+    EventList blocks;
+    for (int i = 0; i < 10; ++i) {
+      std::vector<TofEvent> block{TofEvent(100. + 0.6 * i, 0)};
+      blocks.compressAndAddEvents(block, 1.);
+    }
+    const auto &events = blocks.getWeightedEventsNoTime();
+    TS_ASSERT_EQUALS(events.size(), 5);
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_DELTA(events[i].tof(), 100. + 1.2 * static_cast<double>(i),
+                      1e-9);
+      TS_ASSERT_EQUALS(events[i].weight(), 2.);
+    }
+  }
+
+  void test_compressFatAndAddEvents_merges_only_the_last_intervals() {
+    // Blocks of events in increasing pulse times, as loaded from a file
+    EventList blocks;
+    for (int i = 0; i < 10; ++i) {
+      std::vector<TofEvent> block;
+      for (int j = 0; j < 4; ++j)
+        block.emplace_back(100. + 0.6 * i, DateAndTime(int64_t(i * 1e9)));
+      blocks.compressFatAndAddEvents(block, 1., DateAndTime(0), 2.);
+    }
+    // Two blocks of equal TOF, and the same TOF in the next block, share an
+    // interval of 2 seconds: the events of the second block are combined
+    // with those of the first.
+    const auto &events = blocks.getWeightedEvents();
+    TS_ASSERT_EQUALS(events.size(), 5);
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_DELTA(events[i].tof(), 100. + 1.2 * static_cast<double>(i),
+                      1e-9);
+      TS_ASSERT_EQUALS(events[i].weight(), 8.);
+      TS_ASSERT_EQUALS(events[i].pulseTime(),
+                       DateAndTime(static_cast<int64_t>(2e9 * i)));
+    }
+  }
+
+  void test_compressFatAndAddEvents() {
+    // no pulse time should throw an exception
+    EventList el_notime = this->fake_data(WEIGHTED_NOTIME);
+    std::vector<TofEvent> more{TofEvent(1., 0)};
+    TS_ASSERT_THROWS(
+        el_notime.compressFatAndAddEvents(more, 10., DateAndTime(0), 10.),
+        const std::invalid_argument &);
+
+    this->fake_uniform_data_weights(TOF);
+    std::vector<TofEvent> first, second;
+    const auto &events = el.getEvents();
+    for (size_t i = 0; i < events.size(); ++i)
+      (i < events.size() / 2 ? first : second).emplace_back(events[i]);
+    EventList blocks;
+    TS_ASSERT_THROWS_NOTHING(
+        blocks.compressFatAndAddEvents(first, 20000., DateAndTime(0), 5.));
+    TS_ASSERT_THROWS_NOTHING(
+        blocks.compressFatAndAddEvents(second, 20000., DateAndTime(0), 5.));
+    TS_ASSERT_EQUALS(blocks.getEventType(), WEIGHTED);
+    TS_ASSERT_LESS_THAN(blocks.getNumberEvents(), el.getNumberEvents());
+    TS_ASSERT_DELTA(blocks.integrate(0., 0., true),
+                    el.integrate(0., 0., true), 1e-6);
+    // The pulse times are kept, grouped in intervals of 5 seconds
+    TS_ASSERT_LESS_THAN_EQUALS(el.getPulseTimeMin(), blocks.getPulseTimeMin());
+    TS_ASSERT_LESS_THAN(DateAndTime(static_cast<int64_t>(5e9)),
+                        blocks.getPulseTimeMax());
+  }
+
   void test_compressWeightedEvents() {
     this->fake_uniform_data_weights(WEIGHTED);
     EventList uniformOut;
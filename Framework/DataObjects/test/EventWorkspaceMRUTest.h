@@ -10,9 +10,15 @@
 #include "MantidKernel/Timer.h"
 #include <cxxtest/TestSuite.h>
 
+#include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidKernel/make_cow.h"
+
+#include <vector>
 
 using namespace Mantid::DataObjects;
+using Mantid::HistogramData::HistogramY;
+using Mantid::Kernel::make_cow;
 
 class EventWorkspaceMRUTest : public CxxTest::TestSuite {
 public:
@@ -21,4 +27,122 @@ public:
     TS_ASSERT_THROWS_NOTHING(mru.MRUSize());
     TS_ASSERT_EQUALS(mru.MRUSize(), 0);
   }
+
+  void test_find_counts_hits_and_misses() {
+    EventWorkspaceMRU mru(2);
+    EventList el;
+    TS_ASSERT(!mru.findY(0, &el));
+    mru.insertY(0, make_cow<HistogramY>(10, 1.0), &el);
+    TS_ASSERT(mru.findY(0, &el));
+    // Each thread has its own shard
+    TS_ASSERT(!mru.findY(1, &el));
+    TS_ASSERT_EQUALS(mru.hits(), 1);
+    TS_ASSERT_EQUALS(mru.misses(), 2);
+    mru.resetStatistics();
+    TS_ASSERT_EQUALS(mru.hits(), 0);
+    TS_ASSERT_EQUALS(mru.misses(), 0);
+  }
+
+  void test_number_of_entries_is_limited() {
+    EventWorkspaceMRU mru(1);
+    std::vector<EventList> lists(100);
+    for (const auto &el : lists)
+      mru.insertY(0, make_cow<HistogramY>(10, 1.0), &el);
+    TS_ASSERT_EQUALS(mru.MRUSize(),
+                     EventWorkspaceMRU::DEFAULT_ENTRIES_PER_SHARD);
+    // The oldest entries were evicted
+    TS_ASSERT(!mru.findY(0, &lists.front()));
+    TS_ASSERT(mru.findY(0, &lists.back()));
+  }
+
+  void test_memory_budget_evicts_least_recently_used() {
+    EventWorkspaceMRU mru(1);
+    std::vector<EventList> lists(3);
+    mru.insertY(0, make_cow<HistogramY>(1000, 1.0), &lists[0]);
+    const size_t entrySize = mru.memoryUsed();
+    TS_ASSERT_LESS_THAN_EQUALS(1000 * sizeof(double), entrySize);
+    mru.setMemoryBudget(2 * entrySize);
+    mru.insertY(0, make_cow<HistogramY>(1000, 1.0), &lists[1]);
+    // Use the first one so that the second is the least recently used
+    TS_ASSERT(mru.findY(0, &lists[0]));
+    mru.insertY(0, make_cow<HistogramY>(1000, 1.0), &lists[2]);
+    TS_ASSERT_EQUALS(mru.MRUSize(), 2);
+    TS_ASSERT_LESS_THAN_EQUALS(mru.memoryUsed(), 2 * entrySize);
+    TS_ASSERT(mru.findY(0, &lists[0]));
+    TS_ASSERT(!mru.findY(0, &lists[1]));
+    TS_ASSERT(mru.findY(0, &lists[2]));
+  }
+
+  void test_histogram_over_the_budget_is_kept_until_the_next_insertion() {
+    EventWorkspaceMRU mru(1);
+    std::vector<EventList> lists(2);
+    mru.setMemoryBudget(100 * sizeof(double));
+    auto y = make_cow<HistogramY>(1000, 1.0);
+    mru.insertY(0, y, &lists[0]);
+    // The caller may still hold a reference to the histogram just inserted
+    TS_ASSERT(mru.findY(0, &lists[0]));
+    mru.insertY(0, make_cow<HistogramY>(1000, 1.0), &lists[1]);
+    TS_ASSERT(!mru.findY(0, &lists[0]));
+    TS_ASSERT(mru.findY(0, &lists[1]));
+    TS_ASSERT_EQUALS(mru.MRUSize(), 1);
+  }
+
+  void test_threads_beyond_the_shards_do_not_share_them() {
+    EventWorkspaceMRU mru(2);
+    std::vector<EventList> lists(2 *
+                                 EventWorkspaceMRU::DEFAULT_ENTRIES_PER_SHARD);
+    // Thread 2 has no shard of its own yet
+    mru.insertY(2, make_cow<HistogramY>(10, 1.0), &lists[0]);
+    for (size_t i = 1; i < lists.size(); ++i)
+      mru.insertY(0, make_cow<HistogramY>(10, 1.0), &lists[i]);
+    TS_ASSERT(mru.findY(2, &lists[0]));
+    TS_ASSERT(!mru.findY(4, &lists[0]));
+    TS_ASSERT_EQUALS(mru.hits(), 1);
+    TS_ASSERT_EQUALS(mru.misses(), 1);
+    mru.deleteIndex(&lists[0]);
+    TS_ASSERT(!mru.findY(2, &lists[0]));
+  }
+
+  void test_destroyed_list_is_unpinned() {
+    EventWorkspaceMRU mru(1);
+    const EventList *address;
+    {
+      EventList el(&mru, 0);
+      address = &el;
+      mru.pin(&el);
+      TS_ASSERT(mru.isPinned(address));
+    }
+    TS_ASSERT(!mru.isPinned(address));
+  }
+
+  void test_pinned_entries_are_not_evicted() {
+    EventWorkspaceMRU mru(1);
+    std::vector<EventList> lists(100);
+    mru.pin(&lists.front());
+    TS_ASSERT(mru.isPinned(&lists.front()));
+    for (const auto &el : lists)
+      mru.insertY(0, make_cow<HistogramY>(10, 1.0), &el);
+    TS_ASSERT(mru.findY(0, &lists.front()));
+    TS_ASSERT_EQUALS(mru.MRUSize(),
+                     EventWorkspaceMRU::DEFAULT_ENTRIES_PER_SHARD + 1);
+
+    // Changing the list still invalidates the histogram
+    mru.deleteIndex(&lists.front());
+    TS_ASSERT(!mru.findY(0, &lists.front()));
+    TS_ASSERT(mru.isPinned(&lists.front()));
+
+    mru.unpin(&lists.front());
+    TS_ASSERT(!mru.isPinned(&lists.front()));
+  }
+
+  void test_clear() {
+    EventWorkspaceMRU mru(2);
+    EventList el;
+    mru.insertY(0, make_cow<HistogramY>(10, 1.0), &el);
+    mru.insertY(1, make_cow<HistogramY>(10, 1.0), &el);
+    mru.clear();
+    TS_ASSERT_EQUALS(mru.MRUSize(), 0);
+    TS_ASSERT_EQUALS(mru.memoryUsed(), 0);
+    TS_ASSERT(!mru.findY(1, &el));
+  }
 };
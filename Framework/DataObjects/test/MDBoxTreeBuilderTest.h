@@ -0,0 +1,141 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/BoxController.h"
+#include "MantidDataObjects/MDBoxTreeBuilder.h"
+#include "MantidDataObjects/MDLeanEvent.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <random>
+#include <vector>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class MDBoxTreeBuilderTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDBoxTreeBuilderTest *createSuite() {
+    return new MDBoxTreeBuilderTest();
+  }
+  static void destroySuite(MDBoxTreeBuilderTest *suite) { delete suite; }
+
+  void test_uneven_split_gives_same_boxes_as_splitAllIfNeeded() {
+    auto events = makeEvents(20000);
+    auto built = makeWorkspace();
+    auto expected = makeWorkspace();
+
+    auto eventsCopy = events;
+    MDBoxTreeBuilder<MDE, 2> builder(*built);
+    TS_ASSERT_EQUALS(builder.addEvents(eventsCopy), 0);
+    built->refreshCache();
+
+    expected->addEvents(events);
+    expected->splitAllIfNeeded(nullptr);
+    expected->refreshCache();
+
+    TS_ASSERT_EQUALS(built->getNPoints(), events.size());
+    TS_ASSERT_EQUALS(built->getBoxController()->getNumMDBoxes(),
+                     expected->getBoxController()->getNumMDBoxes());
+    checkEventsAreInTheirBoxes(*built);
+  }
+
+  void test_events_outside_are_dropped_and_upper_edge_is_kept() {
+    auto ws = makeWorkspace();
+    std::vector<MDE> events;
+    events.emplace_back(1.f, 1.f, std::vector<coord_t>{-1.f, 5.f}.data());
+    events.emplace_back(1.f, 1.f, std::vector<coord_t>{5.f, 11.f}.data());
+    events.emplace_back(
+        1.f, 1.f, std::vector<coord_t>{std::nanf(""), 5.f}.data());
+    events.emplace_back(1.f, 1.f, std::vector<coord_t>{10.f, 10.f}.data());
+    events.emplace_back(1.f, 1.f, std::vector<coord_t>{0.f, 0.f}.data());
+
+    MDBoxTreeBuilder<MDE, 2> builder(*ws);
+    TS_ASSERT_EQUALS(builder.addEvents(events), 3);
+    ws->refreshCache();
+    TS_ASSERT_EQUALS(ws->getNPoints(), 2);
+  }
+
+  void test_adding_to_existing_tree_splits_boxes_further() {
+    auto ws = makeWorkspace();
+    auto first = makeEvents(500);
+    MDBoxTreeBuilder<MDE, 2>(*ws).addEvents(first);
+    ws->refreshCache();
+    const auto boxesBefore = ws->getBoxController()->getTotalNumMDBoxes();
+
+    auto second = makeEvents(20000);
+    MDBoxTreeBuilder<MDE, 2>(*ws).addEvents(second);
+    ws->refreshCache();
+
+    TS_ASSERT_EQUALS(ws->getNPoints(), 20500);
+    TS_ASSERT_LESS_THAN(boxesBefore,
+                        ws->getBoxController()->getTotalNumMDBoxes());
+    checkEventsAreInTheirBoxes(*ws);
+  }
+
+  void test_top_level_splitting() {
+    auto ws = makeWorkspace();
+    ws->getBoxController()->setSplitTopInto(0, 7);
+    ws->getBoxController()->setSplitTopInto(1, 2);
+    auto events = makeEvents(20000);
+    MDBoxTreeBuilder<MDE, 2>(*ws).addEvents(events);
+    ws->refreshCache();
+
+    TS_ASSERT_EQUALS(ws->getNPoints(), 20000);
+    TS_ASSERT_EQUALS(ws->getBox()->getNumChildren(), 14);
+    checkEventsAreInTheirBoxes(*ws);
+  }
+
+private:
+  using MDE = MDLeanEvent<2>;
+  using WorkspaceType = MDEventWorkspace<MDE, 2>;
+
+  /// Workspace from 0 to 10 split into 3 by 5 boxes of up to 100 events
+  std::shared_ptr<WorkspaceType> makeWorkspace() {
+    auto ws = MDEventsTestHelper::makeMDEW<2>(2, 0.0, 10.0);
+    ws->getBoxController()->setSplitInto(0, 3);
+    ws->getBoxController()->setSplitInto(1, 5);
+    return ws;
+  }
+
+  std::vector<MDE> makeEvents(const size_t numEvents) {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<coord_t> position(0.f, 10.f);
+    std::vector<MDE> events;
+    events.reserve(numEvents);
+    for (size_t i = 0; i < numEvents; ++i) {
+      const coord_t centers[2] = {position(generator), position(generator)};
+      events.emplace_back(1.f, 1.f, centers);
+    }
+    return events;
+  }
+
+  void checkEventsAreInTheirBoxes(WorkspaceType &ws) {
+    std::vector<IMDNode *> boxes;
+    ws.getBox()->getBoxes(boxes, 1000, true);
+    for (auto node : boxes) {
+      auto box = dynamic_cast<MDBox<MDE, 2> *>(node);
+      TS_ASSERT(box);
+      TS_ASSERT(!ws.getBoxController()->willSplit(box->getNPoints(),
+                                                  box->getDepth()));
+      for (const auto &event : box->getConstEvents()) {
+        for (size_t d = 0; d < 2; ++d) {
+          TS_ASSERT_LESS_THAN_EQUALS(box->getExtents(d).getMin(),
+                                     event.getCenter(d));
+          TS_ASSERT_LESS_THAN_EQUALS(event.getCenter(d),
+                                     box->getExtents(d).getMax());
+        }
+      }
+      box->releaseEvents();
+    }
+  }
+};
@@ -30,6 +30,7 @@
 #include <gmock/gmock.h>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <nexus/NeXusFile.hpp>
 #include <random>
 #include <vector>
@@ -224,6 +225,31 @@ public:
     delete g;
   }
 
+  //-------------------------------------------------------------------------------------
+  void test_MDGridBox_constructor_from_MDBox_sizes_children_exactly() {
+    MDBox<MDLeanEvent<1>, 1> *b = MDEventsTestHelper::makeMDBox1(10);
+    // 1 event in the first box, 3 in the last (one on its upper edge)
+    std::vector<MDLeanEvent<1>> events;
+    for (const coord_t x : {0.5f, 9.25f, 9.75f, 10.0f})
+      events.emplace_back(1.0f, 1.0f, &x);
+    b->addEvents(events);
+
+    MDGridBox<MDLeanEvent<1>, 1> *g = new MDGridBox<MDLeanEvent<1>, 1>(b);
+    std::vector<MDBoxBase<MDLeanEvent<1>, 1> *> boxes = g->getBoxes();
+    TS_ASSERT_EQUALS(boxes.size(), 10);
+    for (size_t i = 0; i < boxes.size(); i++) {
+      auto *box = dynamic_cast<MDBox<MDLeanEvent<1>, 1> *>(boxes[i]);
+      const size_t expected = i == 0 ? 1 : i == 9 ? 3 : 0;
+      TS_ASSERT_EQUALS(box->getConstEvents().size(), expected);
+      TS_ASSERT_EQUALS(box->getConstEvents().capacity(), expected);
+    }
+
+    BoxController *const bcc = b->getBoxController();
+    delete b;
+    delete bcc;
+    delete g;
+  }
+
   //-------------------------------------------------------------------------------------
   void test_MDGridBox_copy_constructor() {
     MDBox<MDLeanEvent<1>, 1> *b = MDEventsTestHelper::makeMDBox1(10);
@@ -1196,6 +1222,63 @@ public:
     delete b;
   }
 
+  //------------------------------------------------------------------------------------------------
+  void test_integrateSpheres_matches_integrateSphere() {
+    // Uneven 4x3x4 split, with random events split further below
+    MDGridBox<MDLeanEvent<3>, 3> *box_ptr =
+        MDEventsTestHelper::makeMDGridBox<3>(4, 3);
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> position(0.f, 10.f);
+    std::uniform_real_distribution<float> weight(0.5f, 2.f);
+    for (size_t i = 0; i < 5000; ++i) {
+      coord_t center[3] = {position(gen), position(gen), position(gen)};
+      const float signal = weight(gen);
+      box_ptr->addEvent(MDLeanEvent<3>(signal, signal, center));
+    }
+    box_ptr->splitAllIfNeeded(nullptr);
+    box_ptr->refreshCache();
+
+    // Spheres and shells, some of them partly or fully outside of the box
+    const size_t numSpheres = 40;
+    std::uniform_real_distribution<float> centerPosition(-2.f, 12.f);
+    std::uniform_real_distribution<float> radius(0.2f, 3.f);
+    bool dimensionsUsed[3] = {true, true, true};
+    std::vector<coord_t> centers(3 * numSpheres);
+    std::vector<std::unique_ptr<CoordTransformDistance>> transforms;
+    std::vector<MDIntegrationSphere> spheres;
+    for (size_t i = 0; i < numSpheres; ++i) {
+      for (size_t d = 0; d < 3; ++d)
+        centers[3 * i + d] = centerPosition(gen);
+      transforms.emplace_back(std::make_unique<CoordTransformDistance>(
+          3, &centers[3 * i], dimensionsUsed));
+      const coord_t outer = radius(gen);
+      const coord_t inner = i % 2 == 0 ? 0.f : outer / 2;
+      spheres.emplace_back(MDIntegrationSphere{
+          transforms.back().get(), &centers[3 * i], outer * outer,
+          inner * inner});
+    }
+    std::vector<size_t> indices(numSpheres);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::vector<signal_t> signal(numSpheres, 0);
+    std::vector<signal_t> errorSquared(numSpheres, 0);
+    box_ptr->integrateSpheres(spheres, indices, signal.data(),
+                              errorSquared.data(), true, true);
+
+    for (size_t i = 0; i < numSpheres; ++i) {
+      signal_t expectedSignal = 0;
+      signal_t expectedErrorSquared = 0;
+      box_ptr->integrateSphere(*spheres[i].radiusTransform,
+                               spheres[i].radiusSquared, expectedSignal,
+                               expectedErrorSquared,
+                               spheres[i].innerRadiusSquared, true);
+      TS_ASSERT_DELTA(signal[i], expectedSignal, 1e-6 * expectedSignal);
+      TS_ASSERT_DELTA(errorSquared[i], expectedErrorSquared,
+                      1e-6 * expectedErrorSquared);
+    }
+    delete box_ptr->getBoxController();
+    delete box_ptr;
+  }
+
   //------------------------------------------------------------------------------------------------
   /** For test_integrateSphere
    *
@@ -0,0 +1,113 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoExpressionTest *createSuite() {
+    return new MDHistoExpressionTest();
+  }
+  static void destroySuite(MDHistoExpressionTest *suite) { delete suite; }
+
+  void test_binary_operations_match_the_workspace_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(-0.5);
+    const MDHistoExpression ea(a), eb(b);
+
+    auto expected = a->clone();
+    expected->add(*b);
+    expected->multiply(*a);
+    expected->subtract(2.0, 0.5);
+    expected->divide(*b);
+
+    auto out = ((ea + eb) * ea - MDHistoExpression(2.0, 0.5)) / eb;
+    assertSame(*out.evaluate(), *expected);
+  }
+
+  void test_unary_operations_match_the_workspace_operations() {
+    auto a = makeWorkspace(-2.0);
+
+    auto expected = a->clone();
+    expected->log(7.0);
+    expected->exp();
+    expected->power(1.5);
+    expected->log10(-1.0);
+
+    const MDHistoExpression ea(a);
+    auto out = ea.log(7.0).exp().power(1.5).log10(-1.0);
+    assertSame(*out.evaluate(), *expected);
+  }
+
+  void test_scalar_on_the_lhs() {
+    auto a = makeWorkspace(1.0);
+    const MDHistoExpression ea(a);
+    auto out = (MDHistoExpression(3.0, 1.0) - ea).evaluate();
+    auto product = (MDHistoExpression(3.0) * ea).evaluate();
+    for (size_t i = 0; i < a->getNPoints(); ++i) {
+      TS_ASSERT_DELTA(out->getSignalAt(i), 3.0 - a->getSignalAt(i), 1e-12);
+      TS_ASSERT_DELTA(out->getErrorAt(i) * out->getErrorAt(i),
+                      1.0 + a->getErrorAt(i) * a->getErrorAt(i), 1e-12);
+      TS_ASSERT_EQUALS(out->getNumEventsAt(i), a->getNumEventsAt(i));
+      TS_ASSERT_DELTA(product->getSignalAt(i), 3.0 * a->getSignalAt(i), 1e-12);
+      TS_ASSERT_EQUALS(product->getNumEventsAt(i), a->getNumEventsAt(i));
+    }
+  }
+
+  void test_operands_are_not_modified() {
+    auto a = makeWorkspace(1.0);
+    auto copy = a->clone();
+    const MDHistoExpression ea(a);
+    (ea * ea + ea).log().evaluate();
+    assertSame(*a, *copy);
+  }
+
+  void test_workspaces_of_different_sizes_throw() {
+    auto a = makeWorkspace(1.0);
+    auto b = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 10);
+    TS_ASSERT_THROWS(MDHistoExpression(a) + MDHistoExpression(b),
+                     const std::invalid_argument &);
+  }
+
+  void test_expression_without_workspace_throws() {
+    auto out = MDHistoExpression(1.0) + MDHistoExpression(2.0);
+    TS_ASSERT_THROWS(out.evaluate(), const std::runtime_error &);
+  }
+
+private:
+  /// 2D workspace of 2500 bins (more than two blocks) with varying values
+  MDHistoWorkspace_sptr makeWorkspace(const double offset) {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 50);
+    for (size_t i = 0; i < ws->getNPoints(); ++i) {
+      const auto x = static_cast<double>(i);
+      ws->setSignalAt(i, offset + 0.01 * x);
+      ws->setErrorSquaredAt(i, 0.1 + 0.001 * x);
+      ws->setNumEventsAt(i, static_cast<signal_t>(i % 7));
+    }
+    return ws;
+  }
+
+  void assertSame(const MDHistoWorkspace &out,
+                  const MDHistoWorkspace &expected) {
+    TS_ASSERT_EQUALS(out.getNPoints(), expected.getNPoints());
+    for (size_t i = 0; i < out.getNPoints(); ++i) {
+      TS_ASSERT_DELTA(out.getSignalAt(i), expected.getSignalAt(i), 1e-10);
+      TS_ASSERT_DELTA(out.getErrorAt(i), expected.getErrorAt(i), 1e-10);
+      TS_ASSERT_EQUALS(out.getNumEventsAt(i), expected.getNumEventsAt(i));
+    }
+  }
+};
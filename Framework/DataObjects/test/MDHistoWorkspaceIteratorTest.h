@@ -345,6 +345,29 @@ public:
         histoIt->getLinearIndex());
   }
 
+  void test_skip_empty_tiles_of_sparse_workspace() {
+    // 40000 bins, in ten tiles
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 200);
+    ws->setTo(0.0, 0.0, 0.0);
+    ws->setSparse(true);
+    ws->setSignalAt(5000, 1.0);
+    ws->setSignalAt(17000, 2.0);
+
+    MDHistoWorkspaceIterator it(ws.get(), new SkipEmptyTiles());
+    // Only the bins of the second and the fifth tiles are visited
+    size_t count = 0;
+    double total = 0;
+    do {
+      const size_t index = it.getLinearIndex();
+      TS_ASSERT((index >= 4096 && index < 8192) ||
+                (index >= 16384 && index < 20480));
+      total += it.getSignal();
+      ++count;
+    } while (it.next());
+    TS_ASSERT_EQUALS(count, 2 * 4096);
+    TS_ASSERT_EQUALS(total, 3.0);
+  }
+
   // template<typename ContainerType, typename ElementType>
   template <class ContainerType>
   bool doesContainIndex(const ContainerType &container,
@@ -1237,6 +1237,110 @@ public:
     TS_ASSERT_EQUALS(targetDisplayNormalization, clone->displayNormalization());
   }
 
+  void test_sparse_storage_keeps_the_values() {
+    // 10000 bins, in three tiles
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 100);
+    ws->setTo(0.0, 0.0, 0.0);
+    ws->setSignalAt(10, 2.5);
+    ws->setErrorSquaredAt(10, 1.5);
+    ws->setNumEventsAt(10, 3.0);
+    ws->setMDMaskAt(20, true);
+    const size_t denseMemory = ws->getMemorySize();
+
+    ws->setSparse(true);
+    TS_ASSERT(ws->isSparse());
+    TS_ASSERT_LESS_THAN(ws->getMemorySize(), denseMemory / 2);
+    TS_ASSERT_EQUALS(ws->getSignalAt(10), 2.5);
+    TS_ASSERT_EQUALS(ws->getErrorAt(10), std::sqrt(1.5));
+    TS_ASSERT_EQUALS(ws->getNumEventsAt(10), 3.0);
+    TS_ASSERT(ws->getIsMaskedAt(20));
+    TS_ASSERT_EQUALS(ws->getSignalAt(9999), 0.0);
+    TS_ASSERT_EQUALS(ws->sumNContribEvents(), 3);
+
+    // Writes to an empty tile allocate it
+    ws->setSignalAt(9999, 4.0);
+    ws->signalAt(9998) += 1.0;
+    TS_ASSERT_EQUALS(ws->getSignalAt(9999), 4.0);
+    TS_ASSERT_EQUALS(ws->getSignalAt(9998), 1.0);
+    TS_ASSERT_EQUALS(ws->skipEmptyTiles(0), 0);
+    TS_ASSERT_EQUALS(ws->skipEmptyTiles(5000), 8192);
+
+    auto copy = ws->clone();
+    TS_ASSERT(copy->isSparse());
+    TS_ASSERT_EQUALS(copy->getSignalAt(9999), 4.0);
+
+    // The direct pointers switch back to the dense arrays
+    const signal_t *signals = ws->getSignalArray();
+    TS_ASSERT(!ws->isSparse());
+    TS_ASSERT_EQUALS(signals[10], 2.5);
+    TS_ASSERT_EQUALS(signals[9999], 4.0);
+    TS_ASSERT(ws->getIsMaskedAt(20));
+    // and free the tiles
+    TS_ASSERT_EQUALS(ws->getMemorySize(), denseMemory);
+  }
+
+  void test_sparse_storage_with_nan_bins() {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 100);
+    const signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    ws->setTo(nan, nan, 0.0);
+    ws->setSignalAt(5, 1.0);
+    ws->setErrorSquaredAt(6, 0.0);
+    ws->setSparse(true);
+    TS_ASSERT_EQUALS(ws->getSignalAt(5), 1.0);
+    TS_ASSERT(std::isnan(ws->getSignalAt(9000)));
+    TS_ASSERT(std::isnan(ws->getErrorAt(9000)));
+    TS_ASSERT_EQUALS(ws->getNumEventsAt(9000), 0.0);
+    TS_ASSERT_EQUALS(ws->sumNContribEvents(), 0);
+    TS_ASSERT_EQUALS(ws->skipEmptyTiles(100), 100);
+    TS_ASSERT_EQUALS(ws->skipEmptyTiles(4096), ws->getNPoints());
+  }
+
+  void test_sparse_nan_bins_have_no_events() {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 100);
+    const signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    ws->setTo(nan, nan, nan);
+    ws->setSparse(true);
+    // The NaN numbers of events are stored, never converted to a count
+    TS_ASSERT(std::isnan(ws->getNumEventsAt(9000)));
+    TS_ASSERT_EQUALS(ws->sumNContribEvents(), 0);
+  }
+
+  void test_sparse_construction_allocates_no_bins() {
+    Mantid::Geometry::GeneralFrame frame("m", "m");
+    std::vector<MDHistoDimension_sptr> dimensions{
+        std::make_shared<MDHistoDimension>("x", "x", frame, -10.0f, 10.0f,
+                                           100),
+        std::make_shared<MDHistoDimension>("y", "y", frame, -10.0f, 10.0f,
+                                           100)};
+    MDHistoWorkspace ws(dimensions, Mantid::API::NoNormalization, true);
+    TS_ASSERT(ws.isSparse());
+    TS_ASSERT_EQUALS(ws.getMemorySize(), 0);
+    TS_ASSERT(std::isnan(ws.getSignalAt(5000)));
+    TS_ASSERT_EQUALS(ws.getNumEventsAt(5000), 0.0);
+    TS_ASSERT_EQUALS(ws.skipEmptyTiles(0), ws.getNPoints());
+
+    ws.setTo(0.0, 0.0, 0.0);
+    ws.signalAt(5000) += 2.0;
+    ws.setNumEventsAt(5000, 1.0);
+    TS_ASSERT(ws.isSparse());
+    TS_ASSERT_EQUALS(ws.getSignalAt(5000), 2.0);
+    TS_ASSERT_EQUALS(ws.sumNContribEvents(), 1);
+    TS_ASSERT_EQUALS(ws.skipEmptyTiles(0), 4096);
+  }
+
+  void test_sparse_arithmetic() {
+    auto a = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 100);
+    auto b = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 100);
+    a->setSparse(true);
+    a->setSignalAt(7, 2.0);
+    b->setSparse(true);
+    a->add(*b);
+    TS_ASSERT(!a->isSparse());
+    TS_ASSERT(!b->isSparse());
+    TS_ASSERT_EQUALS(a->getSignalAt(7), 3.0);
+    TS_ASSERT_EQUALS(a->getSignalAt(8), 1.0);
+  }
+
   void test_is_histogram_is_true() {
     MDHistoWorkspace_sptr hw =
         MDEventsTestHelper::makeFakeMDHistoWorkspace(1.23, 2, 5, 10.0, 3.0);
@@ -23,4 +23,11 @@ public:
     SkippingPolicy &p = skipNothing;
     TSM_ASSERT_EQUALS("Should alway return False", false, p.keepGoing());
   }
+
+  void test_SkipEmptyTiles() {
+    SkipEmptyTiles skipEmptyTiles;
+    SkippingPolicy &p = skipEmptyTiles;
+    TSM_ASSERT_EQUALS("Should alway return False", false, p.keepGoing());
+    TSM_ASSERT("Should skip the empty tiles", p.skipEmptyTiles());
+  }
 };
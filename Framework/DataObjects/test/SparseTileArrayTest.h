@@ -0,0 +1,104 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/SparseTileArray.h"
+
+#include <cmath>
+#include <cxxtest/TestSuite.h>
+#include <limits>
+#include <vector>
+
+using Mantid::DataObjects::SparseTileArray;
+
+class SparseTileArrayTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SparseTileArrayTest *createSuite() {
+    return new SparseTileArrayTest();
+  }
+  static void destroySuite(SparseTileArrayTest *suite) { delete suite; }
+
+  void test_assign_allocates_no_tiles() {
+    SparseTileArray<double> array;
+    array.assign(3 * TILE + 5, 2.0);
+    TS_ASSERT_EQUALS(array.size(), 3 * TILE + 5);
+    TS_ASSERT_EQUALS(array.numTiles(), 4);
+    TS_ASSERT_EQUALS(array.numStoredTiles(), 0);
+    TS_ASSERT_EQUALS(array.get(0), 2.0);
+    TS_ASSERT_EQUALS(array.get(3 * TILE + 4), 2.0);
+  }
+
+  void test_set_allocates_only_the_tile_written_to() {
+    SparseTileArray<double> array;
+    array.assign(3 * TILE, 0.0);
+    array.set(TILE + 7, 5.0);
+    TS_ASSERT_EQUALS(array.numStoredTiles(), 1);
+    TS_ASSERT(!array.isStored(0));
+    TS_ASSERT(array.isStored(TILE));
+    TS_ASSERT(array.tile(1));
+    TS_ASSERT(!array.tile(2));
+    TS_ASSERT_EQUALS(array.get(TILE + 7), 5.0);
+    TS_ASSERT_EQUALS(array.get(TILE + 8), 0.0);
+  }
+
+  void test_setting_the_fill_value_allocates_nothing() {
+    SparseTileArray<double> array;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    array.assign(TILE, nan);
+    array.set(3, nan);
+    TS_ASSERT_EQUALS(array.numStoredTiles(), 0);
+    TS_ASSERT(std::isnan(array.get(3)));
+  }
+
+  void test_at_allocates_the_tile() {
+    SparseTileArray<bool> array;
+    array.assign(2 * TILE, false);
+    TS_ASSERT(!array.at(TILE));
+    TS_ASSERT_EQUALS(array.numStoredTiles(), 1);
+    array.at(TILE + 1) = true;
+    TS_ASSERT(array.get(TILE + 1));
+  }
+
+  void test_dense_round_trip() {
+    std::vector<double> values(2 * TILE + 10, 0.0);
+    values[5] = 1.0;
+    values[2 * TILE + 9] = 3.0;
+    SparseTileArray<double> array;
+    array.assign(values.data(), values.size(), 0.0);
+    TS_ASSERT_EQUALS(array.numStoredTiles(), 2);
+    TS_ASSERT(!array.isStored(TILE));
+
+    std::vector<double> out(values.size(), -1.0);
+    array.copyTo(out.data());
+    TS_ASSERT_EQUALS(out, values);
+  }
+
+  void test_copy_is_deep() {
+    SparseTileArray<double> array;
+    array.assign(TILE, 0.0);
+    array.set(1, 4.0);
+    SparseTileArray<double> copy(array);
+    copy.set(1, 6.0);
+    TS_ASSERT_EQUALS(array.get(1), 4.0);
+    TS_ASSERT_EQUALS(copy.get(1), 6.0);
+    TS_ASSERT_EQUALS(copy.numStoredTiles(), 1);
+  }
+
+  void test_getMemorySize_counts_the_stored_tiles() {
+    SparseTileArray<double> array;
+    array.assign(10 * TILE, 0.0);
+    const size_t empty = array.getMemorySize();
+    TS_ASSERT_LESS_THAN(empty, TILE * sizeof(double));
+    array.set(0, 1.0);
+    TS_ASSERT_EQUALS(array.getMemorySize(), empty + TILE * sizeof(double));
+  }
+
+private:
+  static constexpr size_t TILE = SparseTileArray<double>::TILE_SIZE;
+};
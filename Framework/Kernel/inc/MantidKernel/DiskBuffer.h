@@ -15,11 +15,18 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 #endif
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <limits>
 #include <list>
+#include <map>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Mantid {
@@ -37,6 +44,13 @@ class ISaveable;
   It also stores a list of "free" blocks in the output file,
   to allow new blocks to fill them later.
 
+  Objects that are about to be used can be loaded ahead on a background
+  thread with prefetch(). The prefetched objects that have not been used yet
+  are kept within the size of the to-write buffer; those that are passed over
+  by their user are unloaded again. The loads served from prefetching, the
+  loads that had to read the file and the time spent waiting for them are
+  counted.
+
   @date 2011-12-30
 */
 class DLLExport DiskBuffer {
@@ -61,12 +75,26 @@ public:
   DiskBuffer(uint64_t m_writeBufferSize);
   DiskBuffer(const DiskBuffer &) = delete;
   DiskBuffer &operator=(const DiskBuffer &) = delete;
-  virtual ~DiskBuffer() = default;
+  virtual ~DiskBuffer();
 
   void toWrite(ISaveable *item);
   void flushCache();
   void objectDeleted(ISaveable *item);
 
+  // Prefetching
+  void prefetch(const std::vector<ISaveable *> &items);
+  void cancelPrefetch();
+  void prefetchUsed(ISaveable *item);
+  void recordLoad(const bool prefetched, const double waitTime);
+  /// @return the number of loads served by data prefetched in the background
+  uint64_t getPrefetchHits() const { return m_prefetchHits; }
+  /// @return the number of loads that read the file while the caller waited
+  uint64_t getPrefetchMisses() const { return m_prefetchMisses; }
+  /// @return the time, in seconds, callers have waited for data to be loaded
+  double getLoadWaitTime() const {
+    return static_cast<double>(m_loadWaitNanoseconds) * 1e-9;
+  }
+
   // Free space map methods
   void freeBlock(uint64_t const pos, uint64_t const size);
   void defragFreeBlocks();
@@ -117,6 +145,10 @@ public:
 
 protected:
   inline void writeOldObjects();
+  void prefetchLoop();
+  bool hasPassedPrefetched() const;
+  void forgetPrefetched(ISaveable *item);
+  void updatePrefetchInUse();
 
   // ----------------------- To-write buffer
   // --------------------------------------
@@ -151,6 +183,41 @@ protected:
   /// Length of the file. This is where new blocks that don't fit get placed.
   mutable uint64_t m_fileLength;
 
+  // ----------------------- Prefetching --------------------------------------
+  /// Objects to load ahead with their sequence numbers, in the order of use
+  std::deque<std::pair<ISaveable *, size_t>> m_prefetchQueue;
+  /// Sequence numbers of the queued objects that are still to be loaded
+  std::unordered_map<ISaveable *, size_t> m_prefetchQueued;
+  /// Prefetched objects that have not been used yet, with their memory size,
+  /// by sequence number
+  std::map<size_t, std::pair<ISaveable *, size_t>> m_prefetched;
+  /// Sequence numbers of the objects in m_prefetched
+  std::unordered_map<ISaveable *, size_t> m_prefetchedSeq;
+  /// Total memory of the objects in m_prefetched
+  size_t m_prefetchedMemory;
+  /// Sequence number given to the next object queued
+  size_t m_prefetchNextSeq;
+  /// Objects with a lower sequence number have been passed by their user
+  size_t m_prefetchUsedSeq;
+  /// Object being loaded or unloaded by the prefetch thread, if any
+  ISaveable *m_prefetchCurrent;
+  /// True while the prefetch thread is running
+  bool m_prefetchRunning;
+  /// True if any of the prefetch containers may refer to an object
+  std::atomic<bool> m_prefetchInUse;
+  /// Background thread loading the objects of m_prefetchQueue
+  std::thread m_prefetchThread;
+  /// Mutex for the prefetch queue and containers
+  std::mutex m_prefetchMutex;
+  /// Signalled when an object has been prefetched, used or forgotten
+  std::condition_variable m_prefetchCondition;
+  /// Number of loads served by prefetched data
+  std::atomic<uint64_t> m_prefetchHits;
+  /// Number of loads that read the file in the calling thread
+  std::atomic<uint64_t> m_prefetchMisses;
+  /// Time callers have waited for loads, in nanoseconds
+  std::atomic<uint64_t> m_loadWaitNanoseconds;
+
 private:
 };
 
@@ -98,6 +98,16 @@ public:
   /// Load the data - to be overriden
   virtual void load() = 0;
 
+  /** Load the data ahead of its use, from the prefetch thread of the
+   * DiskBuffer. Objects that can be loaded concurrently with their use
+   * override this; by default nothing is prefetched.
+   * @return the memory size of the data loaded, 0 if nothing was loaded */
+  virtual size_t loadAhead() { return 0; }
+  /** Remove the data loaded by loadAhead() from memory, unless it has been
+   * used or changed since. Called from the prefetch thread of the DiskBuffer
+   * when the user of the object has passed it over. */
+  virtual void unloadAhead() {}
+
   /// Method to flush the data to disk and ensure it is written.
   virtual void flushData() const = 0;
   /// remove objects data from memory
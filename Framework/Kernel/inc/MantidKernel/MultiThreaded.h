@@ -7,6 +7,7 @@
 #pragma once
 
 #include <atomic>
+#include <exception>
 #include <mutex>
 
 namespace Mantid {
@@ -126,6 +127,31 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
   }                                                                            \
   interruption_point();
 
+/** Begins a block of a parallel loop that is not run by an algorithm, so has
+ * no interruption flags to set. The end of the block must be marked with
+ * PARALLEL_END_EXCEPTION_REGION(error).
+ */
+#define PARALLEL_START_EXCEPTION_REGION try {
+
+/** Ends a block started with PARALLEL_START_EXCEPTION_REGION, keeping the
+ * first exception thrown in the std::exception_ptr "error" instead of letting
+ * it escape the parallel region.
+ */
+#define PARALLEL_END_EXCEPTION_REGION(error)                                   \
+  } /* End of try block in PARALLEL_START_EXCEPTION_REGION */                  \
+  catch (...) {                                                                \
+    PARALLEL_CRITICAL(parallel_exception_region)                               \
+    if (!error)                                                                \
+      error = std::current_exception();                                        \
+  }
+
+/** Adds a check after a parallel region to rethrow the exception kept by
+ * PARALLEL_END_EXCEPTION_REGION(error)
+ */
+#define PARALLEL_CHECK_EXCEPTION_REGION(error)                                 \
+  if (error)                                                                   \
+    std::rethrow_exception(error);
+
 // _OPENMP is automatically defined if openMP support is enabled in the
 // compiler.
 #ifdef _OPENMP
@@ -142,6 +168,13 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
   PARALLEL_SET_CONFIG_THREADS                                                  \
   PRAGMA(omp parallel for if (condition) )
 
+/** As PARALLEL_FOR_IF, but threads take "chunk" iterations at a time as they
+ *   become free, for loops whose iterations vary widely in cost.
+ */
+#define PARALLEL_FOR_IF_DYNAMIC(condition, chunk)                              \
+  PARALLEL_SET_CONFIG_THREADS                                                  \
+  PRAGMA(omp parallel for schedule(dynamic, chunk) if (condition) )
+
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *   This includes no checks to see if workspaces are suitable
  *   and therefore should not be used in any loops that access workspaces.
@@ -150,6 +183,13 @@ void AtomicOp(std::atomic<T> &f, T d, BinaryOp op) {
   PARALLEL_SET_CONFIG_THREADS                                                  \
   PRAGMA(omp parallel for)
 
+/** As PARALLEL_FOR_NO_WSP_CHECK, but threads take "chunk" iterations at a time
+ *   as they become free, for loops whose iterations vary widely in cost.
+ */
+#define PARALLEL_FOR_NO_WSP_CHECK_DYNAMIC(chunk)                               \
+  PARALLEL_SET_CONFIG_THREADS                                                  \
+  PRAGMA(omp parallel for schedule(dynamic, chunk) )
+
 /** Includes code to add OpenMP commands to run the next for loop in parallel.
  *  and declare the variables to be firstprivate.
  *  This includes no checks to see if workspaces are suitable
@@ -222,7 +262,9 @@ inline void setMaxCoresToConfig() {
 
 /// Empty definitions - to enable set your complier to enable openMP
 #define PARALLEL_FOR_IF(condition)
+#define PARALLEL_FOR_IF_DYNAMIC(condition, chunk)
 #define PARALLEL_FOR_NO_WSP_CHECK()
+#define PARALLEL_FOR_NO_WSP_CHECK_DYNAMIC(chunk)
 #define PARALLEL_FOR_NOWS_CHECK_FIRSTPRIVATE(variable)
 #define PARALLEL_FOR_NO_WSP_CHECK_FIRSTPRIVATE2(variable1, variable2)
 #define IF_PARALLEL if (false)
@@ -238,4 +280,6 @@ inline void setMaxCoresToConfig() {
 #define PARALLEL_SECTIONS
 #define PARALLEL_SECTION
 #define PRAGMA_OMP(expression)
+
+inline void setMaxCoresToConfig() {}
 #endif //_OPENMP
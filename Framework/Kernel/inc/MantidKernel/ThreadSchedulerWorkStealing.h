@@ -0,0 +1,80 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/ThreadScheduler.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+
+/** ThreadSchedulerWorkStealing : a scheduler with one queue of tasks per
+ * thread, so that threads pushing and popping many small tasks do not all
+ * wait on a single queue lock.
+ *
+ * - A task pushed from inside a task running in the pool goes to the back of
+ *   the queue of the thread running it, and each thread pops from the back of
+ *   its own queue first, so freshly created (and cache-warm) work is run by
+ *   the thread that created it.
+ * - A task pushed from outside the pool goes to the queue holding the least
+ *   queued cost, so the costs given by Task::cost() spread the work evenly.
+ * - A thread with an empty queue steals from the front of the queue holding
+ *   the largest queued cost.
+ *
+ * Like ThreadSchedulerMutexes, a task whose mutex is held by a running task
+ * is skipped while other tasks are available.
+ */
+class MANTID_KERNEL_DLL ThreadSchedulerWorkStealing : public ThreadScheduler {
+public:
+  explicit ThreadSchedulerWorkStealing(size_t numQueues = 0);
+  ~ThreadSchedulerWorkStealing() override;
+
+  void push(std::shared_ptr<Task> newTask) override;
+  std::shared_ptr<Task> pop(size_t threadnum) override;
+  void finished(Task *task, size_t threadnum) override;
+
+  size_t size() override;
+  bool empty() override;
+  void clear() override;
+  double totalCost() override;
+
+  /// @return the number of queues, one per thread
+  size_t numberOfQueues() const { return m_queues.size(); }
+  /// @return how many tasks were popped from another thread's queue
+  size_t numberOfSteals() const { return m_steals; }
+
+private:
+  struct Queue;
+  struct BusyShard;
+
+  std::shared_ptr<Task> popFrom(Queue &queue, bool fromBack);
+  bool tryAcquire(const std::shared_ptr<std::mutex> &mutex);
+  BusyShard &busyShard(const std::shared_ptr<std::mutex> &mutex);
+  size_t leastLoadedQueue() const;
+
+  /// Identifies the threads running tasks of this scheduler
+  const size_t m_id;
+  /// One queue of tasks per thread
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  /// Number of tasks in all the queues
+  std::atomic<size_t> m_size{0};
+  /// Number of tasks taken from another thread's queue
+  std::atomic<size_t> m_steals{0};
+
+  /// Mutexes of the tasks currently running, split by address so that tasks
+  /// with different mutexes rarely wait on the same lock
+  std::unique_ptr<BusyShard[]> m_busy;
+};
+
+} // namespace Kernel
+} // namespace Mantid
@@ -14,6 +14,9 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+
+#include <boost/optional.hpp>
+
 #include <cstdint>
 #include <utility>
 
@@ -335,6 +338,8 @@ private:
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
   /// Time weighted mean and standard deviation
   std::pair<double, double> timeAverageValueAndStdDev() const;
+  /// Drop cached results that depend on the values or the filter
+  void invalidateCachedStatistics() const;
 
   /// Holds the time series data
   mutable std::vector<TimeValueUnit<TYPE>> m_values;
@@ -352,6 +357,10 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+  /// Result of getStatistics(), until the values or the filter change
+  mutable boost::optional<TimeSeriesPropertyStatistics> m_statisticsCache;
+  /// Result of timeAverageValue(), until the values or the filter change
+  mutable boost::optional<double> m_timeAverageCache;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidKernel/DiskBuffer.h"
 #include "MantidKernel/ISaveable.h"
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -19,7 +20,11 @@ namespace Kernel {
  */
 DiskBuffer::DiskBuffer()
     : m_writeBufferSize(50), m_writeBufferUsed(0), m_nObjectsToWrite(0),
-      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0) {
+      m_free(), m_free_bySize(m_free.get<1>()), m_fileLength(0),
+      m_prefetchedMemory(0), m_prefetchNextSeq(0), m_prefetchUsedSeq(0),
+      m_prefetchCurrent(nullptr), m_prefetchRunning(false),
+      m_prefetchInUse(false), m_prefetchHits(0), m_prefetchMisses(0),
+      m_loadWaitNanoseconds(0) {
   m_free.clear();
 }
 
@@ -33,10 +38,18 @@ DiskBuffer::DiskBuffer()
 DiskBuffer::DiskBuffer(uint64_t m_writeBufferSize)
     : m_writeBufferSize(m_writeBufferSize), m_writeBufferUsed(0),
       m_nObjectsToWrite(0), m_free(), m_free_bySize(m_free.get<1>()),
-      m_fileLength(0) {
+      m_fileLength(0), m_prefetchedMemory(0), m_prefetchNextSeq(0),
+      m_prefetchUsedSeq(0), m_prefetchCurrent(nullptr),
+      m_prefetchRunning(false), m_prefetchInUse(false), m_prefetchHits(0),
+      m_prefetchMisses(0), m_loadWaitNanoseconds(0) {
   m_free.clear();
 }
 
+//----------------------------------------------------------------------------------------------
+/** Destructor. Stops the prefetch thread.
+ */
+DiskBuffer::~DiskBuffer() { cancelPrefetch(); }
+
 //---------------------------------------------------------------------------------------------
 /** Call this method when an object is ready to be written
  * out to disk.
@@ -85,6 +98,16 @@ void DiskBuffer::toWrite(ISaveable *item) {
 void DiskBuffer::objectDeleted(ISaveable *item) {
   if (item == nullptr)
     return;
+  if (m_prefetchInUse) {
+    std::unique_lock<std::mutex> prefetchLock(m_prefetchMutex);
+    // Let the prefetch thread finish with the object first
+    m_prefetchCondition.wait(
+        prefetchLock, [this, item] { return m_prefetchCurrent != item; });
+    m_prefetchQueued.erase(item);
+    forgetPrefetched(item);
+    updatePrefetchInUse();
+    m_prefetchCondition.notify_all();
+  }
   // have it ever been in the buffer?
   std::unique_lock<std::mutex> uniqueLock(m_mutex);
   auto opt2it = item->getBufPostion();
@@ -197,6 +220,199 @@ void DiskBuffer::flushCache() {
   writeOldObjects();
 }
 
+//---------------------------------------------------------------------------------------------
+/** Load objects ahead of their use on a background thread.
+ *
+ * The objects are loaded in the order given, as long as the memory of the
+ * prefetched objects that have not been used yet is within the size of the
+ * to-write buffer. Prefetched objects that are passed over (an object later
+ * in the list is used first) are unloaded again. The objects replace any
+ * that are still waiting from an earlier call.
+ *
+ * @param items :: objects to load, in the order they will be used
+ */
+void DiskBuffer::prefetch(const std::vector<ISaveable *> &items) {
+  std::unique_lock<std::mutex> lock(m_prefetchMutex);
+  // Everything from an earlier call has been passed over
+  m_prefetchUsedSeq = m_prefetchNextSeq;
+  m_prefetchQueue.clear();
+  m_prefetchQueued.clear();
+  for (auto item : items) {
+    m_prefetchQueue.emplace_back(item, m_prefetchNextSeq);
+    m_prefetchQueued.emplace(item, m_prefetchNextSeq);
+    ++m_prefetchNextSeq;
+  }
+  updatePrefetchInUse();
+  if (!m_prefetchRunning && m_prefetchInUse) {
+    // Tidy up the thread of an earlier call, which has finished
+    if (m_prefetchThread.joinable()) {
+      lock.unlock();
+      m_prefetchThread.join();
+      lock.lock();
+    }
+    m_prefetchRunning = true;
+    m_prefetchThread = std::thread(&DiskBuffer::prefetchLoop, this);
+  }
+  m_prefetchCondition.notify_all();
+}
+
+//---------------------------------------------------------------------------------------------
+/** Stop prefetching: forget the objects waiting to be loaded, as well as the
+ * prefetched objects, and wait for the prefetch thread to finish. Must be
+ * called before the file is closed.
+ */
+void DiskBuffer::cancelPrefetch() {
+  {
+    std::lock_guard<std::mutex> lock(m_prefetchMutex);
+    m_prefetchQueue.clear();
+    m_prefetchQueued.clear();
+    m_prefetched.clear();
+    m_prefetchedSeq.clear();
+    m_prefetchedMemory = 0;
+    m_prefetchCondition.notify_all();
+  }
+  if (m_prefetchThread.joinable())
+    m_prefetchThread.join();
+  std::lock_guard<std::mutex> lock(m_prefetchMutex);
+  updatePrefetchInUse();
+}
+
+//---------------------------------------------------------------------------------------------
+/** Call this method when the data of an object that may have been queued for
+ * prefetching is used, whether it was prefetched or read by the caller.
+ * Queued objects before it are taken as passed over.
+ *
+ * @param item :: object whose data is being used
+ */
+void DiskBuffer::prefetchUsed(ISaveable *item) {
+  if (!m_prefetchInUse)
+    return;
+  std::lock_guard<std::mutex> lock(m_prefetchMutex);
+  size_t seq;
+  auto queued = m_prefetchQueued.find(item);
+  auto prefetched = m_prefetchedSeq.find(item);
+  if (queued != m_prefetchQueued.end()) {
+    // Used before the prefetch thread got to it
+    seq = queued->second;
+    m_prefetchQueued.erase(queued);
+  } else if (prefetched != m_prefetchedSeq.end()) {
+    seq = prefetched->second;
+    forgetPrefetched(item);
+  } else {
+    return;
+  }
+  m_prefetchUsedSeq = std::max(m_prefetchUsedSeq, seq);
+  updatePrefetchInUse();
+  m_prefetchCondition.notify_all();
+}
+
+//---------------------------------------------------------------------------------------------
+/** Count a load of an object's data for the prefetch statistics.
+ *
+ * @param prefetched :: true if the data had been prefetched, false if it was
+ * read from the file by the caller
+ * @param waitTime :: time, in seconds, the caller waited for the data
+ */
+void DiskBuffer::recordLoad(const bool prefetched, const double waitTime) {
+  if (prefetched)
+    ++m_prefetchHits;
+  else
+    ++m_prefetchMisses;
+  m_loadWaitNanoseconds += static_cast<uint64_t>(waitTime * 1e9);
+}
+
+//---------------------------------------------------------------------------------------------
+/** Body of the prefetch thread. It unloads the prefetched objects that were
+ * passed over and loads the queued objects in order, waiting while the
+ * prefetched objects that have not been used yet fill the size of the
+ * to-write buffer. The thread ends once all the prefetched objects have been
+ * used or unloaded.
+ */
+void DiskBuffer::prefetchLoop() {
+  std::unique_lock<std::mutex> lock(m_prefetchMutex);
+  while (true) {
+    m_prefetchCondition.wait(lock, [this] {
+      if (hasPassedPrefetched() || m_prefetched.empty())
+        return true;
+      return !m_prefetchQueue.empty() && m_prefetchedMemory < m_writeBufferSize;
+    });
+
+    if (hasPassedPrefetched()) {
+      ISaveable *item = m_prefetched.begin()->second.first;
+      forgetPrefetched(item);
+      m_prefetchCurrent = item;
+      lock.unlock();
+      item->unloadAhead();
+      lock.lock();
+      m_prefetchCurrent = nullptr;
+      m_prefetchCondition.notify_all();
+      continue;
+    }
+    if (m_prefetchQueue.empty()) {
+      if (m_prefetched.empty())
+        break;
+      continue;
+    }
+
+    const auto next = m_prefetchQueue.front();
+    m_prefetchQueue.pop_front();
+    ISaveable *item = next.first;
+    // Skip objects that were used or deleted after they were queued
+    auto queued = m_prefetchQueued.find(item);
+    if (queued == m_prefetchQueued.end() || queued->second != next.second)
+      continue;
+    m_prefetchQueued.erase(queued);
+    if (next.second < m_prefetchUsedSeq)
+      continue;
+
+    m_prefetchCurrent = item;
+    lock.unlock();
+    size_t loaded = 0;
+    try {
+      loaded = item->loadAhead();
+    } catch (...) {
+      // The object is loaded again, and the error reported, when it is used
+    }
+    lock.lock();
+    m_prefetchCurrent = nullptr;
+    if (loaded > 0) {
+      m_prefetched.emplace(next.second, std::make_pair(item, loaded));
+      m_prefetchedSeq.emplace(item, next.second);
+      m_prefetchedMemory += loaded;
+    }
+    m_prefetchCondition.notify_all();
+  }
+  m_prefetchRunning = false;
+  updatePrefetchInUse();
+}
+
+/// @return true if a prefetched object has been passed over by its user.
+/// Must be called with m_prefetchMutex locked.
+bool DiskBuffer::hasPassedPrefetched() const {
+  return !m_prefetched.empty() &&
+         m_prefetched.begin()->first < m_prefetchUsedSeq;
+}
+
+/// Remove an object from the prefetched objects, if it is there.
+/// Must be called with m_prefetchMutex locked.
+void DiskBuffer::forgetPrefetched(ISaveable *item) {
+  auto seq = m_prefetchedSeq.find(item);
+  if (seq == m_prefetchedSeq.end())
+    return;
+  auto prefetched = m_prefetched.find(seq->second);
+  m_prefetchedMemory -= prefetched->second.second;
+  m_prefetched.erase(prefetched);
+  m_prefetchedSeq.erase(seq);
+}
+
+/// Update the flag telling objectDeleted and prefetchUsed whether they need
+/// to look at the prefetch containers. Must be called with m_prefetchMutex
+/// locked.
+void DiskBuffer::updatePrefetchInUse() {
+  m_prefetchInUse = !m_prefetchQueued.empty() || !m_prefetched.empty() ||
+                    m_prefetchCurrent != nullptr;
+}
+
 //---------------------------------------------------------------------------------------------
 /** This method is called by this->relocate when object that has shrunk
  * and so has left a bit of free space after itself on the file;
@@ -388,6 +604,9 @@ std::string DiskBuffer::getMemoryStr() const {
   std::ostringstream mess;
   mess << "Buffer: " << m_writeBufferUsed << " in " << m_nObjectsToWrite
        << " objects. ";
+  if (m_prefetchHits + m_prefetchMisses > 0)
+    mess << "Prefetch: " << m_prefetchHits << " hits, " << m_prefetchMisses
+         << " misses, " << getLoadWaitTime() << " s waiting for loads. ";
   return mess.str();
 }
 
@@ -0,0 +1,228 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <unordered_set>
+
+namespace Mantid {
+namespace Kernel {
+
+namespace {
+/// Source of the identifiers of the schedulers
+std::atomic<size_t> nextSchedulerId{1};
+/// Identifier of the scheduler whose pop() was last called from this thread
+thread_local size_t currentScheduler = 0;
+/// The thread number given to that pop() call
+thread_local size_t currentThread = 0;
+/// Number of parts the set of the mutexes in use is split into
+constexpr size_t NUM_BUSY_SHARDS = 64;
+} // namespace
+
+/// The tasks of one thread
+struct ThreadSchedulerWorkStealing::Queue {
+  /// Lock for this queue only
+  std::mutex lock;
+  /// The tasks, oldest first
+  std::deque<std::shared_ptr<Task>> tasks;
+  /// Cost of the tasks in the queue; only written with the lock held
+  std::atomic<double> queuedCost{0.};
+  /// Cost of all the tasks pushed since the last clear()
+  double pushedCost{0.};
+};
+
+/// The mutexes in use of the tasks whose mutexes map to one shard
+struct ThreadSchedulerWorkStealing::BusyShard {
+  /// Lock for this shard only
+  std::mutex lock;
+  /// Mutexes of the tasks currently running
+  std::unordered_set<std::shared_ptr<std::mutex>> mutexes;
+};
+
+/** Constructor
+ * @param numQueues :: number of queues; 0 uses one per physical core, which is
+ * the default number of threads of a ThreadPool
+ */
+ThreadSchedulerWorkStealing::ThreadSchedulerWorkStealing(size_t numQueues)
+    : m_id(nextSchedulerId++),
+      m_busy(std::make_unique<BusyShard[]>(NUM_BUSY_SHARDS)) {
+  if (numQueues == 0)
+    numQueues = ThreadPool::getNumPhysicalCores();
+  m_queues.resize(std::max(numQueues, size_t(1)));
+  for (auto &queue : m_queues)
+    queue = std::make_unique<Queue>();
+}
+
+ThreadSchedulerWorkStealing::~ThreadSchedulerWorkStealing() { clear(); }
+
+//-------------------------------------------------------------------------------
+/** Add a Task to the queue of the calling thread if it is running tasks of
+ * this scheduler, otherwise to the least loaded queue.
+ * @param newTask :: Task to add
+ */
+void ThreadSchedulerWorkStealing::push(std::shared_ptr<Task> newTask) {
+  const size_t index = (currentScheduler == m_id)
+                           ? currentThread % m_queues.size()
+                           : leastLoadedQueue();
+  const double cost = newTask->cost();
+  auto &queue = *m_queues[index];
+  std::lock_guard<std::mutex> lock(queue.lock);
+  queue.tasks.emplace_back(std::move(newTask));
+  queue.queuedCost = queue.queuedCost + cost;
+  queue.pushedCost += cost;
+  ++m_size;
+}
+
+//-------------------------------------------------------------------------------
+/** Retrieves the next Task to execute: the newest one of the thread's own
+ * queue, or else the oldest one of the queue with the most work left.
+ * @param threadnum :: ID of the calling thread.
+ * @return a Task to execute; NULL if there is none whose mutex is free.
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::pop(size_t threadnum) {
+  currentScheduler = m_id;
+  currentThread = threadnum;
+  if (m_size == 0)
+    return nullptr;
+
+  const size_t own = threadnum % m_queues.size();
+  auto task = popFrom(*m_queues[own], true);
+  if (task)
+    return task;
+
+  // Try the other queues, those with the most work left first
+  std::vector<size_t> victims(m_queues.size());
+  std::iota(victims.begin(), victims.end(), size_t(0));
+  victims.erase(victims.begin() + own);
+  std::sort(victims.begin(), victims.end(), [this](size_t lhs, size_t rhs) {
+    return m_queues[lhs]->queuedCost > m_queues[rhs]->queuedCost;
+  });
+  for (const auto victim : victims) {
+    task = popFrom(*m_queues[victim], false);
+    if (task) {
+      ++m_steals;
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+/** Take the first task of a queue whose mutex (if any) is not in use, and mark
+ * its mutex as used.
+ * @param queue :: the queue to search
+ * @param fromBack :: search from the newest task rather than the oldest
+ * @return the task; NULL if none can run now
+ */
+std::shared_ptr<Task> ThreadSchedulerWorkStealing::popFrom(Queue &queue,
+                                                           bool fromBack) {
+  std::lock_guard<std::mutex> lock(queue.lock);
+  auto &tasks = queue.tasks;
+  const size_t numTasks = tasks.size();
+  for (size_t i = 0; i < numTasks; ++i) {
+    const size_t pos = fromBack ? numTasks - 1 - i : i;
+    const auto &mutex = tasks[pos]->getMutex();
+    if (mutex && !tryAcquire(mutex))
+      continue;
+    auto task = std::move(tasks[pos]);
+    tasks.erase(tasks.begin() + pos);
+    queue.queuedCost =
+        tasks.empty() ? 0. : queue.queuedCost - task->cost();
+    --m_size;
+    return task;
+  }
+  return nullptr;
+}
+
+/** Mark a task mutex as used, if it is not already
+ * @param mutex :: the mutex of a task
+ * @return true if the mutex was free
+ */
+bool ThreadSchedulerWorkStealing::tryAcquire(
+    const std::shared_ptr<std::mutex> &mutex) {
+  auto &shard = busyShard(mutex);
+  std::lock_guard<std::mutex> lock(shard.lock);
+  return shard.mutexes.insert(mutex).second;
+}
+
+/** Find the part of the set of mutexes in use that holds a mutex, if it is in
+ * use
+ * @param mutex :: the mutex of a task
+ * @return the shard for the mutex
+ */
+ThreadSchedulerWorkStealing::BusyShard &
+ThreadSchedulerWorkStealing::busyShard(
+    const std::shared_ptr<std::mutex> &mutex) {
+  // Heap addresses are aligned, so their lowest bits carry no information
+  const auto address = reinterpret_cast<std::uintptr_t>(mutex.get());
+  return m_busy[(address / alignof(std::max_align_t)) % NUM_BUSY_SHARDS];
+}
+
+/// @return the index of the queue with the least queued cost
+size_t ThreadSchedulerWorkStealing::leastLoadedQueue() const {
+  size_t best = 0;
+  double bestCost = m_queues[0]->queuedCost;
+  for (size_t i = 1; i < m_queues.size() && bestCost > 0.; ++i) {
+    const double cost = m_queues[i]->queuedCost;
+    if (cost < bestCost) {
+      best = i;
+      bestCost = cost;
+    }
+  }
+  return best;
+}
+
+//-----------------------------------------------------------------------------------
+/** Signal to the scheduler that a task is complete, freeing its mutex.
+ *
+ * @param task :: the Task that was completed.
+ * @param threadnum :: unused argument
+ */
+void ThreadSchedulerWorkStealing::finished(Task *task, size_t threadnum) {
+  UNUSED_ARG(threadnum);
+  const auto &mutex = task->getMutex();
+  if (mutex) {
+    auto &shard = busyShard(mutex);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.mutexes.erase(mutex);
+  }
+}
+
+//-------------------------------------------------------------------------------
+/// @return the number of tasks in all the queues
+size_t ThreadSchedulerWorkStealing::size() { return m_size; }
+
+/// @return true if all the queues are empty
+bool ThreadSchedulerWorkStealing::empty() { return m_size == 0; }
+
+/// Empty out all the queues
+void ThreadSchedulerWorkStealing::clear() {
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    m_size -= queue->tasks.size();
+    queue->tasks.clear();
+    queue->queuedCost = 0.;
+    queue->pushedCost = 0.;
+  }
+  m_costExecuted = 0;
+}
+
+/// @return the total cost of the tasks pushed since the last clear()
+double ThreadSchedulerWorkStealing::totalCost() {
+  double total = 0.;
+  for (auto &queue : m_queues) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    total += queue->pushedCost;
+  }
+  return total;
+}
+
+} // namespace Kernel
+} // namespace Mantid
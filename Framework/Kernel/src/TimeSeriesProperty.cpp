@@ -160,6 +160,7 @@ operator+=(Property const *right) {
       m_values.insert(m_values.end(), rhs->m_values.begin(),
                       rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      invalidateCachedStatistics();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -331,6 +332,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  invalidateCachedStatistics();
 }
 
 /**
@@ -351,6 +353,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
 
   // 3. Prepare a copy
   std::vector<TimeValueUnit<TYPE>> mp_copy;
+  mp_copy.reserve(m_values.size() + splittervec.size());
 
   g_log.debug() << "DB541  mp_copy Size = " << mp_copy.size()
                 << "  Original MP Size = " << m_values.size() << "\n";
@@ -401,12 +404,11 @@ void TimeSeriesProperty<TYPE>::filterByTimes(
   g_log.debug() << "DB530  Filtered Log Size = " << mp_copy.size()
                 << "  Original Log Size = " << m_values.size() << "\n";
 
-  // 5. Clear
-  m_values.clear();
-  m_values = mp_copy;
-  mp_copy.clear();
+  // 5. Replace
+  m_values = std::move(mp_copy);
 
   m_size = static_cast<int>(m_values.size());
+  invalidateCachedStatistics();
 }
 
 /**
@@ -441,6 +443,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     auto *myOutput = dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.emplace_back(myOutput);
+      myOutput->invalidateCachedStatistics();
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -486,8 +489,14 @@ void TimeSeriesProperty<TYPE>::splitByTime(
     }
 
     // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
-      ++i_property;
+    i_property = static_cast<size_t>(
+        std::lower_bound(m_values.cbegin() + i_property, m_values.cend(),
+                         start,
+                         [](const TimeValueUnit<TYPE> &entry,
+                            const DateAndTime &time) {
+                           return entry.time() < time;
+                         }) -
+        m_values.cbegin());
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
@@ -840,10 +849,13 @@ void TimeSeriesProperty<std::string>::expandFilterToRange(
 }
 
 /** Calculates the time-weighted average of a property.
+ *  The result is kept until the values or the filter change.
  *  @return The time-weighted average value of the log.
  */
 template <typename TYPE>
 double TimeSeriesProperty<TYPE>::timeAverageValue() const {
+  if (m_timeAverageCache)
+    return m_timeAverageCache.get();
   double retVal = 0.0;
   try {
     const auto &filter = getSplittingIntervals();
@@ -852,6 +864,7 @@ double TimeSeriesProperty<TYPE>::timeAverageValue() const {
     // just return nan
     retVal = std::numeric_limits<double>::quiet_NaN();
   }
+  m_timeAverageCache = retVal;
   return retVal;
 }
 
@@ -1129,6 +1142,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time,
   }
 
   m_filterApplied = false;
+  invalidateCachedStatistics();
 }
 
 /** Add a value to the map
@@ -1174,6 +1188,7 @@ void TimeSeriesProperty<TYPE>::addValues(
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+  invalidateCachedStatistics();
 }
 
 /** replace vectors of values to the map. First we clear the vectors
@@ -1408,6 +1423,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
+  invalidateCachedStatistics();
 }
 
 /** Clears out all but the last value in the property.
@@ -1484,6 +1500,7 @@ void TimeSeriesProperty<TYPE>::create(
 
   // reset the size
   m_size = static_cast<int>(m_values.size());
+  invalidateCachedStatistics();
 }
 
 /** Returns the value at a particular time
@@ -1809,6 +1826,7 @@ void TimeSeriesProperty<TYPE>::filterWith(
   // 1. Clear the current
   m_filter.clear();
   m_filterQuickRef.clear();
+  invalidateCachedStatistics();
 
   if (filter->size() == 0) {
     // if filter is empty, return
@@ -1878,6 +1896,7 @@ void TimeSeriesProperty<TYPE>::filterWith(
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearFilter() {
   m_filter.clear();
   m_filterQuickRef.clear();
+  invalidateCachedStatistics();
 }
 
 /**
@@ -1945,10 +1964,13 @@ template <typename TYPE> bool TimeSeriesProperty<TYPE>::isDefault() const {
  * Return a TimeSeriesPropertyStatistics struct containing the
  * statistics of this TimeSeriesProperty object.
  *
- * N.B. This method DOES take filtering into account
+ * N.B. This method DOES take filtering into account. The result is kept until
+ * the values or the filter change.
  */
 template <typename TYPE>
 TimeSeriesPropertyStatistics TimeSeriesProperty<TYPE>::getStatistics() const {
+  if (m_statisticsCache)
+    return m_statisticsCache.get();
   TimeSeriesPropertyStatistics out;
   Mantid::Kernel::Statistics raw_stats =
       Mantid::Kernel::getStatistics(this->filteredValuesAsVector());
@@ -1974,6 +1996,7 @@ TimeSeriesPropertyStatistics TimeSeriesProperty<TYPE>::getStatistics() const {
     out.duration = std::numeric_limits<double>::quiet_NaN();
   }
 
+  m_statisticsCache = out;
   return out;
 }
 
@@ -2012,6 +2035,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  invalidateCachedStatistics();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved
@@ -2035,6 +2059,14 @@ std::string TimeSeriesProperty<TYPE>::toString() const {
 // Private methods
 //-------------------------------------------------------------------------
 
+/// Forget the statistics and time average computed for the current values and
+/// filter. Must be called whenever either of them changes.
+template <typename TYPE>
+void TimeSeriesProperty<TYPE>::invalidateCachedStatistics() const {
+  m_statisticsCache = boost::none;
+  m_timeAverageCache = boost::none;
+}
+
 //----------------------------------------------------------------------------------
 /*
  * Sort vector mP and set the flag. Only sorts if the values are not already
@@ -2274,14 +2306,21 @@ size_t TimeSeriesProperty<TYPE>::findNthIndexFromQuickRef(int n) const {
     // 2A.  Out side of boundary
     index = m_filterQuickRef.size();
   } else {
-    // 2B. Inside
-    for (size_t i = 0; i < m_filterQuickRef.size(); i += 4) {
-      if (static_cast<size_t>(n) >= m_filterQuickRef[i].second &&
-          static_cast<size_t>(n) < m_filterQuickRef[i + 3].second) {
-        index = i;
-        break;
-      }
+    // 2B. Inside. Every region takes four entries and starts counting where
+    // the previous one stopped, so bisect for the last region starting at or
+    // before n.
+    size_t low = 0;
+    size_t high = m_filterQuickRef.size() / 4;
+    while (low < high) {
+      const size_t mid = (low + high) / 2;
+      if (m_filterQuickRef[4 * mid].second <= static_cast<size_t>(n))
+        low = mid + 1;
+      else
+        high = mid;
     }
+    if (low > 0 &&
+        static_cast<size_t>(n) < m_filterQuickRef[4 * (low - 1) + 3].second)
+      index = 4 * (low - 1);
   }
 
   return index;
@@ -2307,6 +2346,8 @@ TimeSeriesProperty<TYPE>::setValueFromProperty(const Property &right) {
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  m_statisticsCache = prop->m_statisticsCache;
+  m_timeAverageCache = prop->m_timeAverageCache;
   return "";
 }
 
@@ -2465,9 +2506,20 @@ std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredValuesAsVector() const {
   }
   sortIfNecessary();
 
+  // Both the values and the filter are sorted by time, so walk through them
+  // together rather than searching the filter for every value. This gives the
+  // same answer as isTimeFiltered() for each value.
   std::vector<TYPE> filteredValues;
+  filteredValues.reserve(m_values.size());
+  auto filterEntry = m_filter.cbegin();
+  bool included = !filterEntry->second;
   for (const auto &value : m_values) {
-    if (isTimeFiltered(value.time())) {
+    while (filterEntry != m_filter.cend() &&
+           filterEntry->first <= value.time()) {
+      included = filterEntry->second;
+      ++filterEntry;
+    }
+    if (included) {
       filteredValues.emplace_back(value.value());
     }
   }
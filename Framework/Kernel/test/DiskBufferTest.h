@@ -19,6 +19,12 @@
 #include <boost/multi_index_container.hpp>
 #include <cxxtest/TestSuite.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
 using namespace Mantid;
 using namespace Mantid::Kernel;
 using Mantid::Kernel::CPUTimer;
@@ -103,6 +109,69 @@ public:
 std::string SaveableTesterWithFile::fakeFile;
 std::mutex SaveableTesterWithFile::streamMutex;
 
+//====================================================================================
+/** An ISaveable that can be loaded ahead by the DiskBuffer, counting how
+ * often it is read and unloaded */
+class SaveableTesterWithPrefetch : public ISaveable {
+public:
+  SaveableTesterWithPrefetch(DiskBuffer &buffer, uint64_t pos, uint64_t size)
+      : ISaveable(), m_buffer(buffer), m_memory(0), m_prefetched(false),
+        m_numReads(0), m_numUnloads(0) {
+    this->setFilePosition(pos, size, true);
+  }
+
+  void load() override {
+    std::lock_guard<std::mutex> lock(m_loadMutex);
+    const bool readFile = !this->isLoaded();
+    if (readFile)
+      read();
+    if (readFile || m_prefetched) {
+      m_buffer.recordLoad(!readFile, 0.);
+      m_prefetched = false;
+      m_buffer.prefetchUsed(this);
+    }
+  }
+  size_t loadAhead() override {
+    std::lock_guard<std::mutex> lock(m_loadMutex);
+    if (this->isLoaded())
+      return 0;
+    read();
+    m_prefetched = true;
+    return m_memory;
+  }
+  void unloadAhead() override {
+    std::lock_guard<std::mutex> lock(m_loadMutex);
+    if (!m_prefetched)
+      return;
+    m_prefetched = false;
+    clearDataFromMemory();
+    ++m_numUnloads;
+  }
+
+  void save() const override {}
+  void flushData() const override {}
+  void clearDataFromMemory() override {
+    m_memory = 0;
+    this->setLoaded(false);
+  }
+  uint64_t getTotalDataSize() const override { return this->getFileSize(); }
+  size_t getDataMemorySize() const override { return m_memory; }
+
+  DiskBuffer &m_buffer;
+  size_t m_memory;
+  bool m_prefetched;
+  std::atomic<int> m_numReads;
+  std::atomic<int> m_numUnloads;
+
+private:
+  void read() {
+    m_memory = static_cast<size_t>(this->getFileSize());
+    this->setLoaded(true);
+    ++m_numReads;
+  }
+  std::mutex m_loadMutex;
+};
+
 //====================================================================================
 class DiskBufferTest : public CxxTest::TestSuite {
 public:
@@ -673,6 +742,100 @@ public:
     delete blockD;
     // std::cout <<  ISaveableTesterWithFile::fakeFile << "!\n";
   }
+
+  //--------------------------------------------------------------------------------
+  /// Prefetching
+  void test_prefetched_objects_are_hits() {
+    DiskBuffer dbuf(1000);
+    auto objects = makePrefetchObjects(dbuf, 5);
+    dbuf.prefetch(prefetchItems(objects));
+    TS_ASSERT(waitFor([&objects] { return objects[4]->m_numReads == 1; }));
+
+    for (auto &object : objects)
+      object->load();
+    for (auto &object : objects)
+      TS_ASSERT_EQUALS(object->m_numReads.load(), 1);
+    TS_ASSERT_EQUALS(dbuf.getPrefetchHits(), 5);
+    TS_ASSERT_EQUALS(dbuf.getPrefetchMisses(), 0);
+    dbuf.cancelPrefetch();
+  }
+
+  void test_load_without_prefetch_is_a_miss() {
+    DiskBuffer dbuf(1000);
+    auto objects = makePrefetchObjects(dbuf, 1);
+    objects[0]->load();
+    TS_ASSERT_EQUALS(dbuf.getPrefetchHits(), 0);
+    TS_ASSERT_EQUALS(dbuf.getPrefetchMisses(), 1);
+  }
+
+  void test_prefetch_stays_within_the_write_buffer_size() {
+    DiskBuffer dbuf(25);
+    auto objects = makePrefetchObjects(dbuf, 5);
+    dbuf.prefetch(prefetchItems(objects));
+    TS_ASSERT(waitFor([&objects] { return objects[2]->m_numReads == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    TSM_ASSERT_EQUALS("30 events are prefetched, which fills the buffer",
+                      objects[3]->m_numReads.load(), 0);
+
+    objects[0]->load();
+    TS_ASSERT(waitFor([&objects] { return objects[3]->m_numReads == 1; }));
+    dbuf.cancelPrefetch();
+  }
+
+  void test_passed_over_objects_are_unloaded() {
+    DiskBuffer dbuf(1000);
+    auto objects = makePrefetchObjects(dbuf, 3);
+    dbuf.prefetch(prefetchItems(objects));
+    TS_ASSERT(waitFor([&objects] { return objects[2]->m_numReads == 1; }));
+
+    objects[2]->load();
+    TS_ASSERT(waitFor([&objects] {
+      return objects[0]->m_numUnloads == 1 && objects[1]->m_numUnloads == 1;
+    }));
+    TS_ASSERT_EQUALS(objects[2]->m_numUnloads.load(), 0);
+    TS_ASSERT_EQUALS(objects[2]->getDataMemorySize(), 10);
+    dbuf.cancelPrefetch();
+  }
+
+  void test_deleting_queued_objects() {
+    DiskBuffer dbuf(1000);
+    auto objects = makePrefetchObjects(dbuf, 100);
+    dbuf.prefetch(prefetchItems(objects));
+    for (auto &object : objects) {
+      dbuf.objectDeleted(object.get());
+      object.reset();
+    }
+    TS_ASSERT_THROWS_NOTHING(dbuf.cancelPrefetch());
+  }
+
+private:
+  using PrefetchObjects =
+      std::vector<std::unique_ptr<SaveableTesterWithPrefetch>>;
+
+  PrefetchObjects makePrefetchObjects(DiskBuffer &dbuf, size_t num) {
+    PrefetchObjects objects;
+    for (size_t i = 0; i < num; i++)
+      objects.emplace_back(
+          std::make_unique<SaveableTesterWithPrefetch>(dbuf, 10 * i, 10));
+    return objects;
+  }
+
+  std::vector<ISaveable *> prefetchItems(const PrefetchObjects &objects) {
+    std::vector<ISaveable *> items;
+    for (const auto &object : objects)
+      items.emplace_back(object.get());
+    return items;
+  }
+
+  /// Wait for the prefetch thread, up to 10 seconds
+  bool waitFor(const std::function<bool()> &condition) {
+    for (int i = 0; i < 10000; ++i) {
+      if (condition())
+        return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+  }
 };
 //====================================================================================
 // THIS TEST DOES NOT PROBABLY EXIST IN A WHILD ANY MORE; LEFT JUST IN CASE
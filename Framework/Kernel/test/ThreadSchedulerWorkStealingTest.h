@@ -0,0 +1,107 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/ThreadSchedulerWorkStealing.h"
+
+#include <memory>
+#include <utility>
+
+using namespace Mantid::Kernel;
+
+class ThreadSchedulerWorkStealingTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ThreadSchedulerWorkStealingTest *createSuite() {
+    return new ThreadSchedulerWorkStealingTest();
+  }
+  static void destroySuite(ThreadSchedulerWorkStealingTest *suite) {
+    delete suite;
+  }
+
+  class TaskWithCost : public Task {
+  public:
+    TaskWithCost(double cost,
+                 std::shared_ptr<std::mutex> mutex = nullptr) {
+      m_cost = cost;
+      m_mutex = std::move(mutex);
+    }
+    void run() override {}
+  };
+
+  void test_push_and_size() {
+    ThreadSchedulerWorkStealing sc(4);
+    TS_ASSERT_EQUALS(sc.numberOfQueues(), 4);
+    TS_ASSERT(sc.empty());
+    sc.push(std::make_shared<TaskWithCost>(10.0));
+    sc.push(std::make_shared<TaskWithCost>(5.0));
+    TS_ASSERT_EQUALS(sc.size(), 2);
+    TS_ASSERT(!sc.empty());
+    TS_ASSERT_DELTA(sc.totalCost(), 15.0, 1e-12);
+    sc.clear();
+    TS_ASSERT(sc.empty());
+    TS_ASSERT_EQUALS(sc.totalCost(), 0.0);
+  }
+
+  void test_outside_pushes_are_spread_by_cost() {
+    ThreadSchedulerWorkStealing sc(2);
+    auto big = std::make_shared<TaskWithCost>(10.0);
+    auto small1 = std::make_shared<TaskWithCost>(1.0);
+    auto small2 = std::make_shared<TaskWithCost>(1.0);
+    sc.push(big);
+    // Both small tasks go to the second queue, which has less work
+    sc.push(small1);
+    sc.push(small2);
+    TS_ASSERT_EQUALS(sc.pop(0), big);
+    TS_ASSERT_EQUALS(sc.numberOfSteals(), 0);
+    // Thread 1 takes its newest task
+    TS_ASSERT_EQUALS(sc.pop(1), small2);
+    // Thread 0 steals the oldest task of thread 1
+    TS_ASSERT_EQUALS(sc.pop(0), small1);
+    TS_ASSERT_EQUALS(sc.numberOfSteals(), 1);
+    TS_ASSERT(!sc.pop(0));
+  }
+
+  void test_pushes_from_a_running_task_stay_on_its_thread() {
+    ThreadSchedulerWorkStealing sc(2);
+    sc.push(std::make_shared<TaskWithCost>(1.0));
+    auto task = sc.pop(0);
+    TS_ASSERT(task);
+    // While "running" on thread 0, new tasks go to its queue
+    auto child1 = std::make_shared<TaskWithCost>(1.0);
+    auto child2 = std::make_shared<TaskWithCost>(1.0);
+    sc.push(child1);
+    sc.push(child2);
+    sc.finished(task.get(), 0);
+    TS_ASSERT_EQUALS(sc.pop(0), child2);
+    TS_ASSERT_EQUALS(sc.numberOfSteals(), 0);
+    TS_ASSERT_EQUALS(sc.pop(1), child1);
+    TS_ASSERT_EQUALS(sc.numberOfSteals(), 1);
+  }
+
+  void test_tasks_with_busy_mutex_are_skipped() {
+    ThreadSchedulerWorkStealing sc(1);
+    auto mutex = std::make_shared<std::mutex>();
+    auto io1 = std::make_shared<TaskWithCost>(1.0, mutex);
+    auto io2 = std::make_shared<TaskWithCost>(1.0, mutex);
+    auto other = std::make_shared<TaskWithCost>(1.0);
+    sc.push(other);
+    sc.push(io1);
+    sc.push(io2);
+    TS_ASSERT_EQUALS(sc.pop(0), io2);
+    // io1 waits for the mutex
+    TS_ASSERT_EQUALS(sc.pop(0), other);
+    TS_ASSERT(!sc.pop(0));
+    TS_ASSERT_EQUALS(sc.size(), 1);
+    sc.finished(io2.get(), 0);
+    TS_ASSERT_EQUALS(sc.pop(0), io1);
+    TS_ASSERT(sc.empty());
+  }
+};
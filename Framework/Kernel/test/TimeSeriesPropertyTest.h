@@ -2410,6 +2410,57 @@ public:
     TS_ASSERT_EQUALS(filteredValues.size(), 9);
   }
 
+  void test_nthValue_with_many_filter_regions() {
+    TimeSeriesProperty<int> log("IntLog");
+    const DateAndTime start("2020-01-01T00:00:00");
+    for (int i = 0; i < 100; ++i)
+      log.addValue(start + static_cast<double>(i), i);
+    // Keep the first 10 seconds of every 20
+    TimeSeriesProperty<bool> filter("Filter");
+    for (int i = 0; i < 10; ++i)
+      filter.addValue(start + 10.0 * i, i % 2 == 0);
+    log.filterWith(&filter);
+
+    TS_ASSERT_EQUALS(log.size(), 50);
+    const auto filteredValues = log.filteredValuesAsVector();
+    TS_ASSERT_EQUALS(filteredValues.size(), 50);
+    for (int n = 0; n < 50; ++n) {
+      const int expected = 20 * (n / 10) + n % 10;
+      TS_ASSERT_EQUALS(log.nthValue(n), expected);
+      TS_ASSERT_EQUALS(filteredValues[n], expected);
+    }
+  }
+
+  void test_statistics_are_recomputed_after_adding_values() {
+    const auto &log = getTestLog();
+    TS_ASSERT_DELTA(log->getStatistics().maximum, 11.0, 1e-6);
+    const double average = log->timeAverageValue();
+
+    log->addValue(log->lastTime() + 10.0, 20.0);
+    TS_ASSERT_DELTA(log->getStatistics().maximum, 20.0, 1e-6);
+    TS_ASSERT(log->timeAverageValue() > average);
+
+    log->clear();
+    TS_ASSERT(std::isnan(log->timeAverageValue()));
+  }
+
+  void test_statistics_are_recomputed_after_filter_changes() {
+    const auto &log = getTestLog();
+    TS_ASSERT_DELTA(log->getStatistics().maximum, 11.0, 1e-6);
+
+    auto filter = std::make_unique<TimeSeriesProperty<bool>>("Filter");
+    filter->addValue("2007-11-30T16:17:00", true);
+    filter->addValue("2007-11-30T16:17:15", false);
+    filter->addValue("2007-11-30T16:17:25", true);
+    filter->addValue("2007-11-30T16:18:35", false);
+    log->filterWith(filter.get());
+    TS_ASSERT_DELTA(log->getStatistics().maximum, 10.0, 1e-6);
+    TS_ASSERT_DELTA(log->timeAverageValue(), 5.588, 1e-3);
+
+    log->clearFilter();
+    TS_ASSERT_DELTA(log->getStatistics().maximum, 11.0, 1e-6);
+  }
+
   void test_getSplittingIntervals_noFilter() {
     const auto &log = getTestLog(); // no filter
     const auto &intervals = log->getSplittingIntervals();
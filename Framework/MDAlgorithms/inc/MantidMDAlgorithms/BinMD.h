@@ -67,11 +67,32 @@ private:
   template <typename MDE, size_t nd>
   void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
-  /// Method to bin a single MDBox
+  /// Method to bin a MDBox lying within a single bin from its cached signal
+  template <typename MDE, size_t nd>
+  bool binWholeMDBox(DataObjects::MDBox<MDE, nd> *box,
+                     const size_t *const chunkMin,
+                     const size_t *const chunkMax);
+
+  /// Method to bin the events of a single MDBox
   template <typename MDE, size_t nd>
   void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin,
                 const size_t *const chunkMax);
 
+  /// Add to the signal, error squared and number of events of a bin
+  void addToBin(const size_t index, const signal_t signal,
+                const signal_t errorSquared, const signal_t nEvents) {
+    if (signals) {
+      signals[index] += signal;
+      errors[index] += errorSquared;
+      numEvents[index] += nEvents;
+    } else {
+      // The sparse output
+      outWS->signalAt(index) += signal;
+      outWS->errorSquaredAt(index) += errorSquared;
+      outWS->setNumEventsAt(index, outWS->getNumEventsAt(index) + nEvents);
+    }
+  }
+
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
   /// Progress reporting
@@ -81,6 +102,7 @@ private:
 
   /// Cached values for speed up
   std::vector<size_t> indexMultiplier;
+  /// The arrays of the output, or null when it is sparse
   signal_t *signals;
   signal_t *errors;
   signal_t *numEvents;
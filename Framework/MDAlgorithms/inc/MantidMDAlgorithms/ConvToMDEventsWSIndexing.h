@@ -6,6 +6,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidDataObjects/MDBoxTreeBuilder.h"
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 #include "MantidMDAlgorithms/MDEventTreeBuilder.h"
 #include <mutex>
@@ -24,7 +25,9 @@ namespace MDAlgorithms {
  * coordinate and than assigns the groups of them to the
  * spatial tree-like box structure. The difference with
  * the ConvToMDEventsWS is in using the spatial index (Morton
- * numbers) for speeding up the procedure.
+ * numbers) for speeding up the procedure. When the boxes are not
+ * split the same power of 2 times along every dimension, the events are
+ * sorted into the boxes with DataObjects::MDBoxTreeBuilder instead.
  */
 class ConvToMDEventsWSIndexing : public ConvToMDEventsWS {
   enum MD_EVENT_TYPE { LEAN, REGULAR, NONE };
@@ -59,6 +62,9 @@ private:
 
   template <size_t ND> MD_EVENT_TYPE mdEventType();
 
+  /// True if the box tree is built from the Morton indices of the events
+  bool m_useMortonIndex{true};
+
   // Wrapper to have the proper functions, for Nd in range 2 to maxDim
   template <size_t maxDim>
   void appendEventsFromInputWS(API::Progress *pProgress,
@@ -177,13 +183,25 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
 template <typename EventType, size_t ND, template <size_t> class MDEventType>
 void ConvToMDEventsWSIndexing::appendEvents(API::Progress *pProgress,
                                             const API::BoxController_sptr &bc) {
-  bc->clearBoxesCounter(1);
-  bc->clearGridBoxesCounter(0);
   pProgress->resetNumSteps(2, 0, 1);
 
   std::vector<MDEventType<ND>> mdEvents =
       convertEvents<EventType, ND, MDEventType>();
 
+  if (!m_useMortonIndex) {
+    auto &ws =
+        dynamic_cast<DataObjects::MDEventWorkspace<MDEventType<ND>, ND> &>(
+            *m_OutWSWrapper->pWorkspace());
+    pProgress->report(0);
+    DataObjects::MDBoxTreeBuilder<MDEventType<ND>, ND>(ws).addEvents(mdEvents);
+    ws.refreshCache();
+    pProgress->report(1);
+    return;
+  }
+
+  bc->clearBoxesCounter(1);
+  bc->clearGridBoxesCounter(0);
+
   morton_index::MDSpaceBounds<ND> space;
   const auto &pws = m_OutWSWrapper->pWorkspace();
   for (size_t ax = 0; ax < ND; ++ax) {
@@ -9,6 +9,7 @@
 #include "MantidAPI/Algorithm.h"
 #include "MantidGeometry/Crystal/SymmetryOperationFactory.h"
 #include "MantidMDAlgorithms/DllConfig.h"
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
 
 namespace Mantid {
@@ -46,9 +47,11 @@ private:
   getValuesFromOtherDimensions(bool &skipNormalization,
                                uint16_t expInfoIndex = 0) const;
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues,
-                              const Geometry::SymmetryOperation &so,
-                              uint16_t expInfoIndex, size_t soIndex);
+  void calculateNormalization(
+      const std::vector<coord_t> &otherValues,
+      const std::vector<Geometry::SymmetryOperation> &symmetryOps,
+      uint16_t expInfoIndex);
+  void addNormalization();
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
                               const double theta, const double phi,
                               const Kernel::DblMatrix &transform,
@@ -79,14 +82,14 @@ private:
   size_t m_hIdx, m_kIdx, m_lIdx, m_eIdx;
   /// number of experimentInfo objects
   size_t m_numExptInfos;
-  /// number of symmetry operations
-  size_t m_numSymmOps;
   /// Cached value of incident energy dor direct geometry
   double m_Ei;
   /// Flag indicating if the input workspace is from diffraction
   bool m_diffraction;
   /// Flag to accumulate normalization
   bool m_accumulate;
+  /// Normalization summed over the experiment infos by the threads
+  std::unique_ptr<NormalizationAccumulator> m_normalization;
   /// Flag to indicate that the energy dimension is integrated
   bool m_dEIntegrated;
   /// Sample position
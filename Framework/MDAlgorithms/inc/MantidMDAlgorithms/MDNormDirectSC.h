@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/Algorithm.h"
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
 #include "MantidMDAlgorithms/SlicingAlgorithm.h"
 
 namespace Mantid {
@@ -48,6 +49,7 @@ private:
   void calculateNormalization(const std::vector<coord_t> &otherValues,
                               const Kernel::Matrix<coord_t> &affineTrans,
                               uint16_t expInfoIndex);
+  void addNormalization();
 
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections,
                               const double theta, const double phi);
@@ -76,6 +78,8 @@ private:
   std::string convention;
   /// internal flag to accumulate to an existing workspace
   bool m_accumulate{false};
+  /// Normalization summed over the experiment infos by the threads
+  std::unique_ptr<NormalizationAccumulator> m_normalization;
   /// number of experiment infos
   uint16_t m_numExptInfos;
 };
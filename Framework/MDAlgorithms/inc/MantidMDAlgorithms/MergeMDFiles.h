@@ -59,7 +59,8 @@ private:
 
   void finalizeOutput(const std::string &outputFile);
 
-  uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+  void mergeBoxes(const std::vector<API::IMDNode *> &boxes, const size_t first,
+                  const size_t last, const bool parallel);
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
@@ -0,0 +1,73 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidMDAlgorithms/DllConfig.h"
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** NormalizationAccumulator : sums the normalization of MDNorm, MDNormSCD and
+  MDNormDirectSC from the threads looping over the detectors.
+
+  When the histograms of all the threads fit in the memory budget, each thread
+  adds into a histogram of its own and the histograms are summed at the end,
+  so the threads never contend for a bin. Otherwise the threads share one
+  histogram and add into it with atomic operations.
+*/
+class MANTID_MDALGORITHMS_DLL NormalizationAccumulator {
+public:
+  NormalizationAccumulator(const size_t numPoints, const size_t numThreads,
+                           const size_t memoryBudget);
+
+  /** Add to the signal of a point. Must be called from a thread whose number
+   * is less than the number of threads given at construction.
+   * @param index :: linear index of the point
+   * @param signal :: signal to add
+   * @throws std::runtime_error if the number of the thread is too large
+   */
+  void add(const size_t index, const signal_t signal) {
+    if (m_threadSignals.empty()) {
+      Kernel::AtomicOp(m_sharedSignal[index], signal, std::plus<signal_t>());
+    } else {
+      const auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
+      if (thread >= m_numThreads)
+        throw std::runtime_error("NormalizationAccumulator: thread " +
+                                 std::to_string(thread) +
+                                 " has no histogram");
+      m_threadSignals[thread * m_numPoints + index] += signal;
+    }
+  }
+
+  /// @return true if each thread adds into a histogram of its own
+  bool usesThreadHistograms() const { return !m_threadSignals.empty(); }
+
+  void addTo(signal_t *signal, const bool accumulate) const;
+
+  static size_t memoryBudget();
+
+private:
+  /// Number of points in the histogram
+  size_t m_numPoints;
+  /// Number of threads adding to the histogram
+  size_t m_numThreads;
+  /// Histogram of each thread, one after the other
+  std::vector<signal_t> m_threadSignals;
+  /// Histogram shared by all threads when theirs do not fit the budget
+  std::vector<std::atomic<signal_t>> m_sharedSignal;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
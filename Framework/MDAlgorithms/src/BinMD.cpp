@@ -23,12 +23,19 @@
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
 // Register the algorithm into the AlgorithmFactory
 DECLARE_ALGORITHM(BinMD)
 
+namespace {
+/// Number of events transformed at once by binMDBox
+constexpr size_t EVENT_BATCH_SIZE = 512;
+} // namespace
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
@@ -78,6 +85,17 @@ void BinMD::init() {
       "due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
 
+  declareProperty(
+      std::make_unique<PropertyWithValue<bool>>("SparseOutput", false,
+                                                Direction::Input),
+      "Store the output in tiles of bins that are only allocated once one of "
+      "their bins holds data. This saves memory when most of the bins are "
+      "empty, but the binning does not run in parallel. Algorithms that "
+      "need the whole arrays of bins, such as the arithmetic on MD "
+      "histograms, SaveMD and ConvertMDHistoToMatrixWorkspace, make the "
+      "workspace dense again.");
+  setPropertyGroup("SparseOutput", grp);
+
   declareProperty(std::make_unique<WorkspaceProperty<IMDHistoWorkspace>>(
                       "TemporaryDataWorkspace", "", Direction::Input,
                       PropertyMode::Optional),
@@ -91,17 +109,21 @@ void BinMD::init() {
 }
 
 //----------------------------------------------------------------------------------------------
-/** Bin the contents of a MDBox
+/** Bin a MDBox from its cached signal if it lies entirely within a single
+ *bin, without looking at its events
  *
  * @param box :: pointer to the MDBox to bin
  * @param chunkMin :: the minimum index in each dimension to consider "valid"
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @return true if the box was binned, false if its events must be binned
+ *with binMDBox()
  */
 template <typename MDE, size_t nd>
-inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
-                            const size_t *const chunkMax) {
+inline bool BinMD::binWholeMDBox(MDBox<MDE, nd> *box,
+                                 const size_t *const chunkMin,
+                                 const size_t *const chunkMax) {
   // An array to hold the rotated/transformed coordinates
   auto outCenter = std::vector<coord_t>(m_outD);
 
@@ -164,57 +186,79 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
       //        std::cout << "Box at " << box->getExtentsStr() << " is within a
       //        single bin.\n";
       // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+      addToBin(lastLinearIndex, box->getSignal(), box->getErrorSquared(),
+               static_cast<signal_t>(box->getNPoints()));
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
-      return;
+      return true;
     }
   }
+  // Could not determine that the entire box was in the same bin
+  return false;
+}
 
-  // If you get here, you could not determine that the entire box was in the
-  // same bin.
-  // So you need to iterate through events.
+//----------------------------------------------------------------------------------------------
+/** Bin the events of a MDBox
+ *
+ * @param box :: pointer to the MDBox to bin
+ * @param chunkMin :: the minimum index in each dimension to consider "valid"
+ *(inclusive)
+ * @param chunkMax :: the maximum index in each dimension to consider "valid"
+ *(exclusive)
+ */
+template <typename MDE, size_t nd>
+inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin,
+                            const size_t *const chunkMax) {
+  // Iterate through the events. They are transformed a batch at a time, with
+  // the coordinates laid out one dimension after the other.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
+  const size_t batchSize = std::min(events.size(), EVENT_BATCH_SIZE);
+  std::vector<coord_t> inCenters(nd * batchSize);
+  std::vector<coord_t> outCenters(m_outD * batchSize);
+  for (size_t start = 0; start < events.size(); start += batchSize) {
+    const size_t numInBatch = std::min(batchSize, events.size() - start);
+    const MDE *batch = events.data() + start;
+    for (size_t d = 0; d < nd; d++) {
+      coord_t *centers = inCenters.data() + d * numInBatch;
+      for (size_t i = 0; i < numInBatch; i++)
+        centers[i] = batch[i].getCenter(d);
+    }
 
     // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter.data());
+    m_transform->applyBatch(inCenters.data(), outCenters.data(), numInBatch);
 
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
+    for (size_t i = 0; i < numInBatch; i++) {
+      // To build up the linear index
+      size_t linearIndex = 0;
+      // To mark events outside range
+      bool badOne = false;
 
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      auto ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
-      }
-    } // (for each dim in MDHisto)
+      /// Loop through the dimensions on which we bin
+      for (size_t bd = 0; bd < m_outD; bd++) {
+        // What is the bin index in that dimension
+        coord_t x = outCenters[bd * numInBatch + i];
+        auto ix = size_t(x);
+        // Within range (for this chunk)?
+        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+          // Build up the linear index
+          linearIndex += indexMultiplier[bd] * ix;
+        } else {
+          // Outside the range
+          badOne = true;
+          break;
+        }
+      } // (for each dim in MDHisto)
 
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
+      if (!badOne) {
+        // Sum the signals as doubles to preserve precision
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        addToBin(linearIndex, static_cast<signal_t>(batch[i].getSignal()),
+                 static_cast<signal_t>(batch[i].getErrorSquared()), 1.0);
+      }
     }
   }
   // Done with the events list
@@ -244,9 +288,18 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     else
       indexMultiplier[d] = 1;
   }
-  signals = outWS->mutableSignalArray();
-  errors = outWS->mutableErrorSquaredArray();
-  numEvents = outWS->mutableNumEventsArray();
+  // A sparse output is filled through its single-bin accessors, which
+  // allocate its tiles, so that it stays sparse
+  const bool sparse = outWS->isSparse();
+  if (sparse) {
+    signals = nullptr;
+    errors = nullptr;
+    numEvents = nullptr;
+  } else {
+    signals = outWS->mutableSignalArray();
+    errors = outWS->mutableErrorSquaredArray();
+    numEvents = outWS->mutableNumEventsArray();
+  }
 
   if (!m_accumulate) {
     // Start with signal/error/numEvents at 0.0
@@ -267,8 +320,9 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
 
   // Do we actually do it in parallel?
   bool doParallel = getProperty("Parallel");
-  // Not if file-backed!
-  if (bc->isFileBacked())
+  // Not if file-backed! Nor if the tiles of a sparse output are allocated as
+  // the bins are filled, as the chunks may share tiles
+  if (bc->isFileBacked() || sparse)
     doParallel = false;
   if (!doParallel)
     chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
@@ -314,11 +368,6 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       // Leaf-only; no depth limit; with the implicit function passed to it.
       ws->getBox()->getBoxes(boxes, 1000, true, function.get());
 
-      // Sort boxes by file position IF file backed. This reduces seeking time,
-      // hopefully.
-      if (bc->isFileBacked())
-        API::IMDNode::sortObjByID(boxes);
-
       // For progress reporting, the # of boxes
       if (prog) {
         PARALLEL_CRITICAL(BinMD_progress) {
@@ -329,12 +378,32 @@ void BinMD::binByIterating(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         }
       }
 
-      // Go through every box for this chunk.
+      // Bin the boxes lying within a single bin from their cached signal and
+      // keep the others, whose events are needed
+      std::vector<API::IMDNode *> eventBoxes;
+      eventBoxes.reserve(boxes.size());
       for (auto &boxe : boxes) {
         auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
+        if (box && !box->getIsMasked() &&
+            !this->binWholeMDBox(box, chunkMin.data(), chunkMax.data()))
+          eventBoxes.emplace_back(boxe);
+      }
+      if (prog)
+        prog->reportIncrement(boxes.size() - eventBoxes.size());
+
+      // Sort boxes by file position IF file backed. This reduces seeking time,
+      // hopefully.
+      if (bc->isFileBacked()) {
+        API::IMDNode::sortObjByID(eventBoxes);
+        // and load their events ahead on a background thread
+        API::IMDNode::prefetchObjData(eventBoxes);
+      }
+
+      // Go through every box left for this chunk.
+      for (auto &boxe : eventBoxes) {
         // Perform the binning in this separate method.
-        if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
+        this->binMDBox(static_cast<MDBox<MDE, nd> *>(boxe), chunkMin.data(),
+                       chunkMax.data());
 
         // Progress reporting
         if (prog)
@@ -377,12 +446,14 @@ void BinMD::exec() {
   // This gets deleted by the thread pool; don't delete it in here.
   prog = std::make_unique<Progress>(this, 0.0, 1.0, 1);
 
-  // Create the dense histogram. This allocates the memory
+  // Create the histogram. Unless it is sparse, this allocates the memory
   std::shared_ptr<IMDHistoWorkspace> tmp =
       this->getProperty("TemporaryDataWorkspace");
   outWS = std::dynamic_pointer_cast<MDHistoWorkspace>(tmp);
   if (!outWS) {
-    outWS = std::make_shared<MDHistoWorkspace>(m_binDimensions);
+    const bool sparse = getProperty("SparseOutput");
+    outWS = std::make_shared<MDHistoWorkspace>(
+        m_binDimensions, API::NoNormalization, sparse);
   } else {
     m_accumulate = true;
   }
@@ -14,19 +14,11 @@ size_t ConvToMDEventsWSIndexing::initialize(
     bool ignoreZeros) {
   size_t numSpec = ConvToMDEventsWS::initialize(WSD, inWSWrapper, ignoreZeros);
 
-  // check if split parameters are valid
-  auto &split_into =
-      m_OutWSWrapper->pWorkspace()->getBoxController()->getSplitIntoAll();
-
-  bool validSplitInfo = isSplitValid(split_into);
-  if (!validSplitInfo) {
-    std::string arg;
-    for (auto &i : split_into)
-      arg += std::to_string(i) + " ";
-    throw std::invalid_argument(
-        "SplitInto can't be [" + arg + "]" +
-        " ,all splits have to be the same and equal the power of 2.");
-  }
+  // The Morton indices only describe boxes split the same power of 2 times
+  // along every dimension; any other splitting uses MDBoxTreeBuilder
+  const auto bc = m_OutWSWrapper->pWorkspace()->getBoxController();
+  m_useMortonIndex = isSplitValid(bc->getSplitIntoAll()) &&
+                     !bc->getSplitTopInto().is_initialized();
   return numSpec;
 }
 
@@ -30,7 +30,6 @@
 
 #include "MantidGeometry/MDGeometry/MDHistoDimensionBuilder.h"
 
-#include "MantidMDAlgorithms/ConvToMDEventsWSIndexing.h"
 #include "MantidMDAlgorithms/ConvToMDSelector.h"
 #include "MantidMDAlgorithms/MDTransfQ3D.h"
 #include "MantidMDAlgorithms/MDWSTransform.h"
@@ -138,8 +137,6 @@ std::map<std::string, std::string> ConvertToMD::validateInputs() {
   std::map<std::string, std::string> result;
 
   const std::string treeBuilderType = this->getProperty("ConverterType");
-  const bool topLevelSplittingChecked = this->getProperty("TopLevelSplitting");
-  std::vector<int> split_into = this->getProperty("SplitInto");
   const std::string filename = this->getProperty("Filename");
   const bool fileBackEnd = this->getProperty("FileBackEnd");
 
@@ -151,18 +148,6 @@ std::map<std::string, std::string> ConvertToMD::validateInputs() {
     if (fileBackEnd)
       result["ConverterType"] += "No file back end implemented "
                                  "for indexed version of algorithm. ";
-
-    if (topLevelSplittingChecked)
-      result["ConverterType"] +=
-          "The usage of top level splitting is "
-          "not possible for indexed version of algorithm. ";
-
-    bool validSplitInfo = ConvToMDEventsWSIndexing::isSplitValid(split_into);
-    if (!validSplitInfo)
-      result["ConverterType"] +=
-          "The split parameter should be the same for"
-          " all dimensions and be equal the power of 2"
-          " (2 ,4, 8, 16,..) for indexed version of algorithm. ";
   }
 
   std::vector<double> minVals = this->getProperty("MinValues");
@@ -9,6 +9,7 @@
 #include <fstream>
 
 #include "MantidAPI/FileProperty.h"
+#include "MantidDataObjects/MDBoxTreeBuilder.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidDataObjects/MDEventInserter.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
@@ -113,8 +114,9 @@ DataObjects on the workspace.
 template <typename MDE, size_t nd>
 void ImportMDEventWorkspace::addEventsData(
     typename MDEventWorkspace<MDE, nd>::sptr ws) {
-  /// Creates a new instance of the MDEventInserter.
-  MDEventInserter<typename MDEventWorkspace<MDE, nd>::sptr> inserter(ws);
+  using Inserter = MDEventInserter<typename MDEventWorkspace<MDE, nd>::sptr>;
+  std::vector<MDE> events;
+  events.reserve(m_nDataObjects);
   auto mdEventEntriesIterator = m_posMDEventStart;
   std::vector<Mantid::coord_t> centers(nd);
   for (size_t i = 0; i < m_nDataObjects; ++i) {
@@ -129,10 +131,16 @@ void ImportMDEventWorkspace::addEventsData(
     for (size_t j = 0; j < m_nDimensions; ++j) {
       centers[j] = convert<Mantid::coord_t>(*(++mdEventEntriesIterator));
     }
-    // Actually add the mdevent.
-    inserter.insertMDEvent(signal, error * error, run_no, detector_no,
-                           centers.data());
+    events.emplace_back(Inserter::makeMDEvent(
+        signal, error * error, run_no, detector_no, centers.data()));
   }
+  // Build the box structure from all the events at once
+  const size_t numDropped = MDBoxTreeBuilder<MDE, nd>(*ws).addEvents(events);
+  if (numDropped > 0)
+    g_log.warning() << numDropped
+                    << " MDEvents were outside of the extents of the "
+                       "workspace and have not been imported.\n";
+  ws->refreshCache();
 }
 
 /**
@@ -305,6 +313,13 @@ void ImportMDEventWorkspace::exec() {
         static_cast<coord_t>(extentMaxs[i]), nbins)));
   }
 
+  // Split the boxes as CreateMDWorkspace does by default, rather than
+  // keeping all the events in a single box
+  auto bc = outWs->getBoxController();
+  bc->setSplitInto(5);
+  bc->setSplitThreshold(1000);
+  bc->setMaxDepth(5);
+  outWs->initialize();
   CALL_MDEVENT_FUNCTION(this->addEventsData, outWs)
 
   // set output
@@ -34,6 +34,7 @@
 #include <cmath>
 #include <fstream>
 #include <gsl/gsl_integration.h>
+#include <numeric>
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -48,6 +49,11 @@ using namespace Mantid::DataObjects;
 using namespace Mantid::DataObjects;
 using namespace Mantid::Geometry;
 
+namespace {
+/// Number of peaks whose spheres are integrated in one traversal of the boxes
+constexpr int PEAKS_PER_TRAVERSAL = 100;
+} // namespace
+
 /** Initialize the algorithm's properties.
  */
 void IntegratePeaksMD2::init() {
@@ -298,7 +304,91 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
-  Progress progress(this, 0., 1., nPeaks);
+  Progress progress(this, 0., 1., 2 * nPeaks);
+
+  // The peak centers as positions in the dimensions of the workspace, their
+  // distances to the edge of the detector and their modulus of Q
+  std::vector<V3D> positions(nPeaks);
+  std::vector<coord_t> centers(nd * nPeaks);
+  std::vector<double> edges(nPeaks);
+  std::vector<coord_t> lenQpeaks(nPeaks, 0);
+  for (int i = 0; i < nPeaks; ++i) {
+    IPeak &p = peakWS->getPeak(i);
+    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
+      positions[i] = p.getQLabFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
+      positions[i] = p.getQSampleFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
+      positions[i] = p.getHKL();
+    edges[i] = detectorQ(p.getQLabFrame(),
+                         std::max(BackgroundOuterRadius, PeakRadius));
+    for (size_t d = 0; d < nd; ++d) {
+      centers[nd * i + d] = static_cast<coord_t>(positions[i][d]);
+      if (adaptiveQMultiplier != 0.0)
+        lenQpeaks[i] += centers[nd * i + d] * centers[nd * i + d];
+    }
+    lenQpeaks[i] = std::sqrt(lenQpeaks[i]);
+  }
+
+  // Integrate the spheres of many peaks in each traversal of the boxes,
+  // rather than descending the boxes once per peak in the loop below
+  bool dimensionsUsed[nd];
+  std::fill_n(dimensionsUsed, nd, true);
+  std::vector<std::unique_ptr<CoordTransformDistance>> sphereTransforms(
+      nPeaks);
+  std::vector<MDIntegrationSphere> spheres;
+  std::vector<size_t> peakSpheres(nPeaks);
+  std::vector<size_t> backgroundSpheres(nPeaks);
+  // Index of the first sphere of each peak, followed by the number of spheres
+  std::vector<size_t> firstSpheres(nPeaks + 1, 0);
+  if (!cylinderBool) {
+    for (int i = 0; i < nPeaks; ++i) {
+      firstSpheres[i] = spheres.size();
+      const double adaptiveRadius =
+          adaptiveQMultiplier * lenQpeaks[i] + PeakRadius;
+      const bool offEdge =
+          edges[i] < std::max(BackgroundOuterRadius, PeakRadius);
+      if ((offEdge && !integrateEdge) || adaptiveRadius <= 0.0)
+        continue;
+      sphereTransforms[i] = std::make_unique<CoordTransformDistance>(
+          nd, &centers[nd * i], dimensionsUsed);
+      peakSpheres[i] = spheres.size();
+      spheres.emplace_back(MDIntegrationSphere{
+          sphereTransforms[i].get(), &centers[nd * i],
+          static_cast<coord_t>(adaptiveRadius * adaptiveRadius), 0});
+      if (BackgroundOuterRadius > PeakRadius) {
+        const double adaptiveBackground =
+            adaptiveQBackgroundMultiplier * lenQpeaks[i];
+        const double outerRadius = adaptiveBackground + BackgroundOuterRadius;
+        const double innerRadius = adaptiveBackground + BackgroundInnerRadius;
+        backgroundSpheres[i] = spheres.size();
+        spheres.emplace_back(MDIntegrationSphere{
+            sphereTransforms[i].get(), &centers[nd * i],
+            static_cast<coord_t>(outerRadius * outerRadius),
+            static_cast<coord_t>(innerRadius * innerRadius)});
+      }
+    }
+  }
+  firstSpheres[nPeaks] = spheres.size();
+  std::vector<signal_t> sphereSignals(spheres.size(), 0);
+  std::vector<signal_t> sphereErrorsSquared(spheres.size(), 0);
+  // A chunk of peaks at a time, to report progress and allow cancelling.
+  // Boxes loaded from a file are integrated one at a time.
+  const bool parallel = !ws->getBoxController()->isFileBacked();
+  for (int first = 0; first < nPeaks; first += PEAKS_PER_TRAVERSAL) {
+    interruption_point();
+    const int last = std::min(nPeaks, first + PEAKS_PER_TRAVERSAL);
+    const size_t firstSphere = firstSpheres[first];
+    std::vector<size_t> sphereIndices(firstSpheres[last] - firstSphere);
+    std::iota(sphereIndices.begin(), sphereIndices.end(), firstSphere);
+    if (!sphereIndices.empty())
+      ws->getBox()->integrateSpheres(
+          spheres, sphereIndices, sphereSignals.data() + firstSphere,
+          sphereErrorsSquared.data() + firstSphere,
+          useOnePercentBackgroundCorrection, parallel);
+    progress.reportIncrement(last - first, "Integrating spheres");
+  }
+
   for (int i = 0; i < nPeaks; ++i) {
     if (this->getCancel())
       break; // User cancellation
@@ -308,18 +398,11 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     IPeak &p = peakWS->getPeak(i);
 
     // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    const V3D &pos = positions[i];
 
     // Do not integrate if sphere is off edge of detector
 
-    double edge = detectorQ(p.getQLabFrame(),
-                            std::max(BackgroundOuterRadius, PeakRadius));
+    double edge = edges[i];
     if (edge < std::max(BackgroundOuterRadius, PeakRadius)) {
       g_log.warning() << "Warning: sphere/cylinder for integration is off edge "
                          "of detector for peak "
@@ -333,13 +416,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       }
     }
 
-    // Build the sphere transformation
-    bool dimensionsUsed[nd];
-    coord_t center[nd];
-    for (size_t d = 0; d < nd; ++d) {
-      dimensionsUsed[d] = true; // Use all dimensions
-      center[d] = static_cast<coord_t>(pos[d]);
-    }
+    const coord_t *center = &centers[nd * i];
     signal_t signal = 0;
     signal_t errorSquared = 0;
     signal_t bgSignal = 0;
@@ -347,14 +424,7 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     double background_total = 0.0;
     if (!cylinderBool) {
       // modulus of Q
-      coord_t lenQpeak = 0.0;
-      if (adaptiveQMultiplier != 0.0) {
-        lenQpeak = 0.0;
-        for (size_t d = 0; d < nd; d++) {
-          lenQpeak += center[d] * center[d];
-        }
-        lenQpeak = std::sqrt(lenQpeak);
-      }
+      const coord_t lenQpeak = lenQpeaks[i];
       double adaptiveRadius = adaptiveQMultiplier * lenQpeak + PeakRadius;
       if (adaptiveRadius <= 0.0) {
         g_log.error() << "Error: Radius for integration sphere of peak " << i
@@ -372,8 +442,6 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundInnerRadius;
       BackgroundOuterRadiusVector[i] =
           adaptiveQBackgroundMultiplier * lenQpeak + BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
-
       if (auto *shapeablePeak = dynamic_cast<Peak *>(&p)) {
 
         PeakShape *sphereShape = new PeakShapeSpherical(
@@ -383,28 +451,16 @@ void IntegratePeaksMD2::integrate(typename MDEventWorkspace<MDE, nd>::sptr ws) {
         shapeablePeak->setPeakShape(sphereShape);
       }
 
-      // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(
-          sphere, static_cast<coord_t>(adaptiveRadius * adaptiveRadius), signal,
-          errorSquared, 0.0 /* innerRadiusSquared */,
-          useOnePercentBackgroundCorrection);
+      // The sphere was integrated with those of all the other peaks
+      signal = sphereSignals[peakSpheres[i]];
+      errorSquared = sphereErrorsSquared[peakSpheres[i]];
 
       // Integrate around the background radius
 
       if (BackgroundOuterRadius > PeakRadius) {
         // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(
-            sphere,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundOuterRadius)),
-            bgSignal, bgErrorSquared,
-            static_cast<coord_t>((adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius) *
-                                 (adaptiveQBackgroundMultiplier * lenQpeak +
-                                  BackgroundInnerRadius)),
-            useOnePercentBackgroundCorrection);
+        bgSignal = sphereSignals[backgroundSpheres[i]];
+        bgErrorSquared = sphereErrorsSquared[backgroundSpheres[i]];
 
         // Relative volume of peak vs the BackgroundOuterRadius sphere
         const double radiusRatio = (PeakRadius / BackgroundOuterRadius);
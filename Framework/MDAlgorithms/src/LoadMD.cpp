@@ -592,21 +592,9 @@ void LoadMD::doLoad(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     const std::vector<uint64_t> &BoxEventIndex = FlatBoxTree.getEventIndex();
     prog->setNumSteps(numBoxes);
 
-    for (size_t i = 0; i < numBoxes; i++) {
-      prog->report();
-      auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxTree[i]);
-      if (!box)
-        continue;
-
-      if (BoxEventIndex[2 * i + 1] >
-          0) // Load in memory NOT using the file as the back-end,
-      {
-        boxTree[i]->reserveMemoryForLoad(BoxEventIndex[2 * i + 1]);
-        boxTree[i]->loadAndAddFrom(
-            loader.get(), BoxEventIndex[2 * i],
-            static_cast<size_t>(BoxEventIndex[2 * i + 1]));
-      }
-    }
+    // Load in memory NOT using the file as the back-end
+    MDBoxFlatTree::loadBoxesEvents(boxTree, BoxEventIndex, loader.get(),
+                                   prog.get());
     loader->closeFile();
   } else // box structure and metadata only
   {
@@ -29,6 +29,7 @@
 #include "MantidKernel/UnitLabelTypes.h"
 #include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
 #include <boost/lexical_cast.hpp>
 
 namespace Mantid {
@@ -416,6 +417,8 @@ std::map<std::string, std::string> MDNorm::validateInputs() {
 /** Execute the algorithm.
  */
 void MDNorm::exec() {
+  // Drop any sums left behind by an earlier execution that threw
+  m_normalization.reset();
   convention = Kernel::ConfigService::Instance().getString("Q.convention");
   // symmetry operations
   std::string symOps = this->getProperty("SymmetryOperations");
@@ -440,7 +443,6 @@ void MDNorm::exec() {
   for (auto so : symmetryOps) {
     g_log.debug() << so.identifier() << "\n";
   }
-  m_numSymmOps = symmetryOps.size();
 
   m_isRLU = getProperty("RLU");
   // get the workspaces
@@ -488,12 +490,7 @@ void MDNorm::exec() {
     cacheDimensionXValues();
 
     if (!skipNormalization) {
-      size_t symmOpsIndex = 0;
-      for (const auto &so : symmetryOps) {
-        calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex);
-        symmOpsIndex++;
-      }
-
+      calculateNormalization(otherValues, symmetryOps, expInfoIndex);
     } else {
       g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
                     "Not applying normalization.");
@@ -501,6 +498,7 @@ void MDNorm::exec() {
     // if more than one experiment info, keep accumulating
     m_accumulate = true;
   }
+  addNormalization();
 
   IAlgorithm_sptr divideMD = createChildAlgorithm("DivideMD", 0.99, 1.);
   divideMD->setProperty("LHSWorkspace", outputDataWS);
@@ -1135,15 +1133,17 @@ void MDNorm::cacheDimensionXValues() {
 
 /**
  * Computed the normalization for the input workspace. Results are stored in
- * m_normWS
+ * m_normWS. The trajectory of each detector is followed for every symmetry
+ * operation in turn, so that what depends on the detector alone is looked up
+ * once.
  * @param otherValues - values for dimensions other than Q or DeltaE
- * @param so - symmetry operation
+ * @param symmetryOps - symmetry operations
  * @param expInfoIndex - current experiment info index
- * @param soIndex - the index of symmetry operation (for progress purposes)
  */
-void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
-                                    const Geometry::SymmetryOperation &so,
-                                    uint16_t expInfoIndex, size_t soIndex) {
+void MDNorm::calculateNormalization(
+    const std::vector<coord_t> &otherValues,
+    const std::vector<Geometry::SymmetryOperation> &symmetryOps,
+    uint16_t expInfoIndex) {
   const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
   std::vector<double> lowValues, highValues;
   auto *lowValuesLog = dynamic_cast<VectorDoubleProperty *>(
@@ -1154,16 +1154,21 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
   highValues = (*highValuesLog)();
 
   DblMatrix R = currentExptInfo.run().getGoniometerMatrix();
-  DblMatrix soMatrix(3, 3);
-  auto v = so.transformHKL(V3D(1, 0, 0));
-  soMatrix.setColumn(0, v);
-  v = so.transformHKL(V3D(0, 1, 0));
-  soMatrix.setColumn(1, v);
-  v = so.transformHKL(V3D(0, 0, 1));
-  soMatrix.setColumn(2, v);
-  soMatrix.Invert();
-  DblMatrix Qtransform = R * m_UB * soMatrix * m_W;
-  Qtransform.Invert();
+  std::vector<DblMatrix> qTransforms;
+  qTransforms.reserve(symmetryOps.size());
+  for (const auto &so : symmetryOps) {
+    DblMatrix soMatrix(3, 3);
+    auto v = so.transformHKL(V3D(1, 0, 0));
+    soMatrix.setColumn(0, v);
+    v = so.transformHKL(V3D(0, 1, 0));
+    soMatrix.setColumn(1, v);
+    v = so.transformHKL(V3D(0, 0, 1));
+    soMatrix.setColumn(2, v);
+    soMatrix.Invert();
+    DblMatrix Qtransform = R * m_UB * soMatrix * m_W;
+    Qtransform.Invert();
+    qTransforms.emplace_back(Qtransform);
+  }
   const double protonCharge = currentExptInfo.run().getProtonCharge();
   const auto &spectrumInfo = currentExptInfo.spectrumInfo();
 
@@ -1183,21 +1188,29 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
       (m_diffraction) ? integrFlux->getDetectorIDToWorkspaceIndexMap()
                       : detid2index_map();
 
+  bool safe = true;
+  if (m_diffraction) {
+    safe = Kernel::threadSafe(*integrFlux);
+  }
+
   const size_t vmdDims = (m_diffraction) ? 3 : 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  // One accumulator sums the normalization of all the experiment infos, so
+  // that the histograms of the threads are allocated and summed only once
+  if (!m_normalization)
+    m_normalization = std::make_unique<NormalizationAccumulator>(
+        m_normWS->getNPoints(),
+        safe ? static_cast<size_t>(PARALLEL_GET_MAX_THREADS) : 1,
+        NormalizationAccumulator::memoryBudget());
+  auto &signalArray = *m_normalization;
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
 
-  double progStep = 0.7 / static_cast<double>(m_numExptInfos * m_numSymmOps);
-  auto progIndex = static_cast<double>(soIndex + expInfoIndex * m_numSymmOps);
+  double progStep = 0.7 / static_cast<double>(m_numExptInfos);
+  auto progIndex = static_cast<double>(expInfoIndex);
   auto prog =
       std::make_unique<API::Progress>(this, 0.3 + progStep * progIndex,
                                       0.3 + progStep * (1. + progIndex), ndets);
-  bool safe = true;
-  if (m_diffraction) {
-    safe = Kernel::threadSafe(*integrFlux);
-  }
   // cppcheck-suppress syntaxError
 PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (safe))
 for (int64_t i = 0; i < ndets; i++) {
@@ -1225,32 +1238,13 @@ for (int64_t i = 0; i < ndets; i++) {
     }
   }
 
-  // Intersections
-  this->calculateIntersections(intersections, theta, phi, Qtransform,
-                               lowValues[i], highValues[i]);
-  if (intersections.empty())
-    continue;
   // Get solid angle for this contribution
   double solid = protonCharge;
   if (haveSA) {
-    solid =
-        solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0] * protonCharge;
-  }
-  if (m_diffraction) {
-    // -- calculate integrals for the intersection --
-    // momentum values at intersections
-    auto intersectionsBegin = intersections.begin();
-    // copy momenta to xValues
-    xValues.resize(intersections.size());
-    yValues.resize(intersections.size());
-    auto x = xValues.begin();
-    for (auto it = intersectionsBegin; it != intersections.end(); ++it, ++x) {
-      *x = (*it)[3];
-    }
-    // calculate integrals at momenta from xValues by interpolating between
-    // points in spectrum sp
-    // of workspace integrFlux. The result is stored in yValues
-    calcIntegralsForIntersections(xValues, *integrFlux, wsIdx, yValues);
+    auto index = solidAngDetToIdx.find(detID);
+    if (index == solidAngDetToIdx.end())
+      continue; // no solid angle for this detector
+    solid = solidAngleWS->y(index->second)[0] * protonCharge;
   }
 
   // Compute final position in HKL
@@ -1258,47 +1252,70 @@ for (int64_t i = 0; i < ndets; i++) {
   pos.resize(vmdDims + otherValues.size());
   std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
 
-  auto intersectionsBegin = intersections.begin();
-  for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
-    const auto &curIntSec = *it;
-    const auto &prevIntSec = *(it - 1);
-    // the full vector isn't used so compute only what is necessary
-    double delta, eps;
+  for (const auto &Qtransform : qTransforms) {
+    // Intersections
+    this->calculateIntersections(intersections, theta, phi, Qtransform,
+                                 lowValues[i], highValues[i]);
+    if (intersections.empty())
+      continue;
     if (m_diffraction) {
-      delta = curIntSec[3] - prevIntSec[3];
-      eps = 1e-7;
-    } else {
-      delta = (curIntSec[3] * curIntSec[3] - prevIntSec[3] * prevIntSec[3]) /
-              energyToK;
-      eps = 1e-10;
+      // -- calculate integrals for the intersection --
+      // momentum values at intersections
+      auto intersectionsBegin = intersections.begin();
+      // copy momenta to xValues
+      xValues.resize(intersections.size());
+      yValues.resize(intersections.size());
+      auto x = xValues.begin();
+      for (auto it = intersectionsBegin; it != intersections.end(); ++it, ++x) {
+        *x = (*it)[3];
+      }
+      // calculate integrals at momenta from xValues by interpolating between
+      // points in spectrum sp
+      // of workspace integrFlux. The result is stored in yValues
+      calcIntegralsForIntersections(xValues, *integrFlux, wsIdx, yValues);
     }
-    if (delta < eps)
-      continue; // Assume zero contribution if difference is small
-    // Average between two intersections for final position
-    std::transform(curIntSec.data(), curIntSec.data() + vmdDims,
-                   prevIntSec.data(), pos.begin(),
-                   [](const double rhs, const double lhs) {
-                     return static_cast<coord_t>(0.5 * (rhs + lhs));
-                   });
-    signal_t signal;
-    if (m_diffraction) {
-      // index of the current intersection
-      auto k = static_cast<size_t>(std::distance(intersectionsBegin, it));
-      // signal = integral between two consecutive intersections
-      signal = (yValues[k] - yValues[k - 1]) * solid;
-    } else {
-      // transform kf to energy transfer
-      pos[3] = static_cast<coord_t>(m_Ei - pos[3] * pos[3] / energyToK);
-      // signal = energy distance between two consecutive intersections *solid
-      // angle *PC
-      signal = solid * delta;
+
+    auto intersectionsBegin = intersections.begin();
+    for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it) {
+      const auto &curIntSec = *it;
+      const auto &prevIntSec = *(it - 1);
+      // the full vector isn't used so compute only what is necessary
+      double delta, eps;
+      if (m_diffraction) {
+        delta = curIntSec[3] - prevIntSec[3];
+        eps = 1e-7;
+      } else {
+        delta = (curIntSec[3] * curIntSec[3] - prevIntSec[3] * prevIntSec[3]) /
+                energyToK;
+        eps = 1e-10;
+      }
+      if (delta < eps)
+        continue; // Assume zero contribution if difference is small
+      // Average between two intersections for final position
+      std::transform(curIntSec.data(), curIntSec.data() + vmdDims,
+                     prevIntSec.data(), pos.begin(),
+                     [](const double rhs, const double lhs) {
+                       return static_cast<coord_t>(0.5 * (rhs + lhs));
+                     });
+      signal_t signal;
+      if (m_diffraction) {
+        // index of the current intersection
+        auto k = static_cast<size_t>(std::distance(intersectionsBegin, it));
+        // signal = integral between two consecutive intersections
+        signal = (yValues[k] - yValues[k - 1]) * solid;
+      } else {
+        // transform kf to energy transfer
+        pos[3] = static_cast<coord_t>(m_Ei - pos[3] * pos[3] / energyToK);
+        // signal = energy distance between two consecutive intersections
+        // *solid angle *PC
+        signal = solid * delta;
+      }
+      m_transformation.multiplyPoint(pos, posNew);
+      size_t linIndex = m_normWS->getLinearIndexAtCoord(posNew.data());
+      if (linIndex == size_t(-1))
+        continue;
+      signalArray.add(linIndex, signal);
     }
-    m_transformation.multiplyPoint(pos, posNew);
-    size_t linIndex = m_normWS->getLinearIndexAtCoord(posNew.data());
-    if (linIndex == size_t(-1))
-      continue;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
   }
 
   prog->report();
@@ -1306,16 +1323,17 @@ for (int64_t i = 0; i < ndets; i++) {
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->mutableSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->mutableSignalArray());
 }
-m_accumulate = true;
+
+/**
+ * Add the normalization summed over the experiment infos to the normalization
+ * workspace, which holds either zeros or the normalization to accumulate to
+ */
+void MDNorm::addNormalization() {
+  if (!m_normalization)
+    return;
+  m_normalization->addTo(m_normWS->mutableSignalArray(), true);
+  m_normalization.reset();
 }
 
 /**
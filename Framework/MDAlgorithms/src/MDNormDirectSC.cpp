@@ -21,6 +21,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -139,6 +140,8 @@ void MDNormDirectSC::init() {
  * Execute the algorithm.
  */
 void MDNormDirectSC::exec() {
+  // Drop any sums left behind by an earlier execution that threw
+  m_normalization.reset();
   cacheInputs();
   auto outputWS = binInputWS();
   convention = Kernel::ConfigService::Instance().getString("Q.convention");
@@ -170,6 +173,7 @@ void MDNormDirectSC::exec() {
     // if more than one experiment info, keep accumulating
     m_accumulate = true;
   }
+  addNormalization();
 
   // Set the display normalization based on the input workspace
   outputWS->setDisplayNormalization(m_inputWS->displayNormalizationHisto());
@@ -494,7 +498,13 @@ void MDNormDirectSC::calculateNormalization(
   }
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  // One accumulator sums the normalization of all the experiment infos, so
+  // that the histograms of the threads are allocated and summed only once
+  if (!m_normalization)
+    m_normalization = std::make_unique<NormalizationAccumulator>(
+        m_normWS->getNPoints(), static_cast<size_t>(PARALLEL_GET_MAX_THREADS),
+        NormalizationAccumulator::memoryBudget());
+  auto &signalArray = *m_normalization;
   std::vector<std::array<double, 4>> intersections;
   std::vector<coord_t> pos, posNew;
   double progStep = 0.7 / m_numExptInfos;
@@ -560,23 +570,24 @@ for (int64_t i = 0; i < ndets; i++) {
     // signal = integral between two consecutive intersections *solid angle
     // *PC
     double signal = solid * delta;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    signalArray.add(linIndex, signal);
   }
   prog->report();
 
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->mutableSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->mutableSignalArray());
 }
+
+/**
+ * Add the normalization summed over the experiment infos to the normalization
+ * workspace, which holds either zeros or the normalization to accumulate to
+ */
+void MDNormDirectSC::addNormalization() {
+  if (!m_normalization)
+    return;
+  m_normalization->addTo(m_normWS->mutableSignalArray(), true);
+  m_normalization.reset();
 }
 
 /**
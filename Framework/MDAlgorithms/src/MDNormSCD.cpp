@@ -21,6 +21,7 @@
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/VectorHelper.h"
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
 
 namespace Mantid {
 namespace MDAlgorithms {
@@ -141,6 +142,8 @@ void MDNormSCD::init() {
  * Execute the algorithm.
  */
 void MDNormSCD::exec() {
+  // Drop any sums left behind by an earlier execution that threw
+  m_normalization.reset();
   cacheInputs();
   auto outputWS = binInputWS();
   convention = Kernel::ConfigService::Instance().getString("Q.convention");
@@ -171,6 +174,7 @@ void MDNormSCD::exec() {
     }
     m_accumulate = true;
   }
+  addNormalization();
 }
 
 /**
@@ -442,7 +446,13 @@ void MDNormSCD::calculateNormalization(
       solidAngleWS->getDetectorIDToWorkspaceIndexMap();
 
   const size_t vmdDims = 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  // One accumulator sums the normalization of all the experiment infos, so
+  // that the histograms of the threads are allocated and summed only once
+  if (!m_normalization)
+    m_normalization = std::make_unique<NormalizationAccumulator>(
+        m_normWS->getNPoints(), static_cast<size_t>(PARALLEL_GET_MAX_THREADS),
+        NormalizationAccumulator::memoryBudget());
+  auto &signalArray = *m_normalization;
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
@@ -520,23 +530,24 @@ for (int64_t i = 0; i < ndets; i++) {
     auto k = static_cast<size_t>(std::distance(intersectionsBegin, it));
     // signal = integral between two consecutive intersections
     signal_t signal = (yValues[k] - yValues[k - 1]) * solid;
-    Mantid::Kernel::AtomicOp(signalArray[linIndex], signal,
-                             std::plus<signal_t>());
+    signalArray.add(linIndex, signal);
   }
   prog->report();
 
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(
-      signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(),
-      m_normWS->mutableSignalArray(),
-      [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-} else {
-  std::copy(signalArray.cbegin(), signalArray.cend(),
-            m_normWS->mutableSignalArray());
 }
+
+/**
+ * Add the normalization summed over the experiment infos to the normalization
+ * workspace, which holds either zeros or the normalization to accumulate to
+ */
+void MDNormSCD::addNormalization() {
+  if (!m_normalization)
+    return;
+  m_normalization->addTo(m_normWS->mutableSignalArray(), true);
+  m_normalization.reset();
 }
 
 /**
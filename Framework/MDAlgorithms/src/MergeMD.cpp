@@ -7,6 +7,7 @@
 #include "MantidMDAlgorithms/MergeMD.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataObjects/MDBoxIterator.h"
+#include "MantidDataObjects/MDBoxTreeBuilder.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CPUTimer.h"
@@ -213,7 +214,6 @@ void MergeMD::doPlus(typename MDEventWorkspace<MDE, nd>::sptr ws2) {
   if (!ws1 || !ws2)
     throw std::runtime_error("Incompatible workspace types passed to MergeMD.");
 
-  MDBoxBase<MDE, nd> *box1 = ws1->getBox();
   MDBoxBase<MDE, nd> *box2 = ws2->getBox();
 
   uint16_t runIndexOffset = experimentInfoNo.back();
@@ -226,55 +226,48 @@ void MergeMD::doPlus(typename MDEventWorkspace<MDE, nd>::sptr ws2) {
   // workspace
   std::vector<API::IMDNode *> boxes;
   box2->getBoxes(boxes, 1000, true);
-  auto numBoxes = int(boxes.size());
 
   bool fileBasedSource(false);
   if (ws2->isFileBacked())
     fileBasedSource = true;
 
-  // Add the boxes in parallel. They should be spread out enough on each
-  // core to avoid stepping on each other.
-  // cppcheck-suppress syntaxError
-    PRAGMA_OMP( parallel for if (!ws2->isFileBacked()) )
-    for (int i = 0; i < numBoxes; i++) {
-      PARALLEL_START_INTERUPT_REGION
-      auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
-      if (box && !box->getIsMasked()) {
-        // Copy the events from WS2 and add them into WS1
-        const std::vector<MDE> &events = box->getConstEvents();
-        // Add events, with bounds checking
-
-        for (auto it = events.cbegin(); it != events.cend(); ++it) {
-          // Create the event
-          MDE newEvent(it->getSignal(), it->getErrorSquared(), it->getCenter());
-          // Copy extra data, if any
-          copyEvent(*it, newEvent, runIndexOffset);
-          // Add it to the workspace
-          box1->addEvent(newEvent);
-        }
-        if (fileBasedSource)
-          box->clear();
-        else
-          box->releaseEvents();
+  // Copy the events of WS2 in batches and add each batch to WS1 in one go,
+  // splitting the boxes of WS1 as they fill up.
+  MDBoxTreeBuilder<MDE, nd> builder(*ws1);
+  const size_t batchSize =
+      ws1->getBoxController()->getSignificantEventsNumber();
+  std::vector<MDE> batch;
+  for (auto node : boxes) {
+    interruption_point();
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (box && !box->getIsMasked()) {
+      const std::vector<MDE> &events = box->getConstEvents();
+      for (const auto &event : events) {
+        // Create the event
+        MDE newEvent(event.getSignal(), event.getErrorSquared(),
+                     event.getCenter());
+        // Copy extra data, if any
+        copyEvent(event, newEvent, runIndexOffset);
+        batch.emplace_back(newEvent);
       }
-      PARALLEL_END_INTERUPT_REGION
+      if (fileBasedSource)
+        box->clear();
+      else
+        box->releaseEvents();
     }
-    PARALLEL_CHECK_INTERUPT_REGION
-
-    // Progress * prog2 = new Progress(this, 0.4, 0.9, 100);
-    Progress *prog2 = nullptr;
-    ThreadScheduler *ts = new ThreadSchedulerFIFO();
-    ThreadPool tp(ts, 0, prog2);
-    ws1->splitAllIfNeeded(ts);
-    // prog2->resetNumSteps( ts->size(), 0.4, 0.6);
-    tp.joinAll();
-
-    // Set a marker that the file-back-end needs updating if the # of events
-    // changed.
-    if (ws1->getNPoints() != initial_numEvents)
-      ws1->setFileNeedsUpdating(true);
-    //
-    // std::cout << tim << " to add workspace " << ws2->name() << '\n';
+    if (batch.size() >= batchSize) {
+      builder.addEvents(batch);
+      batch.clear();
+    }
+  }
+  builder.addEvents(batch);
+
+  // Set a marker that the file-back-end needs updating if the # of events
+  // changed.
+  if (ws1->getNPoints() != initial_numEvents)
+    ws1->setFileNeedsUpdating(true);
+  //
+  // std::cout << tim << " to add workspace " << ws2->name() << '\n';
 }
 
 //----------------------------------------------------------------------------------------------
@@ -10,7 +10,9 @@
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/VectorHelper.h"
@@ -18,6 +20,8 @@
 #include <Poco/File.h>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -60,9 +64,16 @@ void MergeMDFiles::init() {
       "If not, it will be created in memory.");
 
   declareProperty("Parallel", false,
-                  "Run the loading tasks in parallel.\n"
+                  "Convert the merged events of the boxes in parallel.\n"
                   "This can be faster but might use more memory.");
 
+  auto mustBePositive = std::make_shared<BoundedValidator<double>>();
+  mustBePositive->setLower(0.0);
+  declareProperty("Memory", 1024.0, mustBePositive,
+                  "The amount of memory (in MB) used to hold the events of "
+                  "the boxes merged at a time. Larger values give larger "
+                  "reads from the input files.");
+
   declareProperty(std::make_unique<WorkspaceProperty<IMDEventWorkspace>>(
                       "OutputWorkspace", "", Direction::Output),
                   "An output MDEventWorkspace.");
@@ -153,39 +164,118 @@ void MergeMDFiles::loadBoxData() {
                  << " files.\n";
 }
 
-/** Task that loads all of the events from corresponded boxes of all files
- * that is being merged into a particular box in the output workspace.
+/** Merge the events of a batch of consecutive boxes from all the files.
+ *
+ * The boxes of each input file are read in order, with one read for each run
+ * of boxes which lie next to each other in the file. Their events are copied
+ * next to the events of the same box from the previous files, in the order of
+ * the boxes in the output. As the output boxes of the batch lie next to each
+ * other in the output file, a file-backed output is written with a single
+ * call, without going through the disk buffer.
+ *
+ * @param boxes :: all the boxes of the output workspace
+ * @param first :: index of the first box of the batch
+ * @param last :: index one past the last box of the batch
+ * @param parallel :: if true, the events of the boxes are set in parallel
  */
+void MergeMDFiles::mergeBoxes(const std::vector<API::IMDNode *> &boxes,
+                              const size_t first, const size_t last,
+                              const bool parallel) {
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
+  auto numEvents = [&boxes](const std::vector<uint64_t> &eventIndex,
+                            const size_t i) -> uint64_t {
+    return boxes[i]->isBox() ? eventIndex[2 * boxes[i]->getID() + 1] : 0;
+  };
+  auto filePosition = [&boxes](const std::vector<uint64_t> &eventIndex,
+                               const size_t i) {
+    return eventIndex[2 * boxes[i]->getID()];
+  };
+
+  // Offset of the events of each box in the merged events of the batch
+  const size_t numBoxes = last - first;
+  std::vector<uint64_t> offsets(numBoxes + 1, 0);
+  for (size_t i = first; i < last; ++i)
+    offsets[i - first + 1] =
+        offsets[i - first] + numEvents(targetEventIndexes, i);
+  // Number of events of each box copied so far
+  std::vector<uint64_t> filled(offsets.begin(), offsets.end() - 1);
+
+  std::vector<coord_t> merged;
+  std::vector<coord_t> run;
+  size_t numColumns = 0;
+  for (size_t iw = 0; iw < m_EventLoader.size(); ++iw) {
+    const auto &fileIndexes = m_fileComponentsStructure[iw].getEventIndex();
+    for (size_t i = first; i < last;) {
+      if (numEvents(fileIndexes, i) == 0) {
+        ++i;
+        continue;
+      }
+      const size_t runStart = i;
+      const uint64_t start = filePosition(fileIndexes, i);
+      uint64_t end = start;
+      for (; i < last && numEvents(fileIndexes, i) > 0 &&
+             filePosition(fileIndexes, i) == end;
+           ++i)
+        end += numEvents(fileIndexes, i);
+      m_EventLoader[iw]->loadBlock(run, start,
+                                   static_cast<size_t>(end - start));
+      if (numColumns == 0) {
+        numColumns = run.size() / static_cast<size_t>(end - start);
+        merged.resize(static_cast<size_t>(offsets.back()) * numColumns);
+      }
 
-uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
-  /// get rid of the events and averages which are in the memory erroneously
-  /// (from cloning)
-  TargetBox->clear();
-
-  uint64_t nBoxEvents(0);
-  std::vector<size_t> numFileEvents(m_EventLoader.size());
-
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    numFileEvents[iw] = static_cast<size_t>(
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 1]);
-    nBoxEvents += numFileEvents[iw];
+      auto source = run.cbegin();
+      for (size_t j = runStart; j < i; ++j) {
+        const auto size =
+            static_cast<size_t>(numEvents(fileIndexes, j)) * numColumns;
+        std::copy_n(source, size,
+                    merged.begin() + filled[j - first] * numColumns);
+        source += size;
+        filled[j - first] += numEvents(fileIndexes, j);
+      }
+    }
   }
+  // No events in this batch
+  if (numColumns == 0)
+    return;
 
-  // At this point memory required is known, so it is reserved all in one go
-  TargetBox->reserveMemoryForLoad(nBoxEvents);
+  if (m_fileBasedTargetWS) {
+    size_t firstWithEvents = first;
+    while (numEvents(targetEventIndexes, firstWithEvents) == 0)
+      ++firstWithEvents;
+    m_OutIWS->getBoxController()->getFileIO()->saveBlock(
+        merged, filePosition(targetEventIndexes, firstWithEvents));
+  }
 
-  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
-    size_t ID = TargetBox->getID();
-    uint64_t fileLocation =
-        m_fileComponentsStructure[iw].getEventIndex()[2 * ID + 0];
-    if (numFileEvents[iw] == 0)
+  PARALLEL_FOR_IF_DYNAMIC(parallel, 1)
+  for (int64_t k = 0; k < static_cast<int64_t>(numBoxes); ++k) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto index = static_cast<size_t>(k);
+    const auto size = static_cast<size_t>(offsets[index + 1] - offsets[index]);
+    if (size == 0)
       continue;
-    TargetBox->loadAndAddFrom(m_EventLoader[iw], fileLocation,
-                              numFileEvents[iw]);
+    API::IMDNode *box = boxes[first + index];
+    const auto begin = merged.cbegin() + offsets[index] * numColumns;
+    const auto end = begin + size * numColumns;
+    if (m_fileBasedTargetWS) {
+      // As saveAt does, keep the totals of the events which are on file.
+      // The signal and squared error are the first two columns.
+      double signal = 0.;
+      double errorSquared = 0.;
+      for (auto it = begin; it != end; it += numColumns) {
+        signal += it[0];
+        errorSquared += it[1];
+      }
+      box->setSignal(static_cast<signal_t>(signal));
+      box->setErrorSquared(static_cast<signal_t>(errorSquared));
+      box->setFileBacked(filePosition(targetEventIndexes, first + index), size,
+                         true);
+    } else {
+      box->setEventsData(std::vector<coord_t>(begin, end));
+    }
+    PARALLEL_END_INTERUPT_REGION
   }
-
-  return nBoxEvents;
+  PARALLEL_CHECK_INTERUPT_REGION
 }
 
 //----------------------------------------------------------------------------------------------
@@ -203,8 +293,8 @@ void MergeMDFiles::doExecByCloning(
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
+  const bool parallel = getProperty("Parallel");
+  const double memory = getProperty("Memory");
 
   // Fix the box controller settings in the output workspace so that it splits
   // normally
@@ -241,65 +331,42 @@ void MergeMDFiles::doExecByCloning(
   m_progress = std::make_unique<Progress>(this, 0.1, 0.9, size_t(numBoxes));
   m_progress->setNotifyStep(0.1);
 
-  // For tracking progress
-  // uint64_t m_totalEventsInTasks = 0;
-
-  // Prepare thread pool
   CPUTimer overallTime;
 
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
   Kernel::DiskBuffer *DiskBuf(nullptr);
   if (m_fileBasedTargetWS) {
     DiskBuf = bc->getFileIO();
   }
 
+  // Merge the boxes in batches which hold about the given memory, going
+  // through the boxes in the order of the output file.
+  const auto batchEvents = std::max(
+      uint64_t(1), static_cast<uint64_t>(memory * 1024. * 1024. /
+                                         double(m_OutIWS->sizeofEvent())));
+  const std::vector<uint64_t> &targetEventIndexes = m_BoxStruct.getEventIndex();
   this->m_totalLoaded = 0;
   std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
-
-  for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(boxes[ib]);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() >
-          0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
+  for (size_t first = 0; first < numBoxes;) {
+    uint64_t batchSize = 0;
+    size_t last = first;
+    for (; last < numBoxes; ++last) {
+      const uint64_t boxEvents =
+          boxes[last]->isBox()
+              ? targetEventIndexes[2 * boxes[last]->getID() + 1]
+              : 0;
+      if (last > first && batchSize + boxEvents > batchEvents)
+        break;
+      batchSize += boxEvents;
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    m_progress->reportIncrement(ib, "Loading and merging box data");
+    this->mergeBoxes(boxes, first, last, parallel);
+    m_totalLoaded += batchSize;
+    m_progress->reportIncrement(last - first, "Loading and merging box data");
+    first = last;
   }
   if (DiskBuf) {
     DiskBuf->flushCache();
     bc->getFileIO()->flushData();
   }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
@@ -0,0 +1,86 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
+#include "MantidKernel/ConfigService.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+namespace {
+/// Memory for the histograms of the threads when not configured, in MB
+constexpr int DEFAULT_MEMORY_BUDGET = 1024;
+/// Number of points summed by one thread at a time when merging
+constexpr size_t MERGE_TILE_SIZE = 4096;
+} // namespace
+
+/**
+ * Constructor
+ * @param numPoints :: number of points in the histogram
+ * @param numThreads :: number of threads that will add to it
+ * @param memoryBudget :: memory in bytes that the histograms of the threads
+ * may use
+ */
+NormalizationAccumulator::NormalizationAccumulator(const size_t numPoints,
+                                                   const size_t numThreads,
+                                                   const size_t memoryBudget)
+    : m_numPoints(numPoints), m_numThreads(std::max<size_t>(numThreads, 1)) {
+  if (m_numThreads > 1 &&
+      m_numThreads * m_numPoints * sizeof(signal_t) <= memoryBudget)
+    m_threadSignals.resize(m_numThreads * m_numPoints, 0.);
+  else
+    m_sharedSignal = std::vector<std::atomic<signal_t>>(m_numPoints);
+}
+
+/**
+ * Sum the histograms of the threads into a signal array. Each thread sums a
+ * tile of points of all the histograms at a time.
+ * @param signal :: array of the same number of points as the histogram
+ * @param accumulate :: add to the values of the array if true, replace them
+ * otherwise
+ */
+void NormalizationAccumulator::addTo(signal_t *signal,
+                                     const bool accumulate) const {
+  const auto numTiles = static_cast<int64_t>(
+      (m_numPoints + MERGE_TILE_SIZE - 1) / MERGE_TILE_SIZE);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t tile = 0; tile < numTiles; ++tile) {
+    const size_t begin = static_cast<size_t>(tile) * MERGE_TILE_SIZE;
+    const size_t end = std::min(begin + MERGE_TILE_SIZE, m_numPoints);
+    if (!accumulate)
+      std::fill(signal + begin, signal + end, 0.);
+    if (m_threadSignals.empty()) {
+      for (size_t i = begin; i < end; ++i)
+        signal[i] += m_sharedSignal[i];
+    } else {
+      for (size_t thread = 0; thread < m_numThreads; ++thread) {
+        const signal_t *threadSignal =
+            m_threadSignals.data() + thread * m_numPoints;
+        for (size_t i = begin; i < end; ++i)
+          signal[i] += threadSignal[i];
+      }
+    }
+  }
+}
+
+/**
+ * The memory the histograms of the threads may use, set in MB by the
+ * mdnorm.threadhistogrammemory property.
+ * @return the memory budget in bytes
+ */
+size_t NormalizationAccumulator::memoryBudget() {
+  const auto budget = Kernel::ConfigService::Instance().getValue<int>(
+      "mdnorm.threadhistogrammemory");
+  const int megabytes = budget.is_initialized() && budget.get() >= 0
+                            ? budget.get()
+                            : DEFAULT_MEMORY_BUDGET;
+  return static_cast<size_t>(megabytes) * 1024 * 1024;
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
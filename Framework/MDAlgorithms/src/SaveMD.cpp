@@ -82,6 +82,11 @@ void SaveMD::init() {
   setPropertySettings("MakeFileBacked",
                       std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd",
                                                             IS_EQUAL_TO, "0"));
+
+  declareProperty("CompressEvents", false,
+                  "For an MDEventWorkspace: compress the chunks of events "
+                  "written to a new file. Slower to save but gives smaller "
+                  "files.");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -165,9 +170,9 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = std::shared_ptr<API::IBoxControllerIO>(
-        new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto Saver = std::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
+    Saver->setCompressEvents(getProperty("CompressEvents"));
     if (makeFileBackend) {
       // store saver with box controller
       bc->setFileBacked(Saver, filename);
@@ -207,12 +212,8 @@ void SaveMD::doSaveEvents(typename MDEventWorkspace<MDE, nd>::sptr ws) {
       std::vector<API::IMDNode *> &boxes = BoxFlatStruct.getBoxes();
       std::vector<uint64_t> &eventIndex = BoxFlatStruct.getEventIndex();
       prog->resetNumSteps(boxes.size(), 0.06, 0.90);
-      for (size_t i = 0; i < boxes.size(); i++) {
-        if (eventIndex[2 * i + 1] == 0 || boxes[i]->getIsMasked())
-          continue;
-        boxes[i]->saveAt(Saver.get(), eventIndex[2 * i]);
-        prog->report("Saving Box");
-      }
+      MDBoxFlatTree::saveBoxesEvents(boxes, eventIndex, Saver.get(),
+                                     prog.get());
       Saver->closeFile();
     }
   }
@@ -81,6 +81,9 @@ void SaveMD2::init() {
       "Option to not save the sample in the file. Only for MDHisto");
   declareProperty("SaveLogs", true,
                   "Option to not save the logs in the file. Only for MDHisto");
+  declareProperty("CompressEvents", false,
+                  "Option to compress the chunks of events written to a new "
+                  "file. Only for MDEvent");
 }
 
 //----------------------------------------------------------------------------------------------
@@ -236,6 +239,8 @@ void SaveMD2::exec() {
                                 getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked",
                                 getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("CompressEvents",
+                                getProperty("CompressEvents"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
@@ -186,8 +186,11 @@ void SliceMD::slice(typename MDEventWorkspace<MDE, nd>::sptr ws) {
   // Sort boxes by file position IF file backed. This reduces seeking time,
   // hopefully.
   bool fileBackedWS = bc->isFileBacked();
-  if (fileBackedWS)
+  if (fileBackedWS) {
     API::IMDNode::sortObjByID(boxes);
+    // and load their events ahead on a background thread
+    API::IMDNode::prefetchObjData(boxes);
+  }
 
   auto prog = std::make_unique<Progress>(this, 0.0, 1.0, boxes.size());
 
@@ -251,6 +251,41 @@ public:
                      out_ws->getSignalAt(3), 1.0, 1e-5);
   }
 
+  void test_exec_sparse_output() {
+    Mantid::Geometry::QSample frame;
+    IMDEventWorkspace_sptr in_ws =
+        MDEventsTestHelper::makeAnyMDEWWithFrames<MDLeanEvent<3>, 3>(
+            10, 0.0, 10.0, frame, 1);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+
+    // 100000 bins, of which only the first tiles hold the events
+    BinMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    alg.setPropertyValue("InputWorkspace", "BinMDTest_ws");
+    alg.setPropertyValue("AlignedDim0", "Axis0,0.0,100.0,1000");
+    alg.setPropertyValue("AlignedDim1", "Axis1,0.0,100.0,100");
+    alg.setPropertyValue("AlignedDim2", "Axis2,0.0,10.0,1");
+    alg.setProperty("SparseOutput", true);
+    alg.setPropertyValue("OutputWorkspace", "BinMDTest_sparse");
+    TS_ASSERT_THROWS_NOTHING(alg.execute();)
+    TS_ASSERT(alg.isExecuted());
+
+    auto out = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(
+        "BinMDTest_sparse");
+    TS_ASSERT(out->isSparse());
+    TS_ASSERT_LESS_THAN(out->getMemorySize(),
+                        out->getNPoints() * out->sizeOfElement() / 4);
+    TS_ASSERT_EQUALS(out->getNEvents(), 1000);
+    double signal = 0.0;
+    for (size_t i = 0; i < out->getNPoints(); ++i)
+      signal += out->getSignalAt(i);
+    TS_ASSERT_DELTA(signal, 1000.0, 1e-6);
+    TS_ASSERT_EQUALS(out->getSignalAt(out->getNPoints() - 1), 0.0);
+
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+    AnalysisDataService::Instance().remove("BinMDTest_sparse");
+  }
+
   void test_exec_3D() {
     do_test_exec("", "Axis0,2.0,8.0, 6", "Axis1,2.0,8.0, 6", "Axis2,2.0,8.0, 6",
                  "", 1.0 /*signal*/, 6 * 6 * 6 /*# of bins*/,
@@ -297,6 +297,32 @@ public:
     TS_ASSERT_EQUALS("MDEvent", outWS->getEventTypeName());
   }
 
+  void test_many_mdevents_are_split_into_boxes() {
+    FileContentsBuilder fileContents;
+    std::string mdData;
+    for (size_t i = 0; i < 2000; ++i)
+      mdData += "1 1 " + std::to_string(i % 40) + " " +
+                std::to_string(i / 40) + "\n";
+    fileContents.setMDEventEntries(mdData);
+    MDFileObject infile(fileContents);
+    ImportMDEventWorkspace alg;
+    alg.initialize();
+    alg.setPropertyValue("Filename", infile.getFileName());
+    alg.setPropertyValue("OutputWorkspace", "test_out");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    IMDEventWorkspace_sptr outWS =
+        AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(
+            "test_out");
+    TS_ASSERT_EQUALS(2000, outWS->getNPoints());
+    auto bc = outWS->getBoxController();
+    TS_ASSERT_EQUALS(5, bc->getSplitInto(0));
+    TS_ASSERT_EQUALS(5, bc->getSplitInto(1));
+    // The events are spread over the 25 children of the top level box
+    TS_ASSERT_EQUALS(25, bc->getTotalNumMDBoxes());
+  }
+
   void test_load_full_mdevents_3d() {
     // Setup the corrupt file.
     FileContentsBuilder fileContents;
@@ -32,7 +32,14 @@ public:
 
   void test_exec_fileBacked() { do_test_exec("MergeMDFilesTest_OutputWS.nxs"); }
 
-  void do_test_exec(const std::string &OutputFilename) {
+  void test_exec_in_batches() { do_test_exec("", 0.01); }
+
+  void test_exec_fileBacked_in_batches() {
+    do_test_exec("MergeMDFilesTest_OutputWS.nxs", 0.01);
+  }
+
+  void do_test_exec(const std::string &OutputFilename,
+                    const double memory = 1024.) {
     if (OutputFilename != "") {
       if (Poco::File(OutputFilename).exists())
         Poco::File(OutputFilename).remove();
@@ -68,6 +75,7 @@ public:
         alg.setPropertyValue("OutputFilename", OutputFilename));
     TS_ASSERT_THROWS_NOTHING(
         alg.setPropertyValue("OutputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Memory", memory));
 
     // clean up possible rubbish from previous runs
     std::string fullName = alg.getPropertyValue("OutputFilename");
@@ -91,6 +99,8 @@ public:
 
     TS_ASSERT_EQUALS(appliedCoord, ws->getSpecialCoordinateSystem());
     TS_ASSERT_EQUALS(ws->getNPoints(), 3 * nFileEvents);
+    // Each event has a signal of 1
+    TS_ASSERT_DELTA(ws->getBox()->getSignal(), 3. * double(nFileEvents), 1e-6);
     MDBoxBase3Lean *box = ws->getBox();
     TS_ASSERT_EQUALS(box->getNumChildren(), 1000);
 
@@ -0,0 +1,98 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidMDAlgorithms/NormalizationAccumulator.h"
+
+#include <cxxtest/TestSuite.h>
+
+using Mantid::signal_t;
+using Mantid::MDAlgorithms::NormalizationAccumulator;
+
+class NormalizationAccumulatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static NormalizationAccumulatorTest *createSuite() {
+    return new NormalizationAccumulatorTest();
+  }
+  static void destroySuite(NormalizationAccumulatorTest *suite) {
+    delete suite;
+  }
+
+  void test_uses_thread_histograms_within_budget() {
+    const size_t numPoints = 100;
+    NormalizationAccumulator accumulator(numPoints, 4,
+                                         4 * numPoints * sizeof(signal_t));
+    TS_ASSERT(accumulator.usesThreadHistograms());
+  }
+
+  void test_shares_histogram_above_budget() {
+    const size_t numPoints = 100;
+    NormalizationAccumulator accumulator(numPoints, 4,
+                                         4 * numPoints * sizeof(signal_t) - 1);
+    TS_ASSERT(!accumulator.usesThreadHistograms());
+  }
+
+  void test_shares_histogram_with_one_thread() {
+    NormalizationAccumulator accumulator(100, 1, 1000000);
+    TS_ASSERT(!accumulator.usesThreadHistograms());
+  }
+
+  void test_thread_histograms_are_summed() {
+    do_test_sum(1000000000);
+  }
+
+  void test_shared_histogram_is_summed() { do_test_sum(0); }
+
+  void test_accumulate_adds_to_the_signal() {
+    NormalizationAccumulator accumulator(3, 2, 1000);
+    accumulator.add(0, 1.);
+    accumulator.add(2, 2.);
+    std::vector<signal_t> signal{1., 1., 1.};
+    accumulator.addTo(signal.data(), true);
+    TS_ASSERT_EQUALS(signal, std::vector<signal_t>({2., 1., 3.}));
+    accumulator.addTo(signal.data(), false);
+    TS_ASSERT_EQUALS(signal, std::vector<signal_t>({1., 0., 2.}));
+  }
+
+  void test_threads_without_a_histogram_throw() {
+    NormalizationAccumulator accumulator(10, 2, 1000);
+    TS_ASSERT(accumulator.usesThreadHistograms());
+    bool thrown = false;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < 64; ++i) {
+      if (PARALLEL_THREAD_NUMBER < 2)
+        continue;
+      try {
+        accumulator.add(0, 1.);
+      } catch (std::runtime_error &) {
+        PARALLEL_CRITICAL(NormalizationAccumulatorTest) { thrown = true; }
+      }
+    }
+    // Only reached by more than two threads
+    if (PARALLEL_GET_MAX_THREADS > 2)
+      TS_ASSERT(thrown);
+  }
+
+private:
+  void do_test_sum(const size_t memoryBudget) {
+    const size_t numPoints = 10000;
+    const int64_t numAdds = 100000;
+    NormalizationAccumulator accumulator(
+        numPoints, static_cast<size_t>(PARALLEL_GET_MAX_THREADS), memoryBudget);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numAdds; ++i)
+      accumulator.add(static_cast<size_t>(i) % numPoints, 0.5);
+
+    std::vector<signal_t> signal(numPoints, -1.);
+    accumulator.addTo(signal.data(), false);
+    for (const auto value : signal)
+      TS_ASSERT_EQUALS(value, 5.);
+  }
+};
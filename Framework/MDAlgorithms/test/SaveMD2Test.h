@@ -334,6 +334,53 @@ public:
     }
   }
 
+  void test_saveCompressedEventWorkspace() {
+    const std::string wsName("SaveMD2Test_compressedWS");
+    auto ws = MDEventsTestHelper::makeAnyMDEW<MDEvent<3>, 3>(10, 0., 10., 3,
+                                                             wsName);
+
+    const std::string saveFilename = "SaveMD2Test_compressed.nxs";
+    SaveMD2 saveAlg;
+    TS_ASSERT_THROWS_NOTHING(saveAlg.initialize())
+    TS_ASSERT_THROWS_NOTHING(
+        saveAlg.setPropertyValue("InputWorkspace", wsName));
+    TS_ASSERT_THROWS_NOTHING(
+        saveAlg.setPropertyValue("Filename", saveFilename));
+    TS_ASSERT_THROWS_NOTHING(saveAlg.setProperty("CompressEvents", true));
+    saveAlg.execute();
+    TS_ASSERT(saveAlg.isExecuted());
+
+    const std::string loadedWSName("SaveMD2Test_compressedLoadedWS");
+    LoadMD loadAlg;
+    TS_ASSERT_THROWS_NOTHING(loadAlg.initialize())
+    TS_ASSERT_THROWS_NOTHING(
+        loadAlg.setPropertyValue("Filename", saveFilename));
+    TS_ASSERT_THROWS_NOTHING(loadAlg.setProperty("FileBackEnd", false));
+    TS_ASSERT_THROWS_NOTHING(
+        loadAlg.setPropertyValue("OutputWorkspace", loadedWSName));
+    TS_ASSERT_THROWS_NOTHING(loadAlg.execute(););
+    TS_ASSERT(loadAlg.isExecuted());
+
+    MDEventWorkspace3::sptr loaded;
+    TS_ASSERT_THROWS_NOTHING(
+        loaded = AnalysisDataService::Instance().retrieveWS<MDEventWorkspace3>(
+            loadedWSName));
+    TS_ASSERT(loaded);
+    if (loaded) {
+      TS_ASSERT_EQUALS(loaded->getNPoints(), ws->getNPoints());
+      TS_ASSERT_EQUALS(loaded->getBoxController()->getTotalNumMDBoxes(),
+                       ws->getBoxController()->getTotalNumMDBoxes());
+      TS_ASSERT_DELTA(loaded->getBox()->getSignal(), ws->getBox()->getSignal(),
+                      1e-6);
+    }
+
+    AnalysisDataService::Instance().remove(wsName);
+    AnalysisDataService::Instance().remove(loadedWSName);
+    const std::string this_filename = saveAlg.getProperty("Filename");
+    if (Poco::File(this_filename).exists())
+      Poco::File(this_filename).remove();
+  }
+
   /** Run SaveMD with the MDHistoWorkspace */
   void doTestHisto(const MDHistoWorkspace_sptr &ws) {
     std::string filename = "SaveMD2TestHisto.nxs";
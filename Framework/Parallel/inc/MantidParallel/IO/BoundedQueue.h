@@ -0,0 +1,78 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Mantid {
+namespace Parallel {
+namespace IO {
+
+/** Queue with a maximum number of items, used to pass chunks between the
+  stages of a pipeline. push() blocks while the queue is full, so a fast
+  producer is held back by a slow consumer, and pop() blocks while it is empty.
+  Closing the queue wakes up all waiting threads.
+
+  @author Mantid
+  @date 2020
+*/
+template <class T> class BoundedQueue {
+public:
+  explicit BoundedQueue(const size_t capacity) : m_capacity(capacity) {}
+
+  /** Add an item, waiting until there is space for it.
+   * @param item :: the item to add
+   * @return false if the queue was closed and the item was dropped
+   */
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notFull.wait(lock,
+                   [this] { return m_closed || m_items.size() < m_capacity; });
+    if (m_closed)
+      return false;
+    m_items.emplace_back(std::move(item));
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  /** Remove the oldest item, waiting until there is one.
+   * @param item :: set to the removed item
+   * @return false if the queue is closed and empty
+   */
+  bool pop(T &item) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+    if (m_items.empty())
+      return false;
+    item = std::move(m_items.front());
+    m_items.pop_front();
+    m_notFull.notify_one();
+    return true;
+  }
+
+  /// Stop accepting items. Items already queued can still be popped.
+  void close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+    m_notFull.notify_all();
+    m_notEmpty.notify_all();
+  }
+
+private:
+  const size_t m_capacity;
+  std::deque<T> m_items;
+  bool m_closed{false};
+  std::mutex m_mutex;
+  std::condition_variable m_notFull;
+  std::condition_variable m_notEmpty;
+};
+
+} // namespace IO
+} // namespace Parallel
+} // namespace Mantid
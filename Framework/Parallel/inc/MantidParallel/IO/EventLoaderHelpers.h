@@ -8,11 +8,16 @@
 
 #include "MantidParallel/Communicator.h"
 #include "MantidParallel/DllConfig.h"
+#include "MantidParallel/IO/BoundedQueue.h"
 #include "MantidParallel/IO/Chunker.h"
 #include "MantidParallel/IO/EventParser.h"
 #include "MantidParallel/IO/NXEventDataLoader.h"
 #include "MantidParallel/IO/PulseTimeGenerator.h"
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
 namespace Mantid {
 namespace Parallel {
 namespace IO {
@@ -31,48 +36,105 @@ H5::DataType readDataType(const H5::Group &group,
                           const std::vector<std::string> &bankNames,
                           const std::string &name);
 
-template <class T> class ThreadWaiter {
-public:
-  ThreadWaiter(T &thread) : m_thread(thread) {}
-  ~ThreadWaiter() { m_thread.wait(); }
+/// Default number of chunks that may be read ahead of the parser.
+constexpr size_t defaultQueueDepth = 4;
+
+size_t readQueueDepth();
 
-private:
-  T &m_thread;
+/** A chunk of events that has been read and is waiting to be parsed.
+ *
+ * A new bank is announced by setting the partitioner and time offset unit on
+ * the first chunk of the bank, so the parser switches bank in step with the
+ * chunks it receives. */
+template <class TimeOffsetType> struct LoadedChunk {
+  size_t slot{0};
+  Chunker::LoadRange range{0, 0, 0};
+  std::unique_ptr<AbstractEventDataPartitioner<TimeOffsetType>> partitioner;
+  std::string timeOffsetUnit;
 };
 
+/** Load the events of all ranges of the chunker from the data source and pass
+ * them to the parser.
+ *
+ * Reading and parsing run as a two stage pipeline: this thread reads chunks
+ * into one of `queueDepth` buffers while a second thread parses the chunks in
+ * order. When all buffers hold chunks that have not been parsed yet the reader
+ * waits, which bounds the memory used by the pipeline to `queueDepth` chunks.
+ * An exception in either stage stops both and is rethrown here.
+ * @param chunker defines the ranges to load
+ * @param dataSource the file to read from
+ * @param dataSink the parser the events are passed to
+ * @param queueDepth number of chunks that may be read ahead of the parser
+ */
 template <class TimeOffsetType>
 void load(const Chunker &chunker, NXEventDataSource<TimeOffsetType> &dataSource,
-          EventParser<TimeOffsetType> &dataSink) {
+          EventParser<TimeOffsetType> &dataSink,
+          const size_t queueDepth = defaultQueueDepth) {
   const size_t chunkSize = chunker.chunkSize();
+  const size_t depth = std::max<size_t>(queueDepth, 1);
   const auto &ranges = chunker.makeLoadRanges();
-  std::vector<int32_t> event_id(2 * chunkSize);
-  std::vector<TimeOffsetType> event_time_offset(2 * chunkSize);
-  // Wait for thread completion before exit. Wrapped in struct in case of
-  // exceptions.
-  ThreadWaiter<EventParser<TimeOffsetType>> threadCleanup(dataSink);
-
-  int64_t previousBank = -1;
-  size_t bufferOffset{0};
-  for (const auto &range : ranges) {
-    std::unique_ptr<AbstractEventDataPartitioner<TimeOffsetType>> partitioner;
-    if (static_cast<int64_t>(range.bankIndex) != previousBank) {
-      partitioner = dataSource.setBankIndex(range.bankIndex);
+  std::vector<int32_t> event_id(depth * chunkSize);
+  std::vector<TimeOffsetType> event_time_offset(depth * chunkSize);
+
+  BoundedQueue<size_t> freeSlots(depth);
+  for (size_t slot = 0; slot < depth; ++slot)
+    freeSlots.push(slot);
+  BoundedQueue<LoadedChunk<TimeOffsetType>> loadedChunks(depth);
+
+  std::exception_ptr parseError;
+  std::thread parser([&] {
+    try {
+      LoadedChunk<TimeOffsetType> chunk;
+      while (loadedChunks.pop(chunk)) {
+        if (chunk.partitioner) {
+          dataSink.setEventDataPartitioner(std::move(chunk.partitioner));
+          dataSink.setEventTimeOffsetUnit(chunk.timeOffsetUnit);
+        }
+        const size_t offset = chunk.slot * chunkSize;
+        dataSink.parse(event_id.data() + offset,
+                       event_time_offset.data() + offset, chunk.range);
+        freeSlots.push(chunk.slot);
+      }
+    } catch (...) {
+      parseError = std::current_exception();
+      // Unblock the reader, which may be waiting for a free slot.
+      freeSlots.close();
+      loadedChunks.close();
     }
-    dataSource.readEventID(event_id.data() + bufferOffset, range.eventOffset,
-                           range.eventCount);
-    dataSource.readEventTimeOffset(event_time_offset.data() + bufferOffset,
-                                   range.eventOffset, range.eventCount);
-    if (previousBank != -1)
-      dataSink.wait();
-    if (static_cast<int64_t>(range.bankIndex) != previousBank) {
-      dataSink.setEventDataPartitioner(std::move(partitioner));
-      dataSink.setEventTimeOffsetUnit(dataSource.readEventTimeOffsetUnit());
-      previousBank = range.bankIndex;
+  });
+
+  std::exception_ptr readError;
+  try {
+    int64_t previousBank = -1;
+    for (const auto &range : ranges) {
+      LoadedChunk<TimeOffsetType> chunk;
+      if (!freeSlots.pop(chunk.slot))
+        break;
+      if (static_cast<int64_t>(range.bankIndex) != previousBank) {
+        chunk.partitioner = dataSource.setBankIndex(range.bankIndex);
+        chunk.timeOffsetUnit = dataSource.readEventTimeOffsetUnit();
+        previousBank = range.bankIndex;
+      }
+      const size_t offset = chunk.slot * chunkSize;
+      dataSource.readEventID(event_id.data() + offset, range.eventOffset,
+                             range.eventCount);
+      dataSource.readEventTimeOffset(event_time_offset.data() + offset,
+                                     range.eventOffset, range.eventCount);
+      chunk.range = range;
+      if (!loadedChunks.push(std::move(chunk)))
+        break;
     }
-    dataSink.startAsync(event_id.data() + bufferOffset,
-                        event_time_offset.data() + bufferOffset, range);
-    bufferOffset = (bufferOffset + chunkSize) % (2 * chunkSize);
+  } catch (...) {
+    readError = std::current_exception();
   }
+  // The parser finishes the chunks that have been queued and then exits.
+  loadedChunks.close();
+  parser.join();
+
+  if (readError)
+    std::rethrow_exception(readError);
+  if (parseError)
+    std::rethrow_exception(parseError);
 }
 
 template <class TimeOffsetType>
@@ -94,7 +156,7 @@ void load(
   NXEventDataLoader<TimeOffsetType> loader(comm.size(), group, bankNames);
   EventParser<TimeOffsetType> consumer(comm, chunker.makeWorkerGroups(),
                                        bankOffsets, eventLists);
-  load<TimeOffsetType>(chunker, loader, consumer);
+  load<TimeOffsetType>(chunker, loader, consumer, readQueueDepth());
 }
 
 /// Translate from H5::DataType to actual type, forward to load implementation.
@@ -59,11 +59,11 @@ public:
 
   void wait();
 
-private:
-  void doParsing(int32_t *event_id_start,
-                 const TimeOffsetType *event_time_offset_start,
-                 const Chunker::LoadRange &range);
+  void parse(int32_t *event_id_start,
+             const TimeOffsetType *event_time_offset_start,
+             const Chunker::LoadRange &range);
 
+private:
   void redistributeDataMPI();
   void populateEventLists();
 
@@ -215,16 +215,24 @@ template <class TimeOffsetType>
 void EventParser<TimeOffsetType>::startAsync(
     int32_t *event_id_start, const TimeOffsetType *event_time_offset_start,
     const Chunker::LoadRange &range) {
-  // Wrapped in lambda because std::thread is unable to specialize doParsing on
-  // its own
+  // Wrapped in lambda because std::thread is unable to specialize parse on its
+  // own
   m_thread =
       std::thread([this, event_id_start, event_time_offset_start, range] {
-        doParsing(event_id_start, event_time_offset_start, range);
+        parse(event_id_start, event_time_offset_start, range);
       });
 }
 
+/** Parse a chunk of events synchronously in the calling thread. This is what
+ * startAsync runs in its thread; a caller that provides its own threading,
+ * such as the pipeline in EventLoader::load, calls it directly. Chunks must be
+ * passed in file order to preserve the pulse time ordering of the events.
+ * @param event_id_start Buffer containing event IDs, converted in place.
+ * @param event_time_offset_start Buffer containing TOD.
+ * @param range the bank, offset and number of events of the chunk.
+ */
 template <class TimeOffsetType>
-void EventParser<TimeOffsetType>::doParsing(
+void EventParser<TimeOffsetType>::parse(
     int32_t *event_id_start, const TimeOffsetType *event_time_offset_start,
     const Chunker::LoadRange &range) {
   // change event_id_start in place
@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidParallel/IO/EventLoaderHelpers.h"
+#include "MantidKernel/ConfigService.h"
 
 namespace Mantid {
 namespace Parallel {
@@ -28,6 +29,16 @@ H5::DataType readDataType(const H5::Group &group,
   return group.openDataSet(bankNames.front() + "/" + name).getDataType();
 }
 
+/// Number of chunks that may be read ahead of the parser, from the
+/// `eventloader.queuedepth` setting.
+size_t readQueueDepth() {
+  const auto depth =
+      Kernel::ConfigService::Instance().getValue<int>("eventloader.queuedepth");
+  if (depth.is_initialized() && depth.get() > 0)
+    return static_cast<size_t>(depth.get());
+  return defaultQueueDepth;
+}
+
 } // namespace EventLoader
 } // namespace IO
 } // namespace Parallel
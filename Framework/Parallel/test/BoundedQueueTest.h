@@ -0,0 +1,85 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "MantidParallel/IO/BoundedQueue.h"
+
+using namespace Mantid::Parallel::IO;
+
+class BoundedQueueTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BoundedQueueTest *createSuite() { return new BoundedQueueTest(); }
+  static void destroySuite(BoundedQueueTest *suite) { delete suite; }
+
+  void test_fifo_order() {
+    BoundedQueue<int> queue(3);
+    TS_ASSERT(queue.push(1));
+    TS_ASSERT(queue.push(2));
+    TS_ASSERT(queue.push(3));
+    int item{0};
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 1);
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 2);
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 3);
+  }
+
+  void test_close_drains_queued_items() {
+    BoundedQueue<int> queue(2);
+    queue.push(7);
+    queue.close();
+    TS_ASSERT(!queue.push(8));
+    int item{0};
+    TS_ASSERT(queue.pop(item));
+    TS_ASSERT_EQUALS(item, 7);
+    TS_ASSERT(!queue.pop(item));
+  }
+
+  void test_close_wakes_blocked_consumer() {
+    BoundedQueue<int> queue(1);
+    bool popped{true};
+    std::thread consumer([&] {
+      int item;
+      popped = queue.pop(item);
+    });
+    queue.close();
+    consumer.join();
+    TS_ASSERT(!popped);
+  }
+
+  void test_push_blocks_while_full() {
+    BoundedQueue<int> queue(2);
+    std::atomic<int> pushed{0};
+    std::thread producer([&] {
+      for (int i = 0; i < 100; ++i) {
+        queue.push(i);
+        ++pushed;
+      }
+      queue.close();
+    });
+    std::vector<int> items;
+    int item;
+    while (queue.pop(item)) {
+      // The producer can never be more than the capacity ahead.
+      TS_ASSERT(pushed.load() <= static_cast<int>(items.size()) + 3);
+      items.emplace_back(item);
+    }
+    producer.join();
+    TS_ASSERT_EQUALS(items.size(), 100);
+    for (int i = 0; i < 100; ++i)
+      TS_ASSERT_EQUALS(items[i], i);
+  }
+};
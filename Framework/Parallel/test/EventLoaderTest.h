@@ -91,7 +91,19 @@ private:
   size_t m_bank{0};
 };
 
-void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize) {
+class FailingDataSource : public FakeDataSource {
+public:
+  using FakeDataSource::FakeDataSource;
+  void readEventTimeOffset(int32_t *event_time_offset, size_t start,
+                           size_t count) const override {
+    if (start > 0)
+      throw std::runtime_error("read failed");
+    FakeDataSource::readEventTimeOffset(event_time_offset, start, count);
+  }
+};
+
+void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize,
+                  const size_t queueDepth) {
   const std::vector<size_t> bankSizes{111, 1111, 11111};
   Chunker chunker(comm.size(), comm.rank(), bankSizes, chunkSize);
   // FakeDataSource encodes information on bank and position in file into TOF
@@ -107,7 +119,7 @@ void do_test_load(const Parallel::Communicator &comm, const size_t chunkSize) {
   EventParser<int32_t> dataSink(comm, chunker.makeWorkerGroups(), bankOffsets,
                                 eventListPtrs);
   TS_ASSERT_THROWS_NOTHING(
-      (EventLoader::load<int32_t>(chunker, dataSource, dataSink)));
+      (EventLoader::load<int32_t>(chunker, dataSource, dataSink, queueDepth)));
 
   for (size_t localSpectrumIndex = 0; localSpectrumIndex < eventLists.size();
        ++localSpectrumIndex) {
@@ -196,8 +208,32 @@ public:
     for (const size_t chunkSize : {37, 123, 1111}) {
       for (const auto threads : {1, 2, 3, 5, 7, 13}) {
         ParallelTestHelpers::ParallelRunner runner(threads);
-        runner.run(do_test_load, chunkSize);
+        runner.run(do_test_load, chunkSize, EventLoader::defaultQueueDepth);
+      }
+    }
+  }
+
+  void test_load_queue_depth() {
+    for (const size_t queueDepth : {1, 2, 7}) {
+      for (const auto threads : {1, 3}) {
+        ParallelTestHelpers::ParallelRunner runner(threads);
+        runner.run(do_test_load, 37, queueDepth);
       }
     }
   }
+
+  void test_load_rethrows_read_error() {
+    Communicator comm;
+    Chunker chunker(comm.size(), comm.rank(), {1111}, 37);
+    FailingDataSource dataSource(comm.size());
+    std::vector<std::vector<Types::Event::TofEvent>> eventLists(77);
+    std::vector<std::vector<Types::Event::TofEvent> *> eventListPtrs;
+    for (auto &eventList : eventLists)
+      eventListPtrs.emplace_back(&eventList);
+    EventParser<int32_t> dataSink(comm, chunker.makeWorkerGroups(), {0},
+                                  eventListPtrs);
+    TS_ASSERT_THROWS_EQUALS(
+        (EventLoader::load<int32_t>(chunker, dataSource, dataSink, 2)),
+        const std::runtime_error &e, std::string(e.what()), "read failed");
+  }
 };
@@ -0,0 +1,81 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDHistoExpression.h"
+#include "MantidKernel/WarningSuppressions.h"
+
+#include <boost/python/class.hpp>
+#include <boost/python/make_constructor.hpp>
+#include <boost/python/operators.hpp>
+
+using Mantid::API::IMDHistoWorkspace_sptr;
+using Mantid::DataObjects::MDHistoExpression;
+using Mantid::DataObjects::MDHistoWorkspace;
+using namespace boost::python;
+
+namespace {
+/**
+ * Create an expression from a workspace
+ * @param workspace :: an MDHistoWorkspace
+ * @return a new expression
+ */
+MDHistoExpression *
+createFromWorkspace(const IMDHistoWorkspace_sptr &workspace) {
+  auto histo = std::dynamic_pointer_cast<const MDHistoWorkspace>(workspace);
+  if (!histo)
+    throw std::invalid_argument("MDHistoExpression: the workspace is not an "
+                                "MDHistoWorkspace.");
+  return new MDHistoExpression(histo);
+}
+} // namespace
+
+void export_MDHistoExpression() {
+  GNU_DIAG_OFF("self-assign-overloaded")
+  class_<MDHistoExpression>(
+      "MDHistoExpression",
+      "Records arithmetic on MDHistoWorkspaces and numbers, as done by "
+      "PlusMD, MinusMD, MultiplyMD, DivideMD, LogarithmMD, ExponentialMD and "
+      "PowerMD, and evaluates it in a single pass over the bins.",
+      no_init)
+      .def("__init__", make_constructor(&createFromWorkspace,
+                                        default_call_policies(),
+                                        (arg("workspace"))))
+      .def(init<double, optional<double>>(
+          (arg("self"), arg("signal"), arg("error")),
+          "Creates an expression from a number and its error"))
+      .def("log", &MDHistoExpression::log, (arg("self"), arg("filler") = 0.0),
+           "Natural logarithm of the signal. Bins with a signal <= 0 are set "
+           "to filler.")
+      .def("log10", &MDHistoExpression::log10,
+           (arg("self"), arg("filler") = 0.0),
+           "Base-10 logarithm of the signal. Bins with a signal <= 0 are set "
+           "to filler.")
+      .def("exp", &MDHistoExpression::exp, arg("self"),
+           "Exponential of the signal")
+      .def("power", &MDHistoExpression::power, (arg("self"), arg("exponent")),
+           "Signal to the power of exponent")
+      .def("__pow__", &MDHistoExpression::power,
+           (arg("self"), arg("exponent")))
+      .def("evaluate", &MDHistoExpression::evaluate, arg("self"),
+           "Computes the expression and returns the resulting MDHistoWorkspace, "
+           "a copy of the first workspace of the expression with the new "
+           "signals and errors.")
+      .def(self + self)
+      .def(self + other<double>())
+      .def(other<double>() + self)
+      // cppcheck-suppress duplicateExpression
+      .def(self - self)
+      .def(self - other<double>())
+      .def(other<double>() - self)
+      .def(self * self)
+      .def(self * other<double>())
+      .def(other<double>() * self)
+      // cppcheck-suppress duplicateExpression
+      .def(self / self)
+      .def(self / other<double>())
+      .def(other<double>() / self);
+  GNU_DIAG_ON("self-assign-overloaded")
+}
@@ -0,0 +1,51 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2020 ISIS Rutherford Appleton Laboratory UKRI,
+#   NScD Oak Ridge National Laboratory, European Spallation Source,
+#   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+# SPDX - License - Identifier: GPL - 3.0 +
+import unittest
+import numpy as np
+
+from mantid.dataobjects import MDHistoExpression
+from mantid.simpleapi import (CreateMDHistoWorkspace, DeleteWorkspace, DivideMD, LogarithmMD, MinusMD,
+                              MultiplyMD, PlusMD)
+
+
+class MDHistoExpressionTest(unittest.TestCase):
+
+    def setUp(self):
+        signal = np.linspace(1., 5., 100)
+        self.a = CreateMDHistoWorkspace(Dimensionality=2, Extents='0,10,0,10', SignalInput=signal,
+                                        ErrorInput=np.sqrt(signal), NumberOfBins='10,10', Names='x,y',
+                                        Units='u,u', OutputWorkspace='a')
+        self.b = CreateMDHistoWorkspace(Dimensionality=2, Extents='0,10,0,10', SignalInput=signal[::-1],
+                                        ErrorInput=np.ones(100), NumberOfBins='10,10', Names='x,y',
+                                        Units='u,u', OutputWorkspace='b')
+
+    def tearDown(self):
+        DeleteWorkspace(self.a)
+        DeleteWorkspace(self.b)
+
+    def test_evaluate_matches_the_algorithms(self):
+        expected = LogarithmMD(DivideMD(MinusMD(MultiplyMD(PlusMD(self.a, self.b), self.a), self.b), self.b))
+        a = MDHistoExpression(self.a)
+        b = MDHistoExpression(self.b)
+        out = (((a + b) * a - b) / b).log().evaluate()
+        np.testing.assert_allclose(out.getSignalArray(), expected.getSignalArray())
+        np.testing.assert_allclose(out.getErrorSquaredArray(), expected.getErrorSquaredArray())
+        DeleteWorkspace(expected)
+
+    def test_numbers_and_power(self):
+        a = MDHistoExpression(self.a)
+        out = (2. * a ** 2 - 1.).evaluate()
+        signal = self.a.getSignalArray()
+        np.testing.assert_allclose(out.getSignalArray(), 2. * signal ** 2 - 1.)
+
+    def test_expression_without_workspace_raises(self):
+        out = MDHistoExpression(1.) + MDHistoExpression(2., 0.5)
+        self.assertRaises(RuntimeError, out.evaluate)
+
+
+if __name__ == '__main__':
+    unittest.main()